@@ -6,7 +6,6 @@
 #include <QMessageBox>
 #include <QFile>
 #include <QTextStream>
-#include <QStandardItemModel>
 #include <QHeaderView>
 #include <QStyledItemDelegate>
 #include <QPainter>
@@ -50,6 +49,11 @@
 #include <QDial>
 #include <QTextEdit>
 #include <QPlainTextEdit>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include "csvparser.h"
+#include "datasetcache.h"
+#include "modelparameter.h"
 #include <cmath>
 #include <algorithm>
 
@@ -69,12 +73,12 @@
 // 撤销重做命令实现
 // ============================================================================
 
-DataEditCommand::DataEditCommand(QStandardItemModel* model, QUndoCommand* parent)
+DataEditCommand::DataEditCommand(DataTableModel* model, QUndoCommand* parent)
     : QUndoCommand(parent), m_model(model)
 {
 }
 
-CellEditCommand::CellEditCommand(QStandardItemModel* model, int row, int column,
+CellEditCommand::CellEditCommand(DataTableModel* model, int row, int column,
                                  const QString& oldValue, const QString& newValue,
                                  QUndoCommand* parent)
     : DataEditCommand(model, parent), m_row(row), m_column(column),
@@ -86,12 +90,7 @@ CellEditCommand::CellEditCommand(QStandardItemModel* model, int row, int column,
 void CellEditCommand::undo()
 {
     if (m_model && m_row < m_model->rowCount() && m_column < m_model->columnCount()) {
-        QStandardItem* item = m_model->item(m_row, m_column);
-        if (!item) {
-            item = new QStandardItem();
-            m_model->setItem(m_row, m_column, item);
-        }
-        item->setText(m_oldValue);
+        m_model->setText(m_row, m_column, m_oldValue);
     }
 }
 
@@ -99,30 +98,20 @@ void DataEditorWidget::loadDataWithConfig(const QString& filePath, const QString
 {
     qDebug() << "开始加载文件:" << filePath << "类型:" << fileType << "起始行:" << config.startRow;
 
-    QFileInfo fileInfo(filePath);
-    if (!fileInfo.exists() || !fileInfo.isReadable()) {
-        showStyledMessageBox("文件加载失败",
-                             QString("文件不存在或无法读取: %1").arg(filePath),
-                             QMessageBox::Warning);
+    if (!beginLoading(filePath, fileType)) {
         return;
     }
 
-    // 显示进度对话框
-    showAnimatedProgress("加载数据文件", "正在读取文件数据，请稍候...");
-
-    clearData();
-
-    m_currentFilePath = filePath;
-    m_currentFileType = fileType;
-    ui->filePathLineEdit->setText(filePath);
-
     bool loadSuccess = false;
     QString errorMessage;
 
-    updateProgress(20, "正在分析文件格式...");
-
     QString lowerType = fileType.toLower();
-    if (lowerType == "txt" || lowerType == "csv") {
+    m_loadKey = QStringList{lowerType, QString::number(config.startRow), config.hasHeader ? "1" : "0",
+                            config.encoding, config.separator}.join("|");
+    bool fromCache = loadDataCache(filePath, m_loadKey);
+    if (fromCache) {
+        loadSuccess = true;
+    } else if (lowerType == "txt" || lowerType == "csv") {
         loadSuccess = loadCsvFileWithConfig(filePath, config, errorMessage);
     } else {
         // 其他类型使用默认方法
@@ -135,6 +124,47 @@ void DataEditorWidget::loadDataWithConfig(const QString& filePath, const QString
         }
     }
 
+    // 文本文件的数据行在后台解析, 由 loadTextRows 的完成回调收尾
+    if (loadSuccess && m_textLoad) {
+        return;
+    }
+    finishLoading(loadSuccess, fromCache, errorMessage);
+}
+
+bool DataEditorWidget::beginLoading(const QString& filePath, const QString& fileType)
+{
+    // 上一个文件仍在后台解析时不接受新的加载, 避免模型与映射文件在解析中途被替换
+    if (m_loading) {
+        updateStatus("正在加载数据，请稍候", "info");
+        return false;
+    }
+
+    QFileInfo fileInfo(filePath);
+    if (!fileInfo.exists() || !fileInfo.isReadable()) {
+        showStyledMessageBox("文件加载失败",
+                             QString("文件不存在或无法读取: %1").arg(filePath),
+                             QMessageBox::Warning);
+        emit loadingFinished(false);
+        return false;
+    }
+
+    setLoading(true);
+    // 显示进度对话框
+    showAnimatedProgress("加载数据文件", "正在读取文件数据，请稍候...");
+
+    clearData();
+
+    m_currentFilePath = filePath;
+    m_currentFileType = fileType;
+    ui->filePathLineEdit->setText(filePath);
+
+    updateProgress(20, "正在分析文件格式...");
+    return true;
+}
+
+void DataEditorWidget::finishLoading(bool loadSuccess, bool fromCache, const QString& errorMessage)
+{
+    setLoading(false);
     hideAnimatedProgress();
 
     if (loadSuccess) {
@@ -145,12 +175,23 @@ void DataEditorWidget::loadDataWithConfig(const QString& filePath, const QString
         setButtonsEnabled(true);
         m_dataModified = false;
 
+        // 解析结果写入项目目录的数据缓存, 下次打开同一文件时直接读取
+        if (!fromCache) {
+            saveDataCache();
+        }
+
         applyColumnStyles();
         optimizeColumnWidths();
         optimizeTableDisplay();
 
-        // 弹出列定义对话框
-        QTimer::singleShot(500, this, &DataEditorWidget::onDefineColumns);
+        if (m_columnDefinitions.isEmpty()) {
+            // 弹出列定义对话框
+            QTimer::singleShot(500, this, &DataEditorWidget::onDefineColumns);
+        } else {
+            // 沿用缓存中保存的列定义
+            updateColumnHeaders();
+            emit columnDefinitionsChanged();
+        }
 
         emitDataChanged();
 
@@ -159,26 +200,34 @@ void DataEditorWidget::loadDataWithConfig(const QString& filePath, const QString
     } else {
         updateStatus("文件加载失败", "error");
         showStyledMessageBox("文件加载失败",
-                             QString("无法加载文件: %1").arg(filePath),
+                             QString("无法加载文件: %1").arg(m_currentFilePath),
                              QMessageBox::Critical,
                              errorMessage);
         qDebug() << "文件加载失败:" << errorMessage;
     }
+    emit loadingFinished(loadSuccess);
+}
+
+void DataEditorWidget::setLoading(bool loading)
+{
+    m_loading = loading;
+    // 加载期间禁用打开文件、表格编辑与各数据操作; 结束后由 finishLoading 按结果恢复
+    ui->btnOpenFile->setEnabled(!loading);
+    ui->dataTableView->setEnabled(!loading);
+    ui->searchLineEdit->setEnabled(!loading);
+    if (loading) {
+        setButtonsEnabled(false);
+    }
 }
 
 void CellEditCommand::redo()
 {
     if (m_model && m_row < m_model->rowCount() && m_column < m_model->columnCount()) {
-        QStandardItem* item = m_model->item(m_row, m_column);
-        if (!item) {
-            item = new QStandardItem();
-            m_model->setItem(m_row, m_column, item);
-        }
-        item->setText(m_newValue);
+        m_model->setText(m_row, m_column, m_newValue);
     }
 }
 
-RowEditCommand::RowEditCommand(QStandardItemModel* model, Operation op, int row,
+RowEditCommand::RowEditCommand(DataTableModel* model, Operation op, int row,
                                const QStringList& rowData, QUndoCommand* parent)
     : DataEditCommand(model, parent), m_operation(op), m_row(row), m_rowData(rowData)
 {
@@ -197,8 +246,7 @@ void RowEditCommand::undo()
     } else {
         m_model->insertRow(m_row);
         for (int col = 0; col < m_rowData.size(); ++col) {
-            QStandardItem* item = new QStandardItem(m_rowData[col]);
-            m_model->setItem(m_row, col, item);
+            m_model->setText(m_row, col, m_rowData[col]);
         }
     }
 }
@@ -209,24 +257,19 @@ void RowEditCommand::redo()
 
     if (m_operation == Insert) {
         m_model->insertRow(m_row);
-        for (int col = 0; col < m_model->columnCount(); ++col) {
-            QStandardItem* item = new QStandardItem("");
-            m_model->setItem(m_row, col, item);
-        }
     } else {
         if (m_row < m_model->rowCount()) {
             m_rowData.clear();
             for (int col = 0; col < m_model->columnCount(); ++col) {
-                QStandardItem* item = m_model->item(m_row, col);
-                m_rowData.append(item ? item->text() : "");
+                m_rowData.append(m_model->text(m_row, col));
             }
             m_model->removeRow(m_row);
         }
     }
 }
 
-ColumnEditCommand::ColumnEditCommand(QStandardItemModel* model, Operation op, int column,
-                                     const QString& headerName, const QStringList& columnData,
+ColumnEditCommand::ColumnEditCommand(DataTableModel* model, Operation op, int column,
+                                     const QString& headerName, const DataColumn& columnData,
                                      QUndoCommand* parent)
     : DataEditCommand(model, parent), m_operation(op), m_column(column),
     m_headerName(headerName), m_columnData(columnData)
@@ -245,13 +288,8 @@ void ColumnEditCommand::undo()
         }
     } else {
         m_model->insertColumn(m_column);
-        QStandardItem* headerItem = new QStandardItem(m_headerName);
-        m_model->setHorizontalHeaderItem(m_column, headerItem);
-
-        for (int row = 0; row < m_columnData.size(); ++row) {
-            QStandardItem* item = new QStandardItem(m_columnData[row]);
-            m_model->setItem(row, m_column, item);
-        }
+        m_model->setHeaderText(m_column, m_headerName);
+        m_model->setColumn(m_column, m_columnData);
     }
 }
 
@@ -261,23 +299,14 @@ void ColumnEditCommand::redo()
 
     if (m_operation == Insert) {
         m_model->insertColumn(m_column);
-        QStandardItem* headerItem = new QStandardItem(m_headerName);
-        m_model->setHorizontalHeaderItem(m_column, headerItem);
-
-        for (int row = 0; row < m_model->rowCount(); ++row) {
-            QStandardItem* item = new QStandardItem("");
-            m_model->setItem(row, m_column, item);
-        }
+        m_model->setHeaderText(m_column, m_headerName);
     } else {
         if (m_column < m_model->columnCount()) {
-            QStandardItem* headerItem = m_model->horizontalHeaderItem(m_column);
-            m_headerName = headerItem ? headerItem->text() : QString("列%1").arg(m_column + 1);
-
-            m_columnData.clear();
-            for (int row = 0; row < m_model->rowCount(); ++row) {
-                QStandardItem* item = m_model->item(row, m_column);
-                m_columnData.append(item ? item->text() : "");
-            }
+            m_headerName = m_model->headerText(m_column);
+            if (m_headerName.isNull()) m_headerName = QString("列%1").arg(m_column + 1);
+            // 大文件模式下的映射列先转入内存, 撤销时才能恢复文本
+            m_model->materializeColumn(m_column);
+            m_columnData = m_model->column(m_column);
 
             m_model->removeColumn(m_column);
         }
@@ -1176,8 +1205,10 @@ DataLoadConfigDialog::DataLoadConfigDialog(const QString& filePath, QWidget* par
     // 设置默认配置
     m_config.startRow = 1;
     m_config.hasHeader = true;
-    m_config.encoding = detectEncoding(filePath);
-    m_config.separator = detectSeparator(filePath);
+    // 编码与分隔符由同一段文件头采样检测
+    CsvParser::Sniff sniff = CsvParser::sniff(CsvParser::readSample(filePath), {",", "\t", ";", "|", " "});
+    m_config.encoding = sniff.encoding;
+    m_config.separator = sniff.separator;
 
     // 设置UI初始值
     m_startRowSpin->setValue(m_config.startRow);
@@ -1358,78 +1389,6 @@ void DataLoadConfigDialog::loadFilePreview()
     m_previewText->setText(previewText);
 }
 
-QString DataLoadConfigDialog::detectEncoding(const QString& filePath)
-{
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        return "UTF-8";
-    }
-
-    QByteArray data = file.read(1024); // 读取前1KB进行检测
-    file.close();
-
-    // 简单的编码检测
-    if (data.contains('\0')) {
-        return "UTF-8"; // 可能包含二进制数据
-    }
-
-    // 检测是否包含中文
-    QString testUtf8 = QString::fromUtf8(data);
-    QString testGbk;
-
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-    QTextCodec* gbkCodec = QTextCodec::codecForName("GBK");
-    if (gbkCodec) {
-        testGbk = gbkCodec->toUnicode(data);
-    }
-#endif
-
-    // 如果包含明显的中文字符，尝试GBK
-    if (data.size() > testUtf8.toUtf8().size()) {
-        return "GBK";
-    }
-
-    return "UTF-8";
-}
-
-QString DataLoadConfigDialog::detectSeparator(const QString& filePath)
-{
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return ",";
-    }
-
-    // 读取前几行检测分隔符
-    QTextStream in(&file);
-    QString sampleText;
-    int lineCount = 0;
-    while (!in.atEnd() && lineCount < 5) {
-        sampleText += in.readLine() + "\n";
-        lineCount++;
-    }
-    file.close();
-
-    // 统计各种分隔符的出现频率
-    QMap<QString, int> separatorCounts;
-    separatorCounts[","] = sampleText.count(',');
-    separatorCounts["\t"] = sampleText.count('\t');
-    separatorCounts[";"] = sampleText.count(';');
-    separatorCounts["|"] = sampleText.count('|');
-    separatorCounts[" "] = sampleText.count(' ');
-
-    // 找到出现频率最高的分隔符
-    QString bestSeparator = ",";
-    int maxCount = 0;
-    for (auto it = separatorCounts.begin(); it != separatorCounts.end(); ++it) {
-        if (it.value() > maxCount) {
-            maxCount = it.value();
-            bestSeparator = it.key();
-        }
-    }
-
-    return bestSeparator;
-}
-
 DataLoadConfigDialog::LoadConfig DataLoadConfigDialog::getLoadConfig() const
 {
     LoadConfig config;
@@ -1598,6 +1557,7 @@ DataEditorWidget::DataEditorWidget(QWidget *parent) :
     QWidget(parent),
     ui(new Ui::DataEditorWidget),
     m_dataModel(nullptr),
+    m_statisticsCache(nullptr),
     m_proxyModel(nullptr),
     m_undoStack(nullptr),
     m_dataModified(false),
@@ -1605,6 +1565,8 @@ DataEditorWidget::DataEditorWidget(QWidget *parent) :
     m_progressDialog(nullptr),
     m_largeFileMode(false),
     m_maxDisplayRows(10000),
+    m_loading(false),
+    m_textLoad(nullptr),
     m_contextMenu(nullptr),
     m_addRowAboveAction(nullptr),
     m_addRowBelowAction(nullptr),
@@ -1664,7 +1626,8 @@ void DataEditorWidget::init()
 void DataEditorWidget::setupModels()
 {
     // 创建数据模型
-    m_dataModel = new QStandardItemModel(this);
+    m_dataModel = new DataTableModel(this);
+    m_statisticsCache = new ColumnStatisticsCache(m_dataModel, this);
 
     // 创建代理模型用于搜索和筛选
     m_proxyModel = new QSortFilterProxyModel(this);
@@ -1738,8 +1701,7 @@ void DataEditorWidget::setupConnections()
     connect(ui->searchLineEdit, &QLineEdit::textChanged, this, &DataEditorWidget::onSearchTextChanged);
 
     // 模型数据变化
-    connect(m_dataModel, &QStandardItemModel::itemChanged, this, &DataEditorWidget::onCellDataChanged);
-    connect(m_dataModel, &QStandardItemModel::dataChanged, this, &DataEditorWidget::onModelDataChanged);
+    connect(m_dataModel, &DataTableModel::dataChanged, this, &DataEditorWidget::onModelDataChanged);
 
     // 右键菜单连接
     connect(ui->dataTableView, &QTableView::customContextMenuRequested,
@@ -1916,8 +1878,7 @@ TimeConversionResult DataEditorWidget::convertTimeColumn(const TimeConversionCon
             m_dataModel->insertColumn(newColumnIndex);
 
             // 设置列标题
-            QStandardItem* headerItem = new QStandardItem(newColumnName);
-            m_dataModel->setHorizontalHeaderItem(newColumnIndex, headerItem);
+            m_dataModel->setHeaderText(newColumnIndex, newColumnName);
 
             // 获取基准日期和时刻（第一行的数据）
             QDate baseDate;
@@ -1926,12 +1887,9 @@ TimeConversionResult DataEditorWidget::convertTimeColumn(const TimeConversionCon
 
             // 找到第一个有效的日期和时刻
             for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-                QStandardItem* dateItem = m_dataModel->item(row, config.dateColumnIndex);
-                QStandardItem* timeItem = m_dataModel->item(row, config.timeColumnIndex);
-
-                if (dateItem && timeItem) {
-                    QString dateStr = dateItem->text().trimmed();
-                    QString timeStr = timeItem->text().trimmed();
+                if (!m_dataModel->isEmpty(row, config.dateColumnIndex) && !m_dataModel->isEmpty(row, config.timeColumnIndex)) {
+                    QString dateStr = m_dataModel->text(row, config.dateColumnIndex).trimmed();
+                    QString timeStr = m_dataModel->text(row, config.timeColumnIndex).trimmed();
 
                     QDate parsedDate = parseDateString(dateStr);
                     QTime parsedTime = parseTimeString(timeStr);
@@ -1953,48 +1911,29 @@ TimeConversionResult DataEditorWidget::convertTimeColumn(const TimeConversionCon
                 return result;
             }
 
-            // 计算每行的相对时间
+            // 计算每行的相对时间 (无效数据留空), 整列一次写入
+            DataColumn converted(m_dataModel->rowCount());
+            QDateTime baseDateTime = combineDateAndTime(baseDate, baseTime);
             for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-                QString convertedValue;
-
-                QStandardItem* dateItem = m_dataModel->item(row, config.dateColumnIndex);
-                QStandardItem* timeItem = m_dataModel->item(row, config.timeColumnIndex);
-
-                if (dateItem && timeItem) {
-                    QString dateStr = dateItem->text().trimmed();
-                    QString timeStr = timeItem->text().trimmed();
+                QString dateStr = m_dataModel->text(row, config.dateColumnIndex).trimmed();
+                QString timeStr = m_dataModel->text(row, config.timeColumnIndex).trimmed();
 
-                    QDate currentDate = parseDateString(dateStr);
-                    QTime currentTime = parseTimeString(timeStr);
+                QDate currentDate = parseDateString(dateStr);
+                QTime currentTime = parseTimeString(timeStr);
 
-                    if (currentDate.isValid() && currentTime.isValid()) {
-                        if (row == 0) {
-                            // 第一行时间为0
-                            convertedValue = "0.000";
-                        } else {
-                            // 计算时间差：(当前日期-基准日期)*24 + (当前时刻-基准时刻)
-                            QDateTime baseDateTime = combineDateAndTime(baseDate, baseTime);
-                            QDateTime currentDateTime = combineDateAndTime(currentDate, currentTime);
-
-                            double timeDiff = calculateDateTimeDifference(baseDateTime, currentDateTime, config.outputUnit);
-                            convertedValue = QString::number(timeDiff, 'f', 3);
-                        }
-                        result.processedRows++;
+                if (currentDate.isValid() && currentTime.isValid()) {
+                    if (row == 0) {
+                        // 第一行时间为0
+                        converted.setValue(row, 0.0);
                     } else {
-                        // 无效数据设为空
-                        convertedValue = "";
+                        // 计算时间差：(当前日期-基准日期)*24 + (当前时刻-基准时刻)
+                        QDateTime currentDateTime = combineDateAndTime(currentDate, currentTime);
+                        converted.setValue(row, calculateDateTimeDifference(baseDateTime, currentDateTime, config.outputUnit));
                     }
-                } else {
-                    convertedValue = "";
-                }
-
-                // 创建新的数据项
-                QStandardItem* newItem = new QStandardItem(convertedValue);
-                if (newItem) {
-                    newItem->setForeground(QBrush(QColor("#2c3e50")));
-                    m_dataModel->setItem(row, newColumnIndex, newItem);
+                    result.processedRows++;
                 }
             }
+            m_dataModel->setColumn(newColumnIndex, converted);
 
         } else {
             // 仅时间模式（原有逻辑）
@@ -2008,8 +1947,7 @@ TimeConversionResult DataEditorWidget::convertTimeColumn(const TimeConversionCon
             m_dataModel->insertColumn(newColumnIndex);
 
             // 设置列标题
-            QStandardItem* headerItem = new QStandardItem(newColumnName);
-            m_dataModel->setHorizontalHeaderItem(newColumnIndex, headerItem);
+            m_dataModel->setHeaderText(newColumnIndex, newColumnName);
 
             // 获取源列的所有时间数据
             QList<QTime> timeValues;
@@ -2018,21 +1956,16 @@ TimeConversionResult DataEditorWidget::convertTimeColumn(const TimeConversionCon
 
             // 首先解析所有时间数据
             for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-                QStandardItem* sourceItem = m_dataModel->item(row, config.sourceTimeColumnIndex);
-                if (sourceItem) {
-                    QString timeStr = sourceItem->text().trimmed();
-                    QTime parsedTime = parseTimeString(timeStr);
+                QString timeStr = m_dataModel->text(row, config.sourceTimeColumnIndex).trimmed();
+                QTime parsedTime = parseTimeString(timeStr);
 
-                    if (parsedTime.isValid()) {
-                        timeValues.append(parsedTime);
+                if (parsedTime.isValid()) {
+                    timeValues.append(parsedTime);
 
-                        // 设置基准时间（第一个有效时间）
-                        if (!baseTimeSet) {
-                            baseTime = parsedTime;
-                            baseTimeSet = true;
-                        }
-                    } else {
-                        timeValues.append(QTime()); // 添加无效时间占位
+                    // 设置基准时间（第一个有效时间）
+                    if (!baseTimeSet) {
+                        baseTime = parsedTime;
+                        baseTimeSet = true;
                     }
                 } else {
                     timeValues.append(QTime()); // 添加无效时间占位
@@ -2048,34 +1981,27 @@ TimeConversionResult DataEditorWidget::convertTimeColumn(const TimeConversionCon
                 return result;
             }
 
-            // 计算相对时间并填充新列
+            // 计算相对时间并填充新列 (无效时间留空)
+            DataColumn converted(m_dataModel->rowCount());
             for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-                QString convertedValue;
-
                 if (row < timeValues.size() && timeValues[row].isValid()) {
                     if (row == 0) {
                         // 第一行时间为0
-                        convertedValue = "0.000";
+                        converted.setValue(row, 0.0);
                     } else {
                         // 计算与基准时间的差值
-                        double timeDiff = calculateTimeDifference(baseTime, timeValues[row], config.outputUnit);
-                        convertedValue = QString::number(timeDiff, 'f', 3);
+                        converted.setValue(row, calculateTimeDifference(baseTime, timeValues[row], config.outputUnit));
                     }
                     result.processedRows++;
-                } else {
-                    // 无效时间设为空
-                    convertedValue = "";
-                }
-
-                // 创建新的数据项
-                QStandardItem* newItem = new QStandardItem(convertedValue);
-                if (newItem) {
-                    newItem->setForeground(QBrush(QColor("#2c3e50")));
-                    m_dataModel->setItem(row, newColumnIndex, newItem);
                 }
             }
+            m_dataModel->setColumn(newColumnIndex, converted);
         }
 
+        // 与原先逐格 'f', 3 格式化的显示一致
+        m_dataModel->setColumnPrecision(newColumnIndex, 3);
+        m_dataModel->setColumnForeground(newColumnIndex, QColor("#2c3e50"));
+
         // 安全地添加列定义
         try {
             ColumnDefinition newColumnDef;
@@ -2387,37 +2313,22 @@ PressureDropResult DataEditorWidget::calculatePressureDrop()
     m_dataModel->insertColumn(newColumnIndex);
 
     // 设置列标题
-    QStandardItem* headerItem = new QStandardItem(dropColumnName);
-    m_dataModel->setHorizontalHeaderItem(newColumnIndex, headerItem);
+    m_dataModel->setHeaderText(newColumnIndex, dropColumnName);
 
     // 计算压降数据
     int rowCount = m_dataModel->rowCount();
-    QList<double> pressureValues;
 
-    // 收集所有压力数据
-    for (int row = 0; row < rowCount; ++row) {
-        QStandardItem* pressureItem = m_dataModel->item(row, pressureColumn);
-        if (pressureItem) {
-            QString pressureText = pressureItem->text().trimmed();
-            if (isValidPressureData(pressureText)) {
-                bool ok;
-                double pressure = pressureText.toDouble(&ok);
-                if (ok) {
-                    pressureValues.append(pressure);
-                } else {
-                    pressureValues.append(0.0);
-                }
-            } else {
-                pressureValues.append(0.0);
-            }
-        } else {
-            pressureValues.append(0.0);
-        }
-    }
+    // 压力列直接按数值读取, 空白或非数值单元格按 0 处理
+    const QVector<double> pressureColumnValues = m_dataModel->columnValues(pressureColumn);
+    auto pressureAt = [&](int row) {
+        double p = pressureColumnValues[row];
+        return std::isnan(p) ? 0.0 : p;
+    };
 
     // 计算压降值 - 修正的计算逻辑：每个时刻相对于初始时刻的压降
-    double initialPressure = pressureValues.isEmpty() ? 0.0 : pressureValues[0]; // 获取初始压力
+    double initialPressure = rowCount == 0 ? 0.0 : pressureAt(0); // 获取初始压力
 
+    DataColumn dropColumn(rowCount);
     for (int row = 0; row < rowCount; ++row) {
         double pressureDrop = 0.0;
 
@@ -2426,17 +2337,15 @@ PressureDropResult DataEditorWidget::calculatePressureDrop()
             pressureDrop = 0.0;
         } else {
             // 其他行的压降 = 初始时刻压力 - 当前时刻压力
-            pressureDrop = initialPressure - pressureValues[row];
+            pressureDrop = initialPressure - pressureAt(row);
         }
 
-        // 创建新的数据项
-        QString dropValueText = QString::number(pressureDrop, 'f', 3);
-        QStandardItem* dropItem = new QStandardItem(dropValueText);
-        dropItem->setForeground(QBrush(QColor("#2c3e50")));
-        m_dataModel->setItem(row, newColumnIndex, dropItem);
-
+        dropColumn.setValue(row, pressureDrop);
         result.processedRows++;
     }
+    m_dataModel->setColumn(newColumnIndex, dropColumn);
+    m_dataModel->setColumnPrecision(newColumnIndex, 3);
+    m_dataModel->setColumnForeground(newColumnIndex, QColor("#2c3e50"));
 
     // 添加列定义
     ColumnDefinition newColumnDef;
@@ -2634,8 +2543,7 @@ void DataEditorWidget::onDeleteSelectedRows()
         for (int row : selectedRows) {
             QStringList rowData;
             for (int col = 0; col < m_dataModel->columnCount(); ++col) {
-                QStandardItem* item = m_dataModel->item(row, col);
-                rowData.append(item ? item->text() : "");
+                rowData.append(m_dataModel->text(row, col));
             }
 
             RowEditCommand* command = new RowEditCommand(m_dataModel, RowEditCommand::Delete, row, rowData);
@@ -2732,16 +2640,10 @@ void DataEditorWidget::onDeleteSelectedColumns()
         m_undoStack->beginMacro("删除多列");
 
         for (int col : selectedColumns) {
-            QStandardItem* headerItem = m_dataModel->horizontalHeaderItem(col);
-            QString headerName = headerItem ? headerItem->text() : QString("列%1").arg(col + 1);
-
-            QStringList columnData;
-            for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-                QStandardItem* item = m_dataModel->item(row, col);
-                columnData.append(item ? item->text() : "");
-            }
+            QString headerName = m_dataModel->headerText(col);
+            if (headerName.isNull()) headerName = QString("列%1").arg(col + 1);
 
-            ColumnEditCommand* command = new ColumnEditCommand(m_dataModel, ColumnEditCommand::Delete, col, headerName, columnData);
+            ColumnEditCommand* command = new ColumnEditCommand(m_dataModel, ColumnEditCommand::Delete, col, headerName, m_dataModel->column(col));
             m_undoStack->push(command);
         }
 
@@ -2828,30 +2730,19 @@ void DataEditorWidget::loadData(const QString& filePath, const QString& fileType
 {
     qDebug() << "开始加载文件:" << filePath << "类型:" << fileType;
 
-    QFileInfo fileInfo(filePath);
-    if (!fileInfo.exists() || !fileInfo.isReadable()) {
-        showStyledMessageBox("文件加载失败",
-                             QString("文件不存在或无法读取: %1").arg(filePath),
-                             QMessageBox::Warning);
+    if (!beginLoading(filePath, fileType)) {
         return;
     }
 
-    // 显示进度对话框
-    showAnimatedProgress("加载数据文件", "正在读取文件数据，请稍候...");
-
-    clearData();
-
-    m_currentFilePath = filePath;
-    m_currentFileType = fileType;
-    ui->filePathLineEdit->setText(filePath);
-
     bool loadSuccess = false;
     QString errorMessage;
 
-    updateProgress(20, "正在分析文件格式...");
-
     QString lowerType = fileType.toLower();
-    if (lowerType == "excel") {
+    m_loadKey = lowerType;
+    bool fromCache = loadDataCache(filePath, m_loadKey);
+    if (fromCache) {
+        loadSuccess = true;
+    } else if (lowerType == "excel") {
         loadSuccess = loadExcelFileOptimized(filePath, errorMessage);
     } else if (lowerType == "txt" || lowerType == "csv") {
         loadSuccess = loadCsvFile(filePath, errorMessage);
@@ -2861,35 +2752,11 @@ void DataEditorWidget::loadData(const QString& filePath, const QString& fileType
         errorMessage = QString("不支持的文件类型: %1").arg(fileType);
     }
 
-    hideAnimatedProgress();
-
-    if (loadSuccess) {
-        updateStatus(QString("文件加载成功 - %1行 × %2列")
-                         .arg(m_dataModel->rowCount())
-                         .arg(m_dataModel->columnCount()), "success");
-
-        setButtonsEnabled(true);
-        m_dataModified = false;
-
-        applyColumnStyles();
-        optimizeColumnWidths();
-        optimizeTableDisplay();
-
-        // 弹出列定义对话框
-        QTimer::singleShot(500, this, &DataEditorWidget::onDefineColumns);
-
-        emitDataChanged();
-
-        qDebug() << "文件加载成功，数据行数:" << m_dataModel->rowCount()
-                 << "列数:" << m_dataModel->columnCount();
-    } else {
-        updateStatus("文件加载失败", "error");
-        showStyledMessageBox("文件加载失败",
-                             QString("无法加载文件: %1").arg(filePath),
-                             QMessageBox::Critical,
-                             errorMessage);
-        qDebug() << "文件加载失败:" << errorMessage;
+    // 文本文件的数据行在后台解析, 由 loadTextRows 的完成回调收尾
+    if (loadSuccess && m_textLoad) {
+        return;
     }
+    finishLoading(loadSuccess, fromCache, errorMessage);
 }
 
 // ============================================================================
@@ -3047,37 +2914,18 @@ bool DataEditorWidget::quickDetectFileFormat(const QString& filePath)
 
 bool DataEditorWidget::loadCsvFileWithConfig(const QString& filePath, const DataLoadConfigDialog::LoadConfig& config, QString& errorMessage)
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        errorMessage = QString("无法打开文件: %1").arg(file.errorString());
+    QSharedPointer<MappedTextFile> file = openTextFile(filePath, MappedTextFile::KeepEmptyLines, errorMessage);
+    if (!file) {
         return false;
     }
+    file->setLocalEncoding(config.encoding == "GBK" || config.encoding == "GB2312");
 
+    // 只解码起始行附近用于确定表头的几行, 数据行由 loadTextRows 直接按字节解析
     QStringList lines;
-    QString usedEncoding = config.encoding;
-
-    QTextStream in(&file);
-
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-    if (config.encoding != "UTF-8") {
-        QTextCodec* codec = QTextCodec::codecForName(config.encoding.toLocal8Bit());
-        if (codec) {
-            in.setCodec(codec);
-        }
+    int previewLines = qMin(file->lineCount(), qMax(1, config.startRow) + 1);
+    for (int i = 0; i < previewLines; ++i) {
+        lines.append(file->lineText(i));
     }
-#else
-    if (config.encoding == "GBK" || config.encoding == "GB2312") {
-        in.setEncoding(QStringConverter::System);
-    }
-#endif
-
-    // 读取所有行
-    while (!in.atEnd() && lines.size() < m_maxDisplayRows) {
-        QString line = in.readLine();
-        lines.append(line);
-    }
-
-    file.close();
 
     if (lines.isEmpty()) {
         errorMessage = "文件为空或无法读取";
@@ -3087,16 +2935,11 @@ bool DataEditorWidget::loadCsvFileWithConfig(const QString& filePath, const Data
     updateProgress(70, "正在解析数据格式...");
 
     // 检查起始行是否有效
-    if (config.startRow > lines.size()) {
-        errorMessage = QString("起始行 %1 超出文件总行数 %2").arg(config.startRow).arg(lines.size());
+    if (config.startRow > file->lineCount()) {
+        errorMessage = QString("起始行 %1 超出文件总行数 %2").arg(config.startRow).arg(file->lineCount());
         return false;
     }
 
-    if (lines.size() >= m_maxDisplayRows) {
-        m_largeFileMode = true;
-        qDebug() << "启用大文件模式，限制显示行数为" << m_maxDisplayRows;
-    }
-
     // 确定表头
     QStringList headers;
     int dataStartIndex = config.startRow - 1; // 转换为0基索引
@@ -3127,47 +2970,12 @@ bool DataEditorWidget::loadCsvFileWithConfig(const QString& filePath, const Data
         return false;
     }
 
-    m_dataModel->setColumnCount(headers.size());
-    m_dataModel->setHorizontalHeaderLabels(headers);
-
     updateProgress(80, "正在加载数据...");
-
-    // 加载数据行
-    int rowIndex = 0;
-    for (int i = dataStartIndex; i < lines.size(); ++i) {
-        QStringList lineFields = splitCSVLine(lines[i], config.separator);
-
-        // 调整字段数量以匹配列数
-        while (lineFields.size() < headers.size()) {
-            lineFields.append("");
-        }
-        if (lineFields.size() > headers.size()) {
-            lineFields = lineFields.mid(0, headers.size());
-        }
-
-        // 插入新行
-        m_dataModel->insertRow(rowIndex);
-
-        // 填充数据
-        for (int col = 0; col < lineFields.size(); ++col) {
-            QString cellData = lineFields[col].trimmed();
-            QStandardItem* item = new QStandardItem(cellData);
-            item->setForeground(QBrush(QColor("#2c3e50")));
-            m_dataModel->setItem(rowIndex, col, item);
-        }
-        rowIndex++;
-
-        if (i % 100 == 0) {
-            updateProgress(80 + (i * 15 / lines.size()),
-                           QString("已加载 %1 行").arg(rowIndex));
-            QApplication::processEvents(); // 让界面保持响应
-        }
+    if (!loadTextRows(file, dataStartIndex, headers, config.separator, errorMessage)) {
+        return false;
     }
 
-    updateProgress(100, "数据加载完成");
-
-    qDebug() << "成功加载" << m_dataModel->rowCount() << "行数据，"
-             << m_dataModel->columnCount() << "列，使用编码:" << usedEncoding
+    qDebug() << "开始解析数据行:" << headers.size() << "列，使用编码:" << config.encoding
              << "，起始行:" << config.startRow;
 
     return true;
@@ -3175,38 +2983,7 @@ bool DataEditorWidget::loadCsvFileWithConfig(const QString& filePath, const Data
 
 QString DataEditorWidget::detectOptimalSeparator(const QString& filePath)
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return ",";
-    }
-
-    QTextStream in(&file);
-    QString sampleText;
-    int lineCount = 0;
-    while (!in.atEnd() && lineCount < 10) {
-        sampleText += in.readLine() + "\n";
-        lineCount++;
-    }
-    file.close();
-
-    // 统计各种分隔符的出现频率
-    QMap<QString, int> separatorCounts;
-    separatorCounts[","] = sampleText.count(',');
-    separatorCounts["\t"] = sampleText.count('\t');
-    separatorCounts[";"] = sampleText.count(';');
-    separatorCounts["|"] = sampleText.count('|');
-
-    // 找到出现频率最高的分隔符
-    QString bestSeparator = ",";
-    int maxCount = 0;
-    for (auto it = separatorCounts.begin(); it != separatorCounts.end(); ++it) {
-        if (it.value() > maxCount) {
-            maxCount = it.value();
-            bestSeparator = it.key();
-        }
-    }
-
-    return bestSeparator;
+    return CsvParser::detectSeparator(CsvParser::readSample(filePath), {",", "\t", ";", "|"});
 }
 
 bool DataEditorWidget::loadExcelFileOptimized(const QString& filePath, QString& errorMessage)
@@ -3276,68 +3053,20 @@ bool DataEditorWidget::loadCsvFile(const QString& filePath, QString& errorMessag
 
 bool DataEditorWidget::loadCSVFile(const QString& filePath, const QString& separator, QString& errorMessage)
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        errorMessage = QString("无法打开文件: %1").arg(file.errorString());
+    QSharedPointer<MappedTextFile> file = openTextFile(filePath, MappedTextFile::SkipEmptyLines, errorMessage);
+    if (!file) {
         return false;
     }
+    // 文件头不是合法 UTF-8 时按系统编码 (GBK) 解码
+    QString usedEncoding = CsvParser::detectEncoding(file->head(64 * 1024));
+    file->setLocalEncoding(usedEncoding == "GBK");
 
+    // 只解码前几行用于分隔符校验与表头判断, 数据行由 loadTextRows 直接按字节解析
     QStringList lines;
-    QString usedEncoding = "UTF-8";
-
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-    QStringList encodings = {"UTF-8", "GBK"};
-
-    for (const QString& encoding : encodings) {
-        file.seek(0);
-        QTextStream in(&file);
-
-        if (encoding != "UTF-8") {
-            QTextCodec* codec = QTextCodec::codecForName(encoding.toLocal8Bit());
-            if (codec) {
-                in.setCodec(codec);
-            }
-        }
-
-        lines.clear();
-        while (!in.atEnd() && lines.size() < m_maxDisplayRows) {
-            QString line = in.readLine().trimmed();
-            if (!line.isEmpty()) {
-                lines.append(line);
-            }
-        }
-
-        if (!lines.isEmpty()) {
-            usedEncoding = encoding;
-            break;
-        }
-    }
-#else
-    QTextStream in(&file);
-    while (!in.atEnd() && lines.size() < m_maxDisplayRows) {
-        QString line = in.readLine().trimmed();
-        if (!line.isEmpty()) {
-            lines.append(line);
-        }
+    for (int i = 0; i < qMin(file->lineCount(), 6); ++i) {
+        lines.append(file->lineText(i).trimmed());
     }
 
-    if (lines.isEmpty()) {
-        file.seek(0);
-        QTextStream in2(&file);
-        in2.setEncoding(QStringConverter::Latin1);
-
-        while (!in2.atEnd() && lines.size() < m_maxDisplayRows) {
-            QString line = in2.readLine().trimmed();
-            if (!line.isEmpty()) {
-                lines.append(line);
-            }
-        }
-        usedEncoding = "Latin-1";
-    }
-#endif
-
-    file.close();
-
     if (lines.isEmpty()) {
         errorMessage = "文件为空或无法读取";
         return false;
@@ -3345,11 +3074,6 @@ bool DataEditorWidget::loadCSVFile(const QString& filePath, const QString& separ
 
     updateProgress(70, "正在解析数据格式...");
 
-    if (lines.size() >= m_maxDisplayRows) {
-        m_largeFileMode = true;
-        qDebug() << "启用大文件模式，限制显示行数为" << m_maxDisplayRows;
-    }
-
     QString firstLine = lines.first();
     QStringList fields = splitCSVLine(firstLine, separator);
 
@@ -3382,9 +3106,6 @@ bool DataEditorWidget::loadCSVFile(const QString& filePath, const QString& separ
         }
     }
 
-    m_dataModel->setColumnCount(headers.size());
-    m_dataModel->setHorizontalHeaderLabels(headers);
-
     // 检查第一行是否为表头
     bool firstRowIsHeader = false;
     for (const QString& field : fields) {
@@ -3397,42 +3118,11 @@ bool DataEditorWidget::loadCSVFile(const QString& filePath, const QString& separ
     }
 
     int dataStartRow = firstRowIsHeader ? 1 : 0;
-    int rowIndex = 0;
-
-    // 批量插入行以提高性能
-    int totalDataRows = lines.size() - dataStartRow;
-    m_dataModel->setRowCount(totalDataRows);
-
-    for (int i = dataStartRow; i < lines.size(); ++i) {
-        QStringList lineFields = splitCSVLine(lines[i], separator);
-
-        while (lineFields.size() < headers.size()) {
-            lineFields.append("");
-        }
-
-        if (lineFields.size() > headers.size()) {
-            lineFields = lineFields.mid(0, headers.size());
-        }
-
-        for (int col = 0; col < lineFields.size(); ++col) {
-            QString cellData = lineFields[col].trimmed();
-            QStandardItem* item = new QStandardItem(cellData);
-            item->setForeground(QBrush(QColor("#2c3e50")));
-            m_dataModel->setItem(rowIndex, col, item);
-        }
-        rowIndex++;
-
-        if (i % 500 == 0) {
-            updateProgress(80 + (i * 15 / lines.size()),
-                           QString("已加载 %1/%2 行").arg(i).arg(lines.size()));
-            QApplication::processEvents(); // 让界面保持响应
-        }
+    if (!loadTextRows(file, dataStartRow, headers, separator, errorMessage)) {
+        return false;
     }
 
-    updateProgress(100, "数据加载完成");
-
-    qDebug() << "成功加载" << m_dataModel->rowCount() << "行数据，"
-             << m_dataModel->columnCount() << "列，使用编码:" << usedEncoding;
+    qDebug() << "开始解析数据行:" << headers.size() << "列，使用编码:" << usedEncoding;
 
     return true;
 }
@@ -3461,6 +3151,200 @@ QStringList DataEditorWidget::splitCSVLine(const QString& line, const QString& s
     return result;
 }
 
+QSharedPointer<MappedTextFile> DataEditorWidget::openTextFile(const QString& filePath, MappedTextFile::LineMode mode, QString& errorMessage)
+{
+    QSharedPointer<MappedTextFile> file(new MappedTextFile);
+    if (!file->open(filePath, mode, &errorMessage)) {
+        return QSharedPointer<MappedTextFile>();
+    }
+    qDebug() << "内存映射" << file->lineCount() << "行，行索引" << file->indexMemory() / 1024 << "KB";
+    return file;
+}
+
+bool DataEditorWidget::loadTextRows(const QSharedPointer<MappedTextFile>& file, int firstDataLine,
+                                    const QStringList& headers, const QString& separator, QString& errorMessage)
+{
+    const int columnCount = headers.size();
+    if (columnCount == 0) {
+        errorMessage = "无法确定数据列结构";
+        return false;
+    }
+    const QByteArray sep = separator.toUtf8();
+
+    // 解析在线程池中分块并行进行, 不阻塞界面也不嵌套事件循环; 解析器与映射文件由任务和完成回调共同持有,
+    // 控件在解析中途销毁时回调随 watcher 一起释放, 后台任务仍可安全结束
+    QSharedPointer<CsvParser> parser(new CsvParser);
+    connect(parser.data(), &CsvParser::progress, this, [this](int percent, const QString& message) {
+        setProgressValue(80 + percent * 15 / 100, message);
+    });
+    auto* watcher = new QFutureWatcher<CsvParser::Result>(this);
+    m_textLoad = watcher;
+    connect(watcher, &QFutureWatcher<CsvParser::Result>::finished, this,
+            [this, watcher, parser, file, firstDataLine, headers, sep]() {
+        const CsvParser::Result parsed = watcher->result();
+        watcher->deleteLater();
+        m_textLoad = nullptr;
+
+        // 含非数值文本的列先留在映射中; 未达到大文件行数时立即转为文本列并释放映射, 不占用源文件
+        m_dataModel->setMappedTable(headers, parsed.columns, file, firstDataLine, sep, parsed.textFields);
+        m_largeFileMode = file->lineCount() >= m_maxDisplayRows;
+        if (!m_largeFileMode) {
+            m_dataModel->materialize();
+        }
+
+        setProgressValue(100, "数据加载完成");
+
+        qDebug() << (m_largeFileMode ? "大文件模式加载" : "加载") << parsed.rowCount << "行数据，" << headers.size()
+                 << "列，占用内存约" << m_dataModel->memoryUsage() / 1024 << "KB";
+
+        finishLoading(true, false, QString());
+    });
+    watcher->setFuture(QtConcurrent::run([parser, file, firstDataLine, columnCount, sep]() {
+        return parser->parse(*file, firstDataLine, columnCount, sep);
+    }));
+
+    return true;
+}
+
+bool DataEditorWidget::loadDataCache(const QString& filePath, const QString& loadKey)
+{
+    QString projectDir = ModelParameter::instance()->getProjectPath();
+    if (projectDir.isEmpty()) {
+        return false;
+    }
+
+    QString cacheFile = DataSetCache::cacheFilePath(projectDir, filePath);
+    DataSetCache::Content content;
+    QString error;
+    if (!DataSetCache::read(cacheFile, DataSetCache::describe(filePath, loadKey), &content, &error)) {
+        qDebug() << "未使用数据缓存:" << error;
+        return false;
+    }
+
+    QStringList headers;
+    QVector<DataColumn> columns;
+    QVector<int> sourceFields;
+    bool deferred = false;
+    for (const DataSetCache::Column& column : content.columns) {
+        headers.append(column.header);
+        columns.append(column.data);
+        sourceFields.append(column.sourceField);
+        deferred = deferred || column.sourceField >= 0;
+    }
+
+    // 大文件模式下留在映射中的文本列: 重新映射来源文件, 只建行索引, 不再解析
+    QSharedPointer<MappedTextFile> source;
+    if (deferred) {
+        source.reset(new MappedTextFile);
+        if (!source->open(filePath, MappedTextFile::LineMode(content.lineMode), &error)
+            || source->lineCount() < content.firstLine + content.rowCount) {
+            qDebug() << "数据缓存的来源文件无法映射:" << error;
+            return false;
+        }
+        source->setLocalEncoding(content.localEncoding);
+    }
+
+    m_dataModel->setMappedTable(headers, columns, source, content.firstLine, content.separator, sourceFields);
+    m_largeFileMode = content.rowCount >= m_maxDisplayRows;
+    m_columnDefinitions = columnDefinitionsFromJson(content.metadata);
+    m_dataCacheFile = cacheFile;
+
+    updateProgress(100, "已从数据缓存加载");
+    qDebug() << "从数据缓存加载" << content.rowCount << "行数据，" << columns.size() << "列:" << cacheFile;
+    return true;
+}
+
+void DataEditorWidget::saveDataCache()
+{
+    m_dataCacheFile.clear();
+    QString projectDir = ModelParameter::instance()->getProjectPath();
+    if (projectDir.isEmpty() || m_currentFilePath.isEmpty()) {
+        return;
+    }
+
+    DataSetCache::Content content;
+    content.source = DataSetCache::describe(m_currentFilePath, m_loadKey);
+    content.rowCount = m_dataModel->rowCount();
+    for (int c = 0; c < m_dataModel->columnCount(); ++c) {
+        DataSetCache::Column column;
+        column.header = m_dataModel->headerText(c);
+        column.data = m_dataModel->column(c);
+        column.sourceField = m_dataModel->sourceField(c);
+        content.columns.append(column);
+    }
+    if (QSharedPointer<MappedTextFile> source = m_dataModel->source()) {
+        content.firstLine = m_dataModel->sourceFirstLine();
+        content.separator = m_dataModel->sourceSeparator();
+        content.localEncoding = source->localEncoding();
+        content.lineMode = int(source->lineMode());
+    }
+    content.metadata = columnDefinitionsToJson();
+
+    // 列数据隐式共享: 后台写文件期间界面上的修改会先复制, 不影响写出的内容
+    QString cacheFile = DataSetCache::cacheFilePath(projectDir, m_currentFilePath);
+    m_dataCacheFile = cacheFile;
+    m_cacheWrite = QtConcurrent::run([cacheFile, content]() {
+        QString error;
+        bool ok = DataSetCache::write(cacheFile, content, &error);
+        if (!ok) {
+            qDebug() << "写入数据缓存失败:" << error;
+        }
+        return ok;
+    });
+}
+
+void DataEditorWidget::saveColumnDefinitionsToCache()
+{
+    if (m_dataCacheFile.isEmpty()) {
+        return;
+    }
+    // 数据缓存可能仍在后台写入
+    m_cacheWrite.waitForFinished();
+    QString error;
+    if (!DataSetCache::updateMetadata(m_dataCacheFile, columnDefinitionsToJson(), &error)) {
+        qDebug() << "更新数据缓存的列定义失败:" << error;
+    }
+}
+
+QJsonObject DataEditorWidget::columnDefinitionsToJson() const
+{
+    QJsonArray columns;
+    for (const ColumnDefinition& def : m_columnDefinitions) {
+        QJsonObject obj;
+        obj["name"] = def.name;
+        obj["type"] = static_cast<int>(def.type);
+        obj["unit"] = def.unit;
+        obj["description"] = def.description;
+        obj["isRequired"] = def.isRequired;
+        obj["minValue"] = def.minValue;
+        obj["maxValue"] = def.maxValue;
+        obj["decimalPlaces"] = def.decimalPlaces;
+        columns.append(obj);
+    }
+    QJsonObject root;
+    root["columnDefinitions"] = columns;
+    return root;
+}
+
+QList<ColumnDefinition> DataEditorWidget::columnDefinitionsFromJson(const QJsonObject& root)
+{
+    QList<ColumnDefinition> definitions;
+    for (const QJsonValue& value : root["columnDefinitions"].toArray()) {
+        QJsonObject obj = value.toObject();
+        ColumnDefinition def;
+        def.name = obj["name"].toString();
+        def.type = static_cast<WellTestColumnType>(obj["type"].toInt(static_cast<int>(WellTestColumnType::Custom)));
+        def.unit = obj["unit"].toString();
+        def.description = obj["description"].toString();
+        def.isRequired = obj["isRequired"].toBool();
+        def.minValue = obj["minValue"].toDouble(def.minValue);
+        def.maxValue = obj["maxValue"].toDouble(def.maxValue);
+        def.decimalPlaces = obj["decimalPlaces"].toInt(def.decimalPlaces);
+        definitions.append(def);
+    }
+    return definitions;
+}
+
 bool DataEditorWidget::loadExcelFile(const QString& filePath, QString& errorMessage)
 {
     return loadExcelFileOptimized(filePath, errorMessage);
@@ -3510,23 +3394,22 @@ bool DataEditorWidget::loadJsonFile(const QString& filePath, QString& errorMessa
         QJsonObject firstObj = array.first().toObject();
         QStringList headers = firstObj.keys();
 
-        m_dataModel->setColumnCount(headers.size());
-        m_dataModel->setHorizontalHeaderLabels(headers);
+        QVector<DataColumn> columns(headers.size());
+        for (DataColumn& column : columns) {
+            column.reserve(array.size());
+        }
 
         for (int i = 0; i < array.size(); ++i) {
             QJsonObject obj = array[i].toObject();
-            m_dataModel->insertRow(i);
 
             for (int col = 0; col < headers.size(); ++col) {
                 QString key = headers[col];
-                QString value = obj[key].toString();
-
-                QStandardItem* item = new QStandardItem(value);
-                item->setForeground(QBrush(QColor("#2c3e50")));
-                m_dataModel->setItem(i, col, item);
+                columns[col].appendText(obj[key].toString());
             }
         }
 
+        m_dataModel->setTable(headers, columns);
+
         return true;
     }
 
@@ -3579,9 +3462,6 @@ bool DataEditorWidget::loadExcelWithCOM(const QString& filePath, QString& errorM
             return false;
         }
 
-        m_dataModel->setRowCount(rowCount > 1 ? rowCount-1 : 0);
-        m_dataModel->setColumnCount(columnCount);
-
         // 设置表头
         QStringList headers;
         for (int col = 1; col <= columnCount; ++col) {
@@ -3592,18 +3472,17 @@ bool DataEditorWidget::loadExcelWithCOM(const QString& filePath, QString& errorM
             }
             headers.append(headerText);
         }
-        m_dataModel->setHorizontalHeaderLabels(headers);
 
         // 读取数据
+        QVector<DataColumn> data(columnCount, DataColumn(rowCount > 1 ? rowCount-1 : 0));
         for (int row = 2; row <= rowCount; ++row) {
             for (int col = 1; col <= columnCount; ++col) {
                 QAxObject* cell = worksheet->querySubObject("Cells(int,int)", row, col);
                 QString value = cell ? cell->property("Value").toString() : "";
-                QStandardItem* item = new QStandardItem(value);
-                item->setForeground(QBrush(QColor("#2c3e50")));
-                m_dataModel->setItem(row-2, col-1, item);
+                data[col-1].setText(row-2, value);
             }
         }
+        m_dataModel->setTable(headers, data);
 
         workbook->dynamicCall("Close()");
         excel.dynamicCall("Quit()");
@@ -3712,6 +3591,7 @@ void DataEditorWidget::onDefineColumns()
     ColumnDefinitionDialog dialog(columnNames, m_columnDefinitions, this);
     if (dialog.exec() == QDialog::Accepted) {
         m_columnDefinitions = dialog.getColumnDefinitions();
+        saveColumnDefinitionsToCache();
 
         // 更新列标题
         updateColumnHeaders();
@@ -3836,7 +3716,9 @@ void DataEditorWidget::onDataStatistics()
             statisticsText += QString("最小值: %1 %2\n").arg(formatNumber(stat.minimum)).arg(stat.unit);
             statisticsText += QString("最大值: %1 %2\n").arg(formatNumber(stat.maximum)).arg(stat.unit);
             statisticsText += QString("平均值: %1 %2\n").arg(formatNumber(stat.average)).arg(stat.unit);
+            statisticsText += QString("下四分位数: %1 %2\n").arg(formatNumber(stat.lowerQuartile)).arg(stat.unit);
             statisticsText += QString("中位数: %1 %2\n").arg(formatNumber(stat.median)).arg(stat.unit);
+            statisticsText += QString("上四分位数: %1 %2\n").arg(formatNumber(stat.upperQuartile)).arg(stat.unit);
             statisticsText += QString("标准差: %1 %2\n").arg(formatNumber(stat.standardDeviation)).arg(stat.unit);
         }
 
@@ -3907,68 +3789,31 @@ DataStatistics DataEditorWidget::calculateColumnStatistics(int column) const
         stats.unit = m_columnDefinitions[column].unit;
     }
 
-    stats.dataCount = m_dataModel->rowCount();
-    stats.validCount = 0;
-    stats.invalidCount = 0;
-
-    QList<double> numericValues;
-    QStringList textValues;
+    // 统计量由缓存提供: 单元格修改与删行后按增量更新, 只有失效的部分才分块并行扫描一遍;
+    // 文本列不需要分位数, 用 moments() 避免分位数失效引起的扫描
+    ColumnStatistics::Summary summary = m_statisticsCache->moments(column);
+    if (summary.isNumeric()) summary = m_statisticsCache->summary(column);
+    stats.dataCount = summary.count;
+    stats.validCount = summary.numeric + summary.text;
+    stats.invalidCount = summary.empty;
 
-    for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-        QStandardItem* item = m_dataModel->item(row, column);
-        QString value = item ? item->text().trimmed() : "";
-
-        if (value.isEmpty()) {
-            stats.invalidCount++;
-            continue;
-        }
-
-        bool isNumeric;
-        double numValue = value.toDouble(&isNumeric);
-
-        if (isNumeric) {
-            numericValues.append(numValue);
-            stats.validCount++;
-        } else {
-            textValues.append(value);
-            stats.validCount++;
-        }
-    }
-
-    if (numericValues.size() > textValues.size()) {
+    if (summary.isNumeric()) {
         stats.dataType = "数值型";
-
-        if (!numericValues.isEmpty()) {
-            std::sort(numericValues.begin(), numericValues.end());
-
-            stats.minimum = numericValues.first();
-            stats.maximum = numericValues.last();
-
-            double sum = 0;
-            for (double val : numericValues) {
-                sum += val;
-            }
-            stats.average = sum / numericValues.size();
-
-            int size = numericValues.size();
-            if (size % 2 == 0) {
-                stats.median = (numericValues[size/2 - 1] + numericValues[size/2]) / 2.0;
-            } else {
-                stats.median = numericValues[size/2];
-            }
-
-            double variance = 0;
-            for (double val : numericValues) {
-                variance += std::pow(val - stats.average, 2);
-            }
-            stats.standardDeviation = std::sqrt(variance / numericValues.size());
-        }
+        stats.minimum = summary.minimum;
+        stats.maximum = summary.maximum;
+        stats.average = summary.mean;
+        stats.median = summary.median;
+        stats.lowerQuartile = summary.lowerQuartile;
+        stats.upperQuartile = summary.upperQuartile;
+        stats.standardDeviation = std::sqrt(summary.variance());
     } else {
         stats.dataType = "文本型";
         stats.minimum = 0;
         stats.maximum = 0;
         stats.average = 0;
         stats.median = 0;
+        stats.lowerQuartile = 0;
+        stats.upperQuartile = 0;
         stats.standardDeviation = 0;
     }
 
@@ -4003,8 +3848,7 @@ void DataEditorWidget::removeEmptyRows()
     for (int row = 0; row < m_dataModel->rowCount(); ++row) {
         bool isEmpty = true;
         for (int col = 0; col < m_dataModel->columnCount(); ++col) {
-            QStandardItem* item = m_dataModel->item(row, col);
-            if (item && !item->text().trimmed().isEmpty()) {
+            if (!m_dataModel->isEmpty(row, col)) {
                 isEmpty = false;
                 break;
             }
@@ -4021,8 +3865,7 @@ void DataEditorWidget::removeEmptyRows()
         for (int row : emptyRows) {
             QStringList rowData;
             for (int col = 0; col < m_dataModel->columnCount(); ++col) {
-                QStandardItem* item = m_dataModel->item(row, col);
-                rowData.append(item ? item->text() : "");
+                rowData.append(m_dataModel->text(row, col));
             }
 
             RowEditCommand* command = new RowEditCommand(m_dataModel, RowEditCommand::Delete, row, rowData);
@@ -4041,8 +3884,7 @@ void DataEditorWidget::removeEmptyColumns()
     for (int col = 0; col < m_dataModel->columnCount(); ++col) {
         bool isEmpty = true;
         for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-            QStandardItem* item = m_dataModel->item(row, col);
-            if (item && !item->text().trimmed().isEmpty()) {
+            if (!m_dataModel->isEmpty(row, col)) {
                 isEmpty = false;
                 break;
             }
@@ -4057,16 +3899,10 @@ void DataEditorWidget::removeEmptyColumns()
 
         m_undoStack->beginMacro("删除空列");
         for (int col : emptyColumns) {
-            QStandardItem* headerItem = m_dataModel->horizontalHeaderItem(col);
-            QString headerName = headerItem ? headerItem->text() : QString("列%1").arg(col + 1);
-
-            QStringList columnData;
-            for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-                QStandardItem* item = m_dataModel->item(row, col);
-                columnData.append(item ? item->text() : "");
-            }
+            QString headerName = m_dataModel->headerText(col);
+            if (headerName.isNull()) headerName = QString("列%1").arg(col + 1);
 
-            ColumnEditCommand* command = new ColumnEditCommand(m_dataModel, ColumnEditCommand::Delete, col, headerName, columnData);
+            ColumnEditCommand* command = new ColumnEditCommand(m_dataModel, ColumnEditCommand::Delete, col, headerName, m_dataModel->column(col));
             m_undoStack->push(command);
         }
         m_undoStack->endMacro();
@@ -4083,8 +3919,7 @@ void DataEditorWidget::removeDuplicates()
     for (int row = 0; row < m_dataModel->rowCount(); ++row) {
         QStringList rowData;
         for (int col = 0; col < m_dataModel->columnCount(); ++col) {
-            QStandardItem* item = m_dataModel->item(row, col);
-            rowData.append(item ? item->text().trimmed() : "");
+            rowData.append(m_dataModel->text(row, col).trimmed());
         }
 
         QString rowSignature = rowData.join("|");
@@ -4102,8 +3937,7 @@ void DataEditorWidget::removeDuplicates()
         for (int row : duplicateRows) {
             QStringList rowData;
             for (int col = 0; col < m_dataModel->columnCount(); ++col) {
-                QStandardItem* item = m_dataModel->item(row, col);
-                rowData.append(item ? item->text() : "");
+                rowData.append(m_dataModel->text(row, col));
             }
 
             RowEditCommand* command = new RowEditCommand(m_dataModel, RowEditCommand::Delete, row, rowData);
@@ -4122,15 +3956,11 @@ void DataEditorWidget::fillMissingValues(const QString& method)
         QList<int> validIndices;
 
         // 收集有效的数值
-        for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-            QStandardItem* item = m_dataModel->item(row, col);
-            if (item) {
-                bool ok;
-                double value = item->text().toDouble(&ok);
-                if (ok) {
-                    numericValues.append(value);
-                    validIndices.append(row);
-                }
+        const QVector<double> columnValues = m_dataModel->columnValues(col);
+        for (int row = 0; row < columnValues.size(); ++row) {
+            if (!std::isnan(columnValues[row])) {
+                numericValues.append(columnValues[row]);
+                validIndices.append(row);
             }
         }
 
@@ -4138,8 +3968,7 @@ void DataEditorWidget::fillMissingValues(const QString& method)
 
         // 填充缺失值
         for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-            QStandardItem* item = m_dataModel->item(row, col);
-            if (!item || item->text().trimmed().isEmpty()) {
+            if (m_dataModel->isEmpty(row, col)) {
                 QString fillValue;
 
                 if (method == "zero") {
@@ -4158,22 +3987,16 @@ void DataEditorWidget::fillMissingValues(const QString& method)
                 } else if (method == "forward") {
                     // 前值填充
                     for (int prevRow = row - 1; prevRow >= 0; --prevRow) {
-                        QStandardItem* prevItem = m_dataModel->item(prevRow, col);
-                        if (prevItem && !prevItem->text().trimmed().isEmpty()) {
-                            fillValue = prevItem->text();
+                        if (!m_dataModel->isEmpty(prevRow, col)) {
+                            fillValue = m_dataModel->text(prevRow, col);
                             break;
                         }
                     }
                 }
 
                 if (!fillValue.isEmpty()) {
-                    if (!item) {
-                        item = new QStandardItem(fillValue);
-                        m_dataModel->setItem(row, col, item);
-                    } else {
-                        item->setText(fillValue);
-                    }
-                    item->setForeground(QBrush(QColor("#6c757d"))); // 标记为填充值
+                    m_dataModel->setText(row, col, fillValue);
+                    m_dataModel->setCellForeground(row, col, QColor("#6c757d")); // 标记为填充值
                 }
             }
         }
@@ -4189,15 +4012,11 @@ void DataEditorWidget::removeOutliers(double threshold)
         QList<int> validRows;
 
         // 收集数值数据
-        for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-            QStandardItem* item = m_dataModel->item(row, col);
-            if (item) {
-                bool ok;
-                double value = item->text().toDouble(&ok);
-                if (ok) {
-                    values.append(value);
-                    validRows.append(row);
-                }
+        const QVector<double> columnValues = m_dataModel->columnValues(col);
+        for (int row = 0; row < columnValues.size(); ++row) {
+            if (!std::isnan(columnValues[row])) {
+                values.append(columnValues[row]);
+                validRows.append(row);
             }
         }
 
@@ -4229,10 +4048,7 @@ void DataEditorWidget::removeOutliers(double threshold)
             std::sort(outlierRows.begin(), outlierRows.end(), std::greater<int>());
 
             for (int row : outlierRows) {
-                QStandardItem* item = m_dataModel->item(row, col);
-                if (item) {
-                    item->setText(""); // 清空异常值
-                }
+                m_dataModel->setText(row, col, QString()); // 清空异常值
             }
         }
     }
@@ -4244,10 +4060,7 @@ void DataEditorWidget::standardizeDataFormat()
 
     for (int col = 0; col < m_dataModel->columnCount(); ++col) {
         for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-            QStandardItem* item = m_dataModel->item(row, col);
-            if (!item) continue;
-
-            QString text = item->text().trimmed();
+            QString text = m_dataModel->text(row, col).trimmed();
             if (text.isEmpty()) continue;
 
             // 根据列定义标准化格式
@@ -4264,11 +4077,22 @@ void DataEditorWidget::standardizeDataFormat()
                     double value = text.toDouble(&ok);
                     if (ok) {
                         QString formatted = QString::number(value, 'f', def.decimalPlaces);
-                        item->setText(formatted);
+                        m_dataModel->setText(row, col, formatted);
                     }
                 }
             }
         }
+
+        // 数值列只存 double, 小数位由列的显示精度保留
+        if (col < m_columnDefinitions.size() && m_dataModel->isNumericColumn(col)) {
+            const ColumnDefinition& def = m_columnDefinitions[col];
+            if (def.type == WellTestColumnType::Pressure ||
+                def.type == WellTestColumnType::Temperature ||
+                def.type == WellTestColumnType::FlowRate ||
+                def.type == WellTestColumnType::Time) {
+                m_dataModel->setColumnPrecision(col, def.decimalPlaces);
+            }
+        }
     }
 }
 
@@ -4292,6 +4116,11 @@ bool DataEditorWidget::saveCsvFile(const QString& filePath)
         return false;
     }
 
+    // 覆盖大文件模式映射中的源文件前, 先把映射列读入内存
+    if (m_dataModel->isMapped() && QFileInfo(filePath) == QFileInfo(m_dataModel->sourceFileName())) {
+        m_dataModel->materialize();
+    }
+
     QFile file(filePath);
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
         return false;
@@ -4316,8 +4145,7 @@ bool DataEditorWidget::saveCsvFile(const QString& filePath)
     for (int row = 0; row < m_dataModel->rowCount(); ++row) {
         QStringList fields;
         for (int col = 0; col < m_dataModel->columnCount(); ++col) {
-            QStandardItem* item = m_dataModel->item(row, col);
-            QString text = item ? item->text() : "";
+            QString text = m_dataModel->text(row, col);
 
             if (text.contains(',') || text.contains('"') || text.contains('\n')) {
                 text = '"' + text.replace('"', "\"\"") + '"';
@@ -4348,16 +4176,12 @@ bool DataEditorWidget::saveJsonFile(const QString& filePath)
         QJsonObject jsonObject;
 
         for (int col = 0; col < m_dataModel->columnCount(); ++col) {
-            QStandardItem* item = m_dataModel->item(row, col);
-            QString value = item ? item->text() : "";
-
-            bool isNumber;
-            double numValue = value.toDouble(&isNumber);
+            double numValue = m_dataModel->value(row, col);
 
-            if (isNumber) {
+            if (!std::isnan(numValue)) {
                 jsonObject[headers[col]] = numValue;
             } else {
-                jsonObject[headers[col]] = value;
+                jsonObject[headers[col]] = m_dataModel->text(row, col);
             }
         }
 
@@ -4423,8 +4247,7 @@ bool DataEditorWidget::exportToPdf(const QString& filePath)
     for (int row = 0; row < maxRows; ++row) {
         htmlContent += "<tr>";
         for (int col = 0; col < m_dataModel->columnCount(); ++col) {
-            QStandardItem* item = m_dataModel->item(row, col);
-            QString text = item ? item->text() : "";
+            QString text = m_dataModel->text(row, col);
             htmlContent += QString("<td>%1</td>").arg(text.toHtmlEscaped());
         }
         htmlContent += "</tr>";
@@ -4518,8 +4341,7 @@ bool DataEditorWidget::exportToHtml(const QString& filePath)
     for (int row = 0; row < m_dataModel->rowCount(); ++row) {
         out << "<tr>\n";
         for (int col = 0; col < m_dataModel->columnCount(); ++col) {
-            QStandardItem* item = m_dataModel->item(row, col);
-            QString text = item ? item->text() : "";
+            QString text = m_dataModel->text(row, col);
             out << QString("<td>%1</td>\n").arg(text.toHtmlEscaped());
         }
         out << "</tr>\n";
@@ -4559,8 +4381,7 @@ ValidationResult DataEditorWidget::validateData() const
         bool isEmpty = true;
 
         for (int col = 0; col < m_dataModel->columnCount(); ++col) {
-            QStandardItem* item = m_dataModel->item(row, col);
-            QString value = item ? item->text().trimmed() : "";
+            QString value = m_dataModel->text(row, col).trimmed();
 
             if (!value.isEmpty()) {
                 isEmpty = false;
@@ -4600,8 +4421,7 @@ bool DataEditorWidget::validateColumnData(int columnIndex, const ColumnDefinitio
     int emptyCount = 0;
 
     for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-        QStandardItem* item = m_dataModel->item(row, columnIndex);
-        QString value = item ? item->text().trimmed() : "";
+        QString value = m_dataModel->text(row, columnIndex).trimmed();
 
         if (value.isEmpty()) {
             emptyCount++;
@@ -4679,8 +4499,7 @@ QStringList DataEditorWidget::detectDataType(int column) const
     QSet<QString> types;
 
     for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-        QStandardItem* item = m_dataModel->item(row, column);
-        QString value = item ? item->text().trimmed() : "";
+        QString value = m_dataModel->text(row, column).trimmed();
 
         if (value.isEmpty()) {
             continue;
@@ -4737,29 +4556,28 @@ void DataEditorWidget::applyColumnDefinition(int columnIndex, const ColumnDefini
         return;
     }
 
-    // 应用数据格式
-    for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-        QStandardItem* item = m_dataModel->item(row, columnIndex);
-        if (!item) continue;
+    // 根据类型格式化数值
+    if (definition.type == WellTestColumnType::Pressure ||
+        definition.type == WellTestColumnType::Temperature ||
+        definition.type == WellTestColumnType::FlowRate ||
+        definition.type == WellTestColumnType::Time) {
 
-        // 根据类型格式化数值
-        if (definition.type == WellTestColumnType::Pressure ||
-            definition.type == WellTestColumnType::Temperature ||
-            definition.type == WellTestColumnType::FlowRate ||
-            definition.type == WellTestColumnType::Time) {
-
-            bool ok;
-            double value = item->text().toDouble(&ok);
-            if (ok) {
-                QString formatted = QString::number(value, 'f', definition.decimalPlaces);
-                item->setText(formatted);
+        if (m_dataModel->isNumericColumn(columnIndex)) {
+            // 数值列按列设置显示小数位, 存储的数值不变
+            m_dataModel->setColumnPrecision(columnIndex, definition.decimalPlaces);
+        } else {
+            for (int row = 0; row < m_dataModel->rowCount(); ++row) {
+                double value = m_dataModel->value(row, columnIndex);
+                if (!std::isnan(value)) {
+                    m_dataModel->setText(row, columnIndex, QString::number(value, 'f', definition.decimalPlaces));
+                }
             }
         }
+    }
 
-        // 设置颜色标记
-        if (definition.isRequired) {
-            item->setBackground(QBrush(QColor("#fff3cd"))); // 淡黄色背景表示必需
-        }
+    // 设置颜色标记
+    if (definition.isRequired) {
+        m_dataModel->setColumnBackground(columnIndex, QColor("#fff3cd")); // 淡黄色背景表示必需
     }
 }
 
@@ -4803,23 +4621,16 @@ bool DataEditorWidget::canRedo() const
 // 数据模型变化处理
 // ============================================================================
 
-void DataEditorWidget::onCellDataChanged(QStandardItem* item)
-{
-    if (!item || !m_undoStack) {
-        return;
-    }
-
-    m_dataModified = true;
-    updateStatus("数据已修改", "warning");
-    updateDataInfo();
-    emitDataChanged();
-}
-
-void DataEditorWidget::onModelDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight)
+void DataEditorWidget::onModelDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QList<int>& roles)
 {
     Q_UNUSED(topLeft)
     Q_UNUSED(bottomRight)
 
+    // 仅样式变化 (填充值标记、列颜色等) 不算数据修改
+    if (!roles.isEmpty() && !roles.contains(Qt::DisplayRole) && !roles.contains(Qt::EditRole)) {
+        return;
+    }
+
     m_dataModified = true;
     updateStatus("数据已修改", "warning");
     updateDataInfo();
@@ -4892,7 +4703,10 @@ void DataEditorWidget::showAnimatedProgress(const QString& title, const QString&
     }
 
     m_progressDialog->show();
-    QApplication::processEvents();
+    // 加载期间不在此处理事件 (进度由事件循环刷新), 避免重入加载流程
+    if (!m_loading) {
+        QApplication::processEvents();
+    }
 }
 
 void DataEditorWidget::hideAnimatedProgress()
@@ -4903,13 +4717,20 @@ void DataEditorWidget::hideAnimatedProgress()
 }
 
 void DataEditorWidget::updateProgress(int value, const QString& message)
+{
+    setProgressValue(value, message);
+    if (m_progressDialog && !m_loading) {
+        QApplication::processEvents();
+    }
+}
+
+void DataEditorWidget::setProgressValue(int value, const QString& message)
 {
     if (m_progressDialog) {
         m_progressDialog->setProgress(value);
         if (!message.isEmpty()) {
             m_progressDialog->setMessage(message);
         }
-        QApplication::processEvents();
     }
 }
 
@@ -4931,6 +4752,7 @@ void DataEditorWidget::clearData()
     clearDataFilter();
 
     m_columnDefinitions.clear();
+    m_dataCacheFile.clear();
     updateStatus("就绪", "success");
     setButtonsEnabled(false);
 
@@ -4947,13 +4769,9 @@ void DataEditorWidget::applyColumnStyles()
 
     QColor textColor("#2c3e50");
 
-    for (int row = 0; row < m_dataModel->rowCount(); ++row) {
-        for (int col = 0; col < m_dataModel->columnCount(); ++col) {
-            QStandardItem* item = m_dataModel->item(row, col);
-            if (item) {
-                item->setForeground(QBrush(textColor));
-            }
-        }
+    // 颜色按列保存, 不随行数增长
+    for (int col = 0; col < m_dataModel->columnCount(); ++col) {
+        m_dataModel->setColumnForeground(col, textColor);
     }
 }
 
@@ -5237,9 +5055,8 @@ void DataEditorWidget::onPressureDerivativeCalc()
     }
 
     // 获取压力单位
-    QStandardItem* pressureHeader = m_dataModel->horizontalHeaderItem(config.pressureColumnIndex);
-    if (pressureHeader) {
-        QString headerText = pressureHeader->text();
+    QString headerText = m_dataModel->headerText(config.pressureColumnIndex);
+    if (!headerText.isEmpty()) {
         if (headerText.contains("MPa")) {
             config.pressureUnit = "MPa";
         } else if (headerText.contains("kPa")) {
@@ -1,88 +1,22 @@
 ######################################################################
-# Automatically generated by qmake (3.1) Mon May 19 10:02:11 2025
+# WellTest 顶层工程
+#   welltest_core - 计算核心静态库 (模型、拉普拉斯反演、Bessel 函数, 只依赖 QtCore)
+#   welltest_app  - 界面程序 WellTest
+#   welltest_cli  - 命令行批处理
+#   welltest_tests - 计算核心单元测试
 ######################################################################
-QT += core gui axcontainer svg printsupport core5compat concurrent
+TEMPLATE = subdirs
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+SUBDIRS += welltest_core \
+           welltest_app \
+           welltest_cli \
+           welltest_tests
 
-TEMPLATE = app
-TARGET = WellTest
-INCLUDEPATH += .
+welltest_core.file = welltest_core.pro
+welltest_app.file = welltest_app.pro
+welltest_cli.file = welltest_cli.pro
+welltest_tests.file = welltest_tests.pro
 
-# C++17标准支持（试井模型需要）
-CONFIG += c++17
-
-# 编译优化选项
-QMAKE_CXXFLAGS += -O3
-QMAKE_CXXFLAGS_RELEASE -= -O2
-QMAKE_CXXFLAGS_RELEASE += -O3
-
-# 数学库链接
-unix: LIBS += -lm
-win32: LIBS += -lm
-
-# Input
-HEADERS += dataeditorwidget.h \
-           chartsetting1.h \
-           fittingpage.h \
-           fittingwidget.h \
-           modelmanager.h \
-           modelparameter.h \
-           modelselect.h \
-           modelwidget01-06.h \
-           mousezoom.h \
-           plottingwidget.h \
-           mainwindow.h \
-           monitorbtn.h \
-           monitostatew.h \
-           navbtn.h \
-           newprojectdialog.h \
-           pressurederivativecalculator.h \
-           settingswidget.h \
-           qcustomplot.h \
-           wt_projectwidget.h
-
-FORMS += dataeditorwidget.ui \
-         fittingpage.ui \
-         fittingwidget.ui \
-         modelselect.ui \
-         modelwidget01-06.ui \
-         plottingwidget.ui \
-         mainwindow.ui \
-         monitorbtn.ui \
-         monitostatew.ui \
-         navbtn.ui \
-         newprojectdialog.ui \
-         settingswidget.ui \
-         wt_projectwidget.ui
-
-SOURCES += DataEditorWidget.cpp \
-           chartsetting1.cpp \
-           fittingpage.cpp \
-           fittingwidget.cpp \
-           modelmanager.cpp \
-           modelparameter.cpp \
-           modelselect.cpp \
-           modelwidget01-06.cpp \
-           mousezoom.cpp \
-           plottingwidget.cpp \
-           plotwindow.cpp \
-           main.cpp \
-           mainwindow.cpp \
-           monitorbtn.cpp \
-           monitostatew.cpp \
-           navbtn.cpp \
-           newprojectdialog.cpp \
-           pressurederivativecalculator.cpp \
-           settingswidget.cpp \
-           qcustomplot.cpp \
-           wt_projectwidget.cpp
-
-RESOURCES += resource.qrc
-
-INCLUDEPATH += D:/08YYYXXX/eigen-3.3.8
-INCLUDEPATH += D:/08YYYXXX/boost_1_89_0
-
-
-# 警告设置
-QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-parameter
+welltest_app.depends = welltest_core
+welltest_cli.depends = welltest_core
+welltest_tests.depends = welltest_core
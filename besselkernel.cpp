@@ -0,0 +1,393 @@
+#include "besselkernel.h"
+
+#include <boost/math/special_functions/bessel.hpp>
+#include <cmath>
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BESSELKERNEL_HAVE_AVX2 1
+#include <immintrin.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+// 每段 Chebyshev 展开的项数
+const int NCHEB = 36;
+
+// f(t) = c[0]/2 + sum_{k>=1} c[k]*T_k(t), t in [-1, 1]
+struct ChebSeries {
+    double c[NCHEB];
+};
+
+struct Tables {
+    ChebSeries i0a, i0b;   // I0e: [0,8] / (8,inf)
+    ChebSeries i1a, i1b;   // I1e: [0,8] / (8,inf)
+    ChebSeries k0a, k0b;   // K0:  (0,2] / (2,inf)
+    ChebSeries k1a, k1b;   // K1:  (0,2] / (2,inf)
+};
+
+// 大宗量渐近展开的级数部分: sum_k (+/-1)^k a_k(nu) / x^k
+double asymptoticSum(int nu, double x, bool alternating)
+{
+    double mu = 4.0 * nu * nu;
+    double term = 1.0, sum = 1.0;
+    for (int k = 1; k < 30; ++k) {
+        double next = term * (mu - (2.0 * k - 1) * (2.0 * k - 1)) / (k * 8.0 * x);
+        if (std::abs(next) >= std::abs(term)) break;
+        term = next;
+        sum += alternating ? ((k % 2) ? -term : term) : term;
+        if (std::abs(term) < 1e-18 * std::abs(sum)) break;
+    }
+    return sum;
+}
+
+// 参考值 (Boost), 大宗量时改用渐近展开避免上溢/下溢
+double refIeSqrt(int nu, double x) // exp(-x)*sqrt(x)*I_nu(x)
+{
+    if (x > 500.0) return asymptoticSum(nu, x, true) / std::sqrt(2.0 * M_PI);
+    return boost::math::cyl_bessel_i(nu, x) * std::exp(-x) * std::sqrt(x);
+}
+double refKeSqrt(int nu, double x) // exp(x)*sqrt(x)*K_nu(x)
+{
+    if (x > 500.0) return std::sqrt(M_PI / 2.0) * asymptoticSum(nu, x, false);
+    return boost::math::cyl_bessel_k(nu, x) * std::exp(x) * std::sqrt(x);
+}
+
+// 在 Chebyshev 节点上插值得到展开系数
+template <typename G>
+ChebSeries fitChebyshev(G g)
+{
+    double fv[NCHEB];
+    for (int k = 0; k < NCHEB; ++k) fv[k] = g(std::cos(M_PI * (k + 0.5) / NCHEB));
+    ChebSeries s;
+    for (int j = 0; j < NCHEB; ++j) {
+        double sum = 0.0;
+        for (int k = 0; k < NCHEB; ++k) sum += fv[k] * std::cos(M_PI * j * (k + 0.5) / NCHEB);
+        s.c[j] = 2.0 * sum / NCHEB;
+    }
+    return s;
+}
+
+Tables buildTables()
+{
+    using boost::math::cyl_bessel_i;
+    using boost::math::cyl_bessel_k;
+    Tables t;
+    // I0e, I1e/x: x = 4(t+1) in [0,8]
+    t.i0a = fitChebyshev([](double s) { double x = 4.0 * (s + 1.0); return cyl_bessel_i(0, x) * std::exp(-x); });
+    t.i1a = fitChebyshev([](double s) { double x = 4.0 * (s + 1.0); return cyl_bessel_i(1, x) * std::exp(-x) / x; });
+    // sqrt(x)*I_e: x = 16/(t+1) in (8,inf)
+    t.i0b = fitChebyshev([](double s) { return refIeSqrt(0, 16.0 / (s + 1.0)); });
+    t.i1b = fitChebyshev([](double s) { return refIeSqrt(1, 16.0 / (s + 1.0)); });
+    // K0 + log(x/2)*I0, x*(K1 - log(x/2)*I1): x^2 = 2(t+1) in (0,4]
+    t.k0a = fitChebyshev([](double s) {
+        double x = std::sqrt(2.0 * (s + 1.0));
+        return cyl_bessel_k(0, x) + std::log(0.5 * x) * cyl_bessel_i(0, x);
+    });
+    t.k1a = fitChebyshev([](double s) {
+        double x = std::sqrt(2.0 * (s + 1.0));
+        return x * (cyl_bessel_k(1, x) - std::log(0.5 * x) * cyl_bessel_i(1, x));
+    });
+    // exp(x)*sqrt(x)*K: x = 4/(t+1) in (2,inf)
+    t.k0b = fitChebyshev([](double s) { return refKeSqrt(0, 4.0 / (s + 1.0)); });
+    t.k1b = fitChebyshev([](double s) { return refKeSqrt(1, 4.0 / (s + 1.0)); });
+    return t;
+}
+
+const Tables& tables()
+{
+    static const Tables t = buildTables();
+    return t;
+}
+
+inline double clenshaw(const ChebSeries& s, double t)
+{
+    double b1 = 0.0, b2 = 0.0, t2 = 2.0 * t;
+    for (int k = NCHEB - 1; k >= 1; --k) {
+        double b0 = s.c[k] + t2 * b1 - b2;
+        b2 = b1; b1 = b0;
+    }
+    return 0.5 * s.c[0] + t * b1 - b2;
+}
+
+#ifdef BESSELKERNEL_HAVE_AVX2
+__attribute__((target("avx2,fma")))
+void clenshawAvx2(const ChebSeries& s, const double* t, double* out, int n)
+{
+    int i = 0;
+    const __m256d half = _mm256_set1_pd(0.5);
+    for (; i + 4 <= n; i += 4) {
+        __m256d vt = _mm256_loadu_pd(t + i);
+        __m256d vt2 = _mm256_add_pd(vt, vt);
+        __m256d b1 = _mm256_setzero_pd(), b2 = _mm256_setzero_pd();
+        for (int k = NCHEB - 1; k >= 1; --k) {
+            __m256d b0 = _mm256_sub_pd(_mm256_fmadd_pd(vt2, b1, _mm256_set1_pd(s.c[k])), b2);
+            b2 = b1; b1 = b0;
+        }
+        __m256d r = _mm256_fmadd_pd(vt, b1, _mm256_fmsub_pd(half, _mm256_set1_pd(s.c[0]), b2));
+        _mm256_storeu_pd(out + i, r);
+    }
+    for (; i < n; ++i) out[i] = clenshaw(s, t[i]);
+}
+
+bool detectSimd()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+#else
+bool detectSimd() { return false; }
+#endif
+
+bool useSimd()
+{
+    static const bool enabled = detectSimd();
+    return enabled;
+}
+
+// 对 n 个 t 值求同一展开
+inline void clenshawBatch(const ChebSeries& s, const double* t, double* out, int n)
+{
+#ifdef BESSELKERNEL_HAVE_AVX2
+    if (useSimd()) { clenshawAvx2(s, t, out, n); return; }
+#endif
+    for (int i = 0; i < n; ++i) out[i] = clenshaw(s, t[i]);
+}
+
+// 批量处理的分块大小 (栈上缓冲)
+const int BLOCK = 64;
+
+// 两段展开的通用批量求值: 按区间把宗量分组, 每组一次批量 Clenshaw, 再做标量后处理。
+// toT 把 x 映射为对应段的 t, post 由 (下标, x, 展开值) 得到最终函数值
+template <typename ToTA, typename ToTB, typename PostA, typename PostB>
+void piecewiseBatch(const ChebSeries& sa, const ChebSeries& sb, double split,
+                    const double* x, int n, double* out,
+                    ToTA toTA, ToTB toTB, PostA postA, PostB postB)
+{
+    double ta[BLOCK], tb[BLOCK], ra[BLOCK], rb[BLOCK];
+    int ia[BLOCK], ib[BLOCK];
+    for (int base = 0; base < n; base += BLOCK) {
+        int m = std::min(BLOCK, n - base);
+        int na = 0, nb = 0;
+        for (int i = 0; i < m; ++i) {
+            double xi = x[base + i];
+            if (std::abs(xi) <= split) { ia[na] = i; ta[na++] = toTA(xi); }
+            else { ib[nb] = i; tb[nb++] = toTB(xi); }
+        }
+        clenshawBatch(sa, ta, ra, na);
+        clenshawBatch(sb, tb, rb, nb);
+        for (int j = 0; j < na; ++j) { int k = base + ia[j]; out[k] = postA(k, x[k], ra[j]); }
+        for (int j = 0; j < nb; ++j) { int k = base + ib[j]; out[k] = postB(k, x[k], rb[j]); }
+    }
+}
+
+// ---------------- 复数宗量 ----------------
+typedef std::complex<double> cplx;
+
+const double EULER_GAMMA = 0.57721566490153286061;
+
+// 幂级数 (|z| <= 2): 同时给出 I0, I1, K0, K1 (未缩放)
+void seriesSmall(cplx z, cplx& i0, cplx& i1, cplx& k0, cplx& k1)
+{
+    cplx q = 0.25 * z * z;
+    cplx lg = std::log(0.5 * z);
+    // I0 = sum q^k/(k!)^2, K0 = -(lg+gamma) I0 + sum H_k q^k/(k!)^2
+    // I1 = (z/2) sum q^k/(k!(k+1)!), K1 = 1/z + lg*I1 - (z/4) sum (psi(k+1)+psi(k+2)) q^k/(k!(k+1)!)
+    cplx t0 = 1.0, t1 = 1.0;          // q^k/(k!)^2, q^k/(k!(k+1)!)
+    cplx s0 = 1.0, s1 = 1.0, sk0 = 0.0;
+    double H = 0.0;                   // 调和数 H_k
+    cplx sk1 = t1 * (-2.0 * EULER_GAMMA + 1.0); // psi(1)+psi(2)
+    for (int k = 1; k < 60; ++k) {
+        t0 *= q / double(k * k);
+        t1 *= q / double(k * (k + 1));
+        H += 1.0 / k;
+        s0 += t0; s1 += t1;
+        sk0 += H * t0;
+        sk1 += (2.0 * (H - EULER_GAMMA) + 1.0 / (k + 1)) * t1;
+        if (std::abs(t0) < 1e-17 * std::abs(s0) && std::abs(t1) < 1e-17 * std::abs(s1)) break;
+    }
+    i0 = s0;
+    i1 = 0.5 * z * s1;
+    k0 = -(lg + EULER_GAMMA) * i0 + sk0;
+    k1 = 1.0 / z + lg * i1 - 0.25 * z * sk1;
+}
+
+// Temme/Steed CF2 (|z| > 2): 返回 exp(z)*K0(z), exp(z)*K1(z)
+void steedCF2(cplx z, cplx& k0s, cplx& k1s)
+{
+    cplx b = 2.0 * (1.0 + z);
+    cplx d = 1.0 / b;
+    cplx h = d, delh = d;
+    cplx q1 = 0.0, q2 = 1.0;
+    double a1 = 0.25;               // 0.25 - nu^2, nu = 0
+    cplx q = a1, c = a1;
+    double a = -a1;
+    cplx s = 1.0 + q * delh;
+    for (int i = 1; i < 20000; ++i) {
+        a -= 2 * i;
+        c = -a * c / (i + 1.0);
+        cplx qnew = (q1 - b * q2) / a;
+        q1 = q2; q2 = qnew;
+        q += c * qnew;
+        b += 2.0;
+        d = 1.0 / (b + a * d);
+        delh = (b * d - 1.0) * delh;
+        h += delh;
+        cplx dels = q * delh;
+        s += dels;
+        if (std::abs(dels) < 1e-16 * std::abs(s)) break;
+    }
+    h = a1 * h;
+    k0s = std::sqrt(M_PI / (2.0 * z)) / s;
+    k1s = k0s * (z + 0.5 - h) / z;
+}
+
+// CF1 (修正 Lentz): I1(z)/I0(z) = 1/(2/z + 1/(4/z + ...)), 各级分子均为 1
+cplx ratioI1I0(cplx z)
+{
+    const double tiny = 1e-300;
+    cplx f = tiny, C = f, D = 0.0;
+    for (int i = 1; i < 20000; ++i) {
+        cplx bi = 2.0 * i / z;
+        D = bi + D; if (std::abs(D) < tiny) D = tiny;
+        C = bi + 1.0 / C; if (std::abs(C) < tiny) C = tiny;
+        D = 1.0 / D;
+        cplx del = C * D;
+        f *= del;
+        if (std::abs(del - 1.0) < 1e-16) break;
+    }
+    return f;
+}
+
+// 统一入口: 返回 exp(-z)*I0, exp(-z)*I1, K0, K1
+void complexBessel(cplx z, cplx& i0e, cplx& i1e, cplx& k0, cplx& k1)
+{
+    if (std::abs(z) <= 2.0) {
+        cplx i0, i1;
+        seriesSmall(z, i0, i1, k0, k1);
+        cplx e = std::exp(-z);
+        i0e = i0 * e; i1e = i1 * e;
+        return;
+    }
+    cplx k0s, k1s;
+    steedCF2(z, k0s, k1s);
+    cplx r = ratioI1I0(z);
+    // Wronskian: I0*K1 + I1*K0 = 1/z  =>  exp(-z)*I0 = 1 / (z*(k1s + r*k0s))
+    i0e = 1.0 / (z * (k1s + r * k0s));
+    i1e = r * i0e;
+    cplx e = std::exp(-z);
+    k0 = k0s * e; k1 = k1s * e;
+}
+
+} // namespace
+
+namespace BesselKernel {
+
+std::complex<double> k0(std::complex<double> z)
+{
+    cplx a, b, c, d; complexBessel(z, a, b, c, d); return c;
+}
+
+std::complex<double> k1(std::complex<double> z)
+{
+    cplx a, b, c, d; complexBessel(z, a, b, c, d); return d;
+}
+
+std::complex<double> i0e(std::complex<double> z)
+{
+    cplx a, b, c, d; complexBessel(z, a, b, c, d); return a;
+}
+
+std::complex<double> i1e(std::complex<double> z)
+{
+    cplx a, b, c, d; complexBessel(z, a, b, c, d); return b;
+}
+
+
+bool simdEnabled() { return useSimd(); }
+
+double i0e(double x)
+{
+    const Tables& tb = tables();
+    x = std::abs(x);
+    if (x <= 8.0) return clenshaw(tb.i0a, 0.25 * x - 1.0);
+    return clenshaw(tb.i0b, 16.0 / x - 1.0) / std::sqrt(x);
+}
+
+double i1e(double x)
+{
+    const Tables& tb = tables();
+    double ax = std::abs(x);
+    double r = (ax <= 8.0) ? clenshaw(tb.i1a, 0.25 * ax - 1.0) * ax
+                           : clenshaw(tb.i1b, 16.0 / ax - 1.0) / std::sqrt(ax);
+    return x < 0 ? -r : r;
+}
+
+double k0(double x)
+{
+    const Tables& tb = tables();
+    if (x <= 2.0) {
+        double i0 = clenshaw(tb.i0a, 0.25 * x - 1.0) * std::exp(x);
+        return clenshaw(tb.k0a, 0.5 * x * x - 1.0) - std::log(0.5 * x) * i0;
+    }
+    return std::exp(-x) * clenshaw(tb.k0b, 4.0 / x - 1.0) / std::sqrt(x);
+}
+
+double k1(double x)
+{
+    const Tables& tb = tables();
+    if (x <= 2.0) {
+        double i1 = clenshaw(tb.i1a, 0.25 * x - 1.0) * x * std::exp(x);
+        return std::log(0.5 * x) * i1 + clenshaw(tb.k1a, 0.5 * x * x - 1.0) / x;
+    }
+    return std::exp(-x) * clenshaw(tb.k1b, 4.0 / x - 1.0) / std::sqrt(x);
+}
+
+void i0e(const double* x, int n, double* out)
+{
+    const Tables& tb = tables();
+    piecewiseBatch(tb.i0a, tb.i0b, 8.0, x, n, out,
+                   [](double v) { return 0.25 * std::abs(v) - 1.0; },
+                   [](double v) { return 16.0 / std::abs(v) - 1.0; },
+                   [](int, double, double r) { return r; },
+                   [](int, double v, double r) { return r / std::sqrt(std::abs(v)); });
+}
+
+void i1e(const double* x, int n, double* out)
+{
+    const Tables& tb = tables();
+    piecewiseBatch(tb.i1a, tb.i1b, 8.0, x, n, out,
+                   [](double v) { return 0.25 * std::abs(v) - 1.0; },
+                   [](double v) { return 16.0 / std::abs(v) - 1.0; },
+                   [](int, double v, double r) { return r * v; },
+                   [](int, double v, double r) { double s = r / std::sqrt(std::abs(v)); return v < 0 ? -s : s; });
+}
+
+void k0(const double* x, int n, double* out)
+{
+    const Tables& tb = tables();
+    // 小宗量段还需要 I0: 先批量求出 exp(-x)*I0(x) 放入 out, 后处理时使用
+    i0e(x, n, out);
+    piecewiseBatch(tb.k0a, tb.k0b, 2.0, x, n, out,
+                   [](double v) { return 0.5 * v * v - 1.0; },
+                   [](double v) { return 4.0 / v - 1.0; },
+                   [out](int k, double v, double r) { return r - std::log(0.5 * v) * out[k] * std::exp(v); },
+                   [](int, double v, double r) { return std::exp(-v) * r / std::sqrt(v); });
+}
+
+void k1(const double* x, int n, double* out)
+{
+    const Tables& tb = tables();
+    i1e(x, n, out);
+    piecewiseBatch(tb.k1a, tb.k1b, 2.0, x, n, out,
+                   [](double v) { return 0.5 * v * v - 1.0; },
+                   [](double v) { return 4.0 / v - 1.0; },
+                   [out](int k, double v, double r) { return std::log(0.5 * v) * out[k] * std::exp(v) + r / v; },
+                   [](int, double v, double r) { return std::exp(-v) * r / std::sqrt(v); });
+}
+
+} // namespace BesselKernel
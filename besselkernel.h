@@ -0,0 +1,50 @@
+#ifndef BESSELKERNEL_H
+#define BESSELKERNEL_H
+
+#include <complex>
+
+/**
+ * @brief 修正 Bessel 函数 K0/K1 与指数缩放 I0/I1 的快速批量计算
+ *
+ * 采用 Cephes 形式的分段 Chebyshev 展开:
+ *   I0e/I1e: [0,8] 与 (8,inf) 两段, 后者以 sqrt(x) 缩放;
+ *   K0/K1:   (0,2] 段扣除 log(x/2)*I 奇异项, (2,inf) 段以 exp(x)*sqrt(x) 缩放。
+ * 展开系数在首次使用时由 Boost 参考值在 Chebyshev 节点上插值生成 (线程安全的静态初始化),
+ * 相对精度约 1e-14 量级。
+ *
+ * 批量接口对整段数组求值: 在支持 AVX2/FMA 的 x86 CPU 上 (运行期检测) Clenshaw 递推
+ * 以 4 路 SIMD 执行, 其余平台退回标量实现。
+ *
+ * 约定: K0/K1 要求 x > 0; I0e(x) = exp(-|x|)*I0(x), I1e(x) = exp(-|x|)*I1(x)。
+ *
+ * 复数宗量版本 (供 Talbot / de Hoog / Euler 等复平面反演使用, 要求 Re(z) >= 0):
+ *   |z| <= 2 用幂级数; |z| > 2 用 Temme/Steed 连分式 CF2 求 K0/K1, 再由 CF1 比值
+ *   I1/I0 与 Wronskian I0*K1 + I1*K0 = 1/z 求 I0/I1, 避免大宗量级数相消。
+ *   复数版本的 I0e/I1e 定义为 exp(-z)*I(z)。
+ */
+namespace BesselKernel {
+
+// 标量接口
+double k0(double x);
+double k1(double x);
+double i0e(double x);
+double i1e(double x);
+
+// 批量接口: out[i] = f(x[i]), i = 0..n-1
+void k0(const double* x, int n, double* out);
+void k1(const double* x, int n, double* out);
+void i0e(const double* x, int n, double* out);
+void i1e(const double* x, int n, double* out);
+
+// 复数宗量标量接口
+std::complex<double> k0(std::complex<double> z);
+std::complex<double> k1(std::complex<double> z);
+std::complex<double> i0e(std::complex<double> z);
+std::complex<double> i1e(std::complex<double> z);
+
+// 是否在使用 SIMD 路径
+bool simdEnabled();
+
+} // namespace BesselKernel
+
+#endif // BESSELKERNEL_H
@@ -0,0 +1,26 @@
+#ifndef BOURDETDERIVATIVE_H
+#define BOURDETDERIVATIVE_H
+
+#include <QVector>
+
+/**
+ * @brief Bourdet 压力导数 (L-Spacing 平滑, Saphir 风格)
+ *
+ * P' = dP/d(ln t) = t * dP/dt, 由 PressureDerivativeCalculator 中分离出的纯算法部分,
+ * 只依赖 QtCore, 供计算核心库 (CompositeModel) 与界面模块共用。
+ */
+namespace BourdetDerivative {
+
+/**
+ * @param timeData 时间数据 (t)
+ * @param pressureDropData 压降数据 (Delta P)
+ * @param lSpacing L-Spacing参数 (通常0.1-0.5，理论曲线计算时可设为0.0-0.1)
+ * @return 导数数据向量
+ */
+QVector<double> calculate(const QVector<double>& timeData,
+                          const QVector<double>& pressureDropData,
+                          double lSpacing);
+
+} // namespace BourdetDerivative
+
+#endif // BOURDETDERIVATIVE_H
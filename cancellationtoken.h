@@ -0,0 +1,60 @@
+#ifndef CANCELLATIONTOKEN_H
+#define CANCELLATIONTOKEN_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <chrono>
+
+/**
+ * @brief 模型求值的取消标记与可选截止时刻
+ *
+ * 由发起计算的一方持有 (拟合、参数扫描、批处理), 以指针放入 ModelEvaluationOptions,
+ * 反演按时间点、数值积分按子区间检查。取消后未完成的时间点结果为 NaN, 不写入缓存;
+ * 调用方在计算返回后以 isCancelled() 判断结果是否完整。
+ * 全部操作为原子操作, 可在任意线程调用。
+ */
+class CancellationToken
+{
+public:
+    CancellationToken() : m_cancelled(false), m_deadlineNs(0) {}
+
+    void cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+
+    // 清除取消状态与截止时刻 (开始新一轮计算前调用)
+    void reset()
+    {
+        m_cancelled.store(false, std::memory_order_relaxed);
+        m_deadlineNs.store(0, std::memory_order_relaxed);
+    }
+
+    // 截止时刻: 从现在起 ms 毫秒; <= 0 表示不限时
+    void setDeadline(qint64 ms)
+    {
+        m_deadlineNs.store(ms > 0 ? nowNs() + ms * 1000000 : 0, std::memory_order_relaxed);
+    }
+
+    bool hasDeadline() const { return m_deadlineNs.load(std::memory_order_relaxed) != 0; }
+
+    bool deadlineExpired() const
+    {
+        qint64 d = m_deadlineNs.load(std::memory_order_relaxed);
+        return d != 0 && nowNs() >= d;
+    }
+
+    bool isCancelled() const
+    {
+        return m_cancelled.load(std::memory_order_relaxed) || deadlineExpired();
+    }
+
+private:
+    static qint64 nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::atomic<bool> m_cancelled;
+    std::atomic<qint64> m_deadlineNs;
+};
+
+#endif // CANCELLATIONTOKEN_H
@@ -0,0 +1,168 @@
+#include "columnstatistics.h"
+#include "mappedtextfile.h"
+
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 每块的行数; 小于一块的列直接在调用线程中统计
+const int kChunkRows = 65536;
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+struct Chunk {
+    int begin;
+    int end;
+    ColumnStatistics::Summary summary;
+    QVector<double> values;     // 块内的有限数值 (分位数用)
+};
+
+// Welford 单点更新
+void accumulate(ColumnStatistics::Summary& s, double v)
+{
+    ++s.numeric;
+    if (s.numeric == 1) {
+        s.minimum = s.maximum = s.mean = v;
+        s.m2 = 0.0;
+        return;
+    }
+    s.minimum = qMin(s.minimum, v);
+    s.maximum = qMax(s.maximum, v);
+    double delta = v - s.mean;
+    s.mean += delta / s.numeric;
+    s.m2 += delta * (v - s.mean);
+}
+
+} // namespace
+
+namespace ColumnStatistics {
+
+Summary compute(const DataColumn& column, const TextSource& source, int firstRow, int rows)
+{
+    const int size = column.size();
+    firstRow = qBound(0, firstRow, size);
+    const int end = rows < 0 ? size : qMin(size, firstRow + rows);
+
+    // 文本列的 NaN 单元格: 字符串池中每个串是否为空白只判断一次
+    const bool textColumn = column.kind() == DataColumn::Text;
+    QVector<char> blankString;
+    if (textColumn) {
+        const QStringList& strings = column.strings();
+        blankString.resize(strings.size());
+        for (int i = 0; i < strings.size(); ++i) blankString[i] = strings[i].trimmed().isEmpty();
+    }
+    const double* data = column.values().constData();
+    const qint32* ids = textColumn ? column.textIds().constData() : nullptr;
+    const char* blank = blankString.constData();
+    const bool deferred = source.file && source.field >= 0;
+
+    QVector<Chunk> chunks;
+    for (int begin = firstRow; begin < end; begin += kChunkRows) {
+        chunks.append(Chunk{begin, qMin(end, begin + kChunkRows), Summary(), QVector<double>()});
+    }
+    auto scan = [&](Chunk& chunk) {
+        Summary& s = chunk.summary;
+        s.count = chunk.end - chunk.begin;
+        chunk.values.reserve(s.count);
+        for (int row = chunk.begin; row < chunk.end; ++row) {
+            const double v = data[row];
+            if (!std::isnan(v)) {
+                accumulate(s, v);
+                chunk.values.append(v);
+                continue;
+            }
+            bool isBlank = true;
+            if (ids) {
+                isBlank = ids[row] == 0 || blank[ids[row]];
+            } else if (deferred) {
+                isBlank = MappedTextFile::field(source.file->line(source.firstLine + row), source.separator, source.field).isEmpty();
+            }
+            if (isBlank) ++s.empty;
+            else ++s.text;
+        }
+    };
+    if (chunks.size() > 1) {
+        QtConcurrent::blockingMap(chunks, scan);
+    } else {
+        for (Chunk& chunk : chunks) scan(chunk);
+    }
+
+    // 按块序合并, 结果与串行扫描一致
+    Summary total;
+    for (const Chunk& chunk : chunks) total = merge(total, chunk.summary);
+    QVector<double> values;
+    values.reserve(total.numeric);
+    for (Chunk& chunk : chunks) {
+        values += chunk.values;
+        chunk.values = QVector<double>();
+    }
+    total.lowerQuartile = quantile(values, 0.25);
+    total.median = quantile(values, 0.5);
+    total.upperQuartile = quantile(values, 0.75);
+    return total;
+}
+
+Summary merge(const Summary& a, const Summary& b)
+{
+    Summary r;
+    r.count = a.count + b.count;
+    r.numeric = a.numeric + b.numeric;
+    r.text = a.text + b.text;
+    r.empty = a.empty + b.empty;
+    if (r.numeric == 0) return r;
+
+    const Summary& only = a.numeric == 0 ? b : a;
+    if (a.numeric == 0 || b.numeric == 0) {
+        r.minimum = only.minimum;
+        r.maximum = only.maximum;
+        r.mean = only.mean;
+        r.m2 = only.m2;
+        return r;
+    }
+    const double delta = b.mean - a.mean;
+    r.minimum = qMin(a.minimum, b.minimum);
+    r.maximum = qMax(a.maximum, b.maximum);
+    r.mean = a.mean + delta * b.numeric / r.numeric;
+    r.m2 = a.m2 + b.m2 + delta * delta * double(a.numeric) * b.numeric / r.numeric;
+    return r;
+}
+
+Summary subtract(const Summary& total, const Summary& part)
+{
+    Summary r;
+    r.count = total.count - part.count;
+    r.numeric = total.numeric - part.numeric;
+    r.text = total.text - part.text;
+    r.empty = total.empty - part.empty;
+    if (r.numeric <= 0) {
+        r.numeric = 0;
+        return r;
+    }
+    r.minimum = total.minimum;
+    r.maximum = total.maximum;
+    if (part.numeric == 0) {
+        r.mean = total.mean;
+        r.m2 = total.m2;
+        return r;
+    }
+    r.mean = (total.numeric * total.mean - part.numeric * part.mean) / r.numeric;
+    const double delta = part.mean - r.mean;
+    r.m2 = qMax(0.0, total.m2 - part.m2 - delta * delta * double(r.numeric) * part.numeric / total.numeric);
+    return r;
+}
+
+double quantile(QVector<double>& values, double p)
+{
+    const int n = values.size();
+    if (n == 0) return kNaN;
+    const double h = (n - 1) * qBound(0.0, p, 1.0);
+    const int k = int(std::floor(h));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    const double lower = values[k];
+    if (k + 1 >= n || h == k) return lower;
+    const double upper = *std::min_element(values.begin() + k + 1, values.end());
+    return lower + (h - k) * (upper - lower);
+}
+
+} // namespace ColumnStatistics
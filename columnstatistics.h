@@ -0,0 +1,62 @@
+#ifndef COLUMNSTATISTICS_H
+#define COLUMNSTATISTICS_H
+
+#include <QByteArray>
+#include <limits>
+#include "datacolumn.h"
+
+class MappedTextFile;
+
+/**
+ * @brief 数据列的描述统计
+ *
+ * compute() 对一列只扫描一遍: 行按块分给线程池, 每块统计计数、最小 / 最大值与均值、离差平方和
+ * (Welford), 块间按 Chan 公式合并, 与串行结果一致; 同一遍收集有限数值, 之后用 nth_element 取精确分位数。
+ * 计数、最值与矩可以按行段合并 (merge), 计数与矩也可以扣除行段 (subtract, 单元格修改与删行时用);
+ * 分位数需要全部数值, 不能合并。
+ */
+namespace ColumnStatistics {
+
+struct Summary {
+    int count = 0;      // 行数
+    int numeric = 0;    // 有效数值
+    int text = 0;       // 非空的非数值文本
+    int empty = 0;      // 空单元格 (无效)
+    double minimum = std::numeric_limits<double>::quiet_NaN();
+    double maximum = std::numeric_limits<double>::quiet_NaN();
+    double mean = std::numeric_limits<double>::quiet_NaN();
+    double m2 = 0.0;    // 离差平方和
+    double lowerQuartile = std::numeric_limits<double>::quiet_NaN();
+    double median = std::numeric_limits<double>::quiet_NaN();
+    double upperQuartile = std::numeric_limits<double>::quiet_NaN();
+
+    // 数值多于文本时按数值列统计 (与数据编辑器原有的判断一致)
+    bool isNumeric() const { return numeric > text; }
+    // 总体方差
+    double variance() const { return numeric > 0 ? m2 / numeric : std::numeric_limits<double>::quiet_NaN(); }
+};
+
+// 大文件模式下留在映射中的文本列: NaN 单元格按行取源文件字段判断是否为空
+struct TextSource {
+    const MappedTextFile* file = nullptr;
+    int firstLine = 0;
+    QByteArray separator;
+    int field = -1;
+};
+
+// 统计 [firstRow, firstRow + rows) 行; rows < 0 表示到列末尾
+Summary compute(const DataColumn& column, const TextSource& source = TextSource(), int firstRow = 0, int rows = -1);
+
+// 两段行的合并 (计数、最值、矩); 分位数无法合并, 结果中为 NaN
+Summary merge(const Summary& a, const Summary& b);
+
+// 从 total 中扣除其中一段 part 的计数与矩 (Chan 公式反推); 最值保持 total 的值,
+// part 含最值时由调用方判断失效; 分位数为 NaN
+Summary subtract(const Summary& total, const Summary& part);
+
+// 线性插值分位数 (p 为 0 ~ 1), values 会被重排; 空序列为 NaN
+double quantile(QVector<double>& values, double p);
+
+} // namespace ColumnStatistics
+
+#endif // COLUMNSTATISTICS_H
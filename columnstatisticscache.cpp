@@ -0,0 +1,164 @@
+#include "columnstatisticscache.h"
+#include "datatablemodel.h"
+
+#include <limits>
+
+ColumnStatisticsCache::ColumnStatisticsCache(DataTableModel* model, QObject* parent)
+    : QObject(parent),
+      m_model(model),
+      m_pendingRow(-1),
+      m_pendingColumn(-1)
+{
+    connect(m_model, &DataTableModel::cellAboutToChange, this, &ColumnStatisticsCache::onCellAboutToChange);
+    connect(m_model, &DataTableModel::dataChanged, this, &ColumnStatisticsCache::onDataChanged);
+    connect(m_model, &DataTableModel::rowsInserted, this, &ColumnStatisticsCache::onRowsInserted);
+    connect(m_model, &DataTableModel::rowsAboutToBeRemoved, this, &ColumnStatisticsCache::onRowsAboutToBeRemoved);
+    connect(m_model, &DataTableModel::modelReset, this, &ColumnStatisticsCache::invalidate);
+    connect(m_model, &DataTableModel::columnsInserted, this, &ColumnStatisticsCache::invalidate);
+    connect(m_model, &DataTableModel::columnsRemoved, this, &ColumnStatisticsCache::invalidate);
+    connect(m_model, &DataTableModel::columnsMoved, this, &ColumnStatisticsCache::invalidate);
+    connect(m_model, &DataTableModel::layoutChanged, this, &ColumnStatisticsCache::invalidate);
+}
+
+ColumnStatisticsCache::Entry& ColumnStatisticsCache::entry(int column)
+{
+    if (m_entries.size() != m_model->columnCount()) m_entries = QVector<Entry>(m_model->columnCount());
+    return m_entries[column];
+}
+
+ColumnStatistics::Summary ColumnStatisticsCache::summary(int column)
+{
+    if (column < 0 || column >= m_model->columnCount()) return ColumnStatistics::Summary();
+    Entry& e = entry(column);
+    if (!e.valid || !e.rangeValid || !e.quantilesValid) {
+        e.summary = computeColumn(column);
+        e.valid = e.rangeValid = e.quantilesValid = true;
+    }
+    return e.summary;
+}
+
+ColumnStatistics::Summary ColumnStatisticsCache::moments(int column)
+{
+    if (column < 0 || column >= m_model->columnCount()) return ColumnStatistics::Summary();
+    Entry& e = entry(column);
+    if (!e.valid || !e.rangeValid) {
+        e.summary = computeColumn(column);
+        e.valid = e.rangeValid = e.quantilesValid = true;
+    }
+    ColumnStatistics::Summary result = e.summary;
+    if (!e.quantilesValid) {
+        result.lowerQuartile = result.median = result.upperQuartile = std::numeric_limits<double>::quiet_NaN();
+    }
+    return result;
+}
+
+QVector<ColumnStatistics::Summary> ColumnStatisticsCache::summaries()
+{
+    QVector<ColumnStatistics::Summary> result;
+    result.reserve(m_model->columnCount());
+    for (int c = 0; c < m_model->columnCount(); ++c) result.append(summary(c));
+    return result;
+}
+
+bool ColumnStatisticsCache::isValid(int column) const
+{
+    if (column < 0 || column >= m_entries.size()) return false;
+    const Entry& e = m_entries[column];
+    return e.valid && e.rangeValid && e.quantilesValid;
+}
+
+bool ColumnStatisticsCache::hasMoments(int column) const
+{
+    return column >= 0 && column < m_entries.size() && m_entries[column].valid && m_entries[column].rangeValid;
+}
+
+void ColumnStatisticsCache::invalidate()
+{
+    m_entries.clear();
+    m_pendingColumn = -1;
+}
+
+void ColumnStatisticsCache::replace(Entry& entry, const ColumnStatistics::Summary& removed, const ColumnStatistics::Summary& added)
+{
+    ColumnStatistics::Summary& s = entry.summary;
+    const ColumnStatistics::Summary old = s;
+    const ColumnStatistics::Summary rest = ColumnStatistics::subtract(old, removed);
+    // 被扣除的数值达到最值时, 剩余数值的最值未知 (不剩数值时最值只由 added 决定)
+    if (rest.numeric == 0) {
+        entry.rangeValid = true;
+    } else if (removed.numeric > 0 && (removed.minimum <= old.minimum || removed.maximum >= old.maximum)) {
+        entry.rangeValid = false;
+    }
+    if (removed.numeric > 0 || added.numeric > 0) entry.quantilesValid = false;
+
+    s = ColumnStatistics::merge(rest, added);
+    // 不剩数值时分位数为 NaN, 同样无需重新统计
+    if (s.numeric == 0) entry.quantilesValid = true;
+    if (entry.quantilesValid) {
+        s.lowerQuartile = old.lowerQuartile;
+        s.median = old.median;
+        s.upperQuartile = old.upperQuartile;
+    }
+}
+
+void ColumnStatisticsCache::onCellAboutToChange(int row, int column)
+{
+    m_pendingColumn = -1;
+    if (column < 0 || column >= m_entries.size() || !m_entries[column].valid) return;
+    m_pendingRow = row;
+    m_pendingColumn = column;
+    m_pendingOld = computeColumn(column, row, 1);
+}
+
+void ColumnStatisticsCache::onDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QList<int>& roles)
+{
+    const int pendingColumn = m_pendingColumn;
+    m_pendingColumn = -1;
+    // 只改样式的通知不影响统计
+    if (!roles.isEmpty() && !roles.contains(Qt::DisplayRole) && !roles.contains(Qt::EditRole)) return;
+
+    // 单个单元格的写入: 以旧值与新值增量更新
+    const int row = topLeft.row(), column = topLeft.column();
+    if (topLeft == bottomRight && column == pendingColumn && row == m_pendingRow && column < m_entries.size()
+        && m_entries[column].valid) {
+        replace(m_entries[column], m_pendingOld, computeColumn(column, row, 1));
+        return;
+    }
+    for (int c = qMax(0, topLeft.column()); c <= bottomRight.column() && c < m_entries.size(); ++c) {
+        m_entries[c].valid = false;
+    }
+}
+
+void ColumnStatisticsCache::onRowsInserted(const QModelIndex& parent, int first, int last)
+{
+    if (parent.isValid()) return;
+    // 新行均为空单元格: 只增加行数与空单元格数
+    const int added = last - first + 1;
+    for (Entry& entry : m_entries) {
+        entry.summary.count += added;
+        entry.summary.empty += added;
+    }
+}
+
+void ColumnStatisticsCache::onRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last)
+{
+    if (parent.isValid()) return;
+    for (int c = 0; c < m_entries.size(); ++c) {
+        Entry& entry = m_entries[c];
+        if (!entry.valid) continue;
+        replace(entry, computeColumn(c, first, last - first + 1), ColumnStatistics::Summary());
+    }
+}
+
+ColumnStatistics::Summary ColumnStatisticsCache::computeColumn(int column, int firstRow, int rows) const
+{
+    ColumnStatistics::TextSource source;
+    int field = m_model->sourceField(column);
+    if (field >= 0) {
+        source.file = m_model->source().data();
+        source.firstLine = m_model->sourceFirstLine();
+        source.separator = m_model->sourceSeparator();
+        source.field = field;
+    }
+    return ColumnStatistics::compute(m_model->column(column), source, firstRow, rows);
+}
@@ -0,0 +1,66 @@
+#ifndef COLUMNSTATISTICSCACHE_H
+#define COLUMNSTATISTICSCACHE_H
+
+#include <QObject>
+#include <QModelIndex>
+#include <QVector>
+#include "columnstatistics.h"
+
+class DataTableModel;
+
+/**
+ * @brief 数据表各列统计量的缓存
+ *
+ * 监听模型信号维护每列的统计结果, 只在读取时重新扫描失效的部分:
+ * 插入行 (均为空单元格) 直接累加计数; 删除行时统计被删的行并扣除其计数与矩;
+ * 单元格修改 (setText / setValue / setData) 按旧值与新值更新计数与矩。
+ * 最值只在被删 / 被改的数值正好是最值时失效, 分位数在任何数值变化后失效;
+ * moments() 不需要分位数, 只在计数、矩或最值失效时扫描。
+ * 整列替换按列失效, 仅样式变化 (前景 / 背景色) 不影响缓存; 列结构变化或整表重置时全部失效。
+ */
+class ColumnStatisticsCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ColumnStatisticsCache(DataTableModel* model, QObject* parent = nullptr);
+
+    // 某列的统计量, 任一部分失效时重新计算
+    ColumnStatistics::Summary summary(int column);
+    // 计数、最值与矩 (分位数已失效时为 NaN), 只在这些部分失效时重新计算
+    ColumnStatistics::Summary moments(int column);
+    // 全部列
+    QVector<ColumnStatistics::Summary> summaries();
+    // 全部统计量有效 / 计数、最值与矩有效 (读取时不需要扫描)
+    bool isValid(int column) const;
+    bool hasMoments(int column) const;
+    void invalidate();
+
+private slots:
+    void onCellAboutToChange(int row, int column);
+    void onDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QList<int>& roles);
+    void onRowsInserted(const QModelIndex& parent, int first, int last);
+    void onRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last);
+
+private:
+    struct Entry {
+        ColumnStatistics::Summary summary;
+        bool valid = false;             // 计数与矩
+        bool rangeValid = false;        // 最值
+        bool quantilesValid = false;    // 分位数
+    };
+
+    Entry& entry(int column);
+    ColumnStatistics::Summary computeColumn(int column, int firstRow = 0, int rows = -1) const;
+    // 从 entry 中扣除 removed 的行段, 再并入 added (单元格修改时为新值)
+    static void replace(Entry& entry, const ColumnStatistics::Summary& removed, const ColumnStatistics::Summary& added);
+
+    DataTableModel* m_model;
+    QVector<Entry> m_entries;
+    // cellAboutToChange 记下的旧单元格, 在随后的 dataChanged 中使用
+    int m_pendingRow;
+    int m_pendingColumn;
+    ColumnStatistics::Summary m_pendingOld;
+};
+
+#endif // COLUMNSTATISTICSCACHE_H
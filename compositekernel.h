@@ -0,0 +1,309 @@
+#ifndef COMPOSITEKERNEL_H
+#define COMPOSITEKERNEL_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+#include "besselkernel.h"
+#include "gausskronrod.h"
+
+/**
+ * @brief 压裂水平井复合页岩油模型的拉普拉斯空间解 (标量类型泛型版本)
+ *
+ * 对应 MATLAB Composite_shale_oil_reservoir_fitfun.m, 以模板参数 T 表示标量类型,
+ * CompositeModel 的各条求值路径共用这一份实现:
+ *   double               - 实轴求值 (Stehfest; 积分走批量 Bessel 路径);
+ *   std::complex<double> - Talbot / de Hoog / Euler 等复平面反演;
+ *   Dual                 - 前向自动微分 (见 dualnumber.h)。
+ *
+ * 对 T 的要求: 四则运算、sqrt/exp (可经 ADL 查找), 以及下方的
+ * realValue / magnitude / besselK0 / besselK1 / besselI0e / besselI1e 重载。
+ */
+namespace CompositeKernel {
+
+// 外边界类型
+enum Boundary {
+    Infinite = 0,     // 无限大 (mAB = 0)
+    Closed,           // 封闭 (mAB = K1(re)/I1(re))
+    ConstantPressure  // 定压 (mAB = -K0(re)/I0(re))
+};
+
+// 模型参数 (无因次化后)
+template <typename T>
+struct Params {
+    T kf, km, LfD, rmD, reD;
+    T omega1, omega2, lambda1;
+    T cD, S;
+    int nf;
+};
+
+// ---- 标量类型适配 ----
+inline double realValue(double x) { return x; }
+inline double realValue(const std::complex<double>& z) { return z.real(); }
+inline double magnitude(double x) { return std::abs(x); }
+inline double magnitude(const std::complex<double>& z) { return std::abs(z); }
+
+inline double besselK0(double x) { return BesselKernel::k0(x); }
+inline double besselK1(double x) { return BesselKernel::k1(x); }
+inline double besselI0e(double x) { return BesselKernel::i0e(x); }
+inline double besselI1e(double x) { return BesselKernel::i1e(std::abs(x)); }
+inline std::complex<double> besselK0(const std::complex<double>& z) { return BesselKernel::k0(z); }
+inline std::complex<double> besselK1(const std::complex<double>& z) { return BesselKernel::k1(z); }
+inline std::complex<double> besselI0e(const std::complex<double>& z) { return BesselKernel::i0e(z); }
+inline std::complex<double> besselI1e(const std::complex<double>& z) { return BesselKernel::i1e(z); }
+
+// 实部为负时取反 (对实数等价于 abs, 且保留导数/虚部信息)
+template <typename T>
+T signedAbs(const T& x) { return realValue(x) < 0 ? T(-x) : x; }
+
+// 裂缝在 [-0.9, 0.9] 上等间距分布时的间距 (nf = 1 时为 0)
+inline double fractureSpacing(int nf) { return (nf > 1) ? 1.8 / (nf - 1) : 0.0; }
+
+/**
+ * @brief 内外区交界面 Bessel 前置因子 Ac_prefactor = Ac * exp(gama1*rmD)
+ *
+ * MATLAB: Acup   = M12*gama1*K1(g1)*(mAB*I0(g2)+K0(g2)) + gama2*K0(g1)*(mAB*I1(g2)-K1(g2))
+ *         Acdown = M12*gama1*I1(g1)*(...) - gama2*I0(g1)*(...)
+ * 使用缩放 Bessel I 避免数值溢出, 返回 Acup / (Acdown*exp(-gama1*rmD))。
+ */
+template <typename T>
+T prefactor(const T& z, const T& fs1, const T& fs2, const T& M12, const T& rmD, const T& reD, Boundary boundary)
+{
+    using std::sqrt;
+    using std::exp;
+    T gama1 = sqrt(z * fs1);
+    T gama2 = sqrt(z * fs2);
+    T arg_g2_rm = gama2 * rmD;
+    T arg_g1_rm = gama1 * rmD;
+
+    T k0_g2 = besselK0(arg_g2_rm);
+    T k1_g2 = besselK1(arg_g2_rm);
+    T k0_g1 = besselK0(arg_g1_rm);
+    T k1_g1 = besselK1(arg_g1_rm);
+
+    // --- 边界条件因子 mAB * I0(g2*rmD), mAB * I1(g2*rmD) ---
+    T term_mAB_i0 = T(0.0);
+    T term_mAB_i1 = T(0.0);
+    if (boundary != Infinite) {
+        T arg_re = gama2 * reD;
+        T i0_g2_s = besselI0e(arg_g2_rm);
+        T i1_g2_s = besselI1e(arg_g2_rm);
+        // 引入 exp(arg_g2_rm - arg_re) 来处理指数项的缩放
+        T shift = exp(arg_g2_rm - arg_re);
+        if (boundary == Closed) {
+            T i1_re_s = besselI1e(arg_re);
+            if (magnitude(i1_re_s) > 1e-100) {
+                T ratio = besselK1(arg_re) / i1_re_s;
+                term_mAB_i0 = ratio * i0_g2_s * shift;
+                term_mAB_i1 = ratio * i1_g2_s * shift;
+            }
+        } else {
+            T i0_re_s = besselI0e(arg_re);
+            if (magnitude(i0_re_s) > 1e-100) {
+                T ratio = -(besselK0(arg_re) / i0_re_s);
+                term_mAB_i0 = ratio * i0_g2_s * shift;
+                term_mAB_i1 = ratio * i1_g2_s * shift;
+            }
+        }
+    }
+
+    T term1 = term_mAB_i0 + k0_g2; // (mAB*I0 + K0)
+    T term2 = term_mAB_i1 - k1_g2; // (mAB*I1 - K1)
+
+    T Acup = M12 * gama1 * k1_g1 * term1 + gama2 * k0_g1 * term2;
+    T Acdown_scaled = M12 * gama1 * besselI1e(arg_g1_rm) * term1 - gama2 * besselI0e(arg_g1_rm) * term2;
+    if (magnitude(Acdown_scaled) < 1e-100) Acdown_scaled = T(1e-100);
+
+    return Acup / Acdown_scaled;
+}
+
+// 稠密方程组 A*x = b (列主元 Gauss 消去), A 按行存储, 结果写回 b
+template <typename T>
+bool solveDense(std::vector<T>& A, std::vector<T>& b, int n)
+{
+    for (int c = 0; c < n; ++c) {
+        int piv = c;
+        for (int r = c + 1; r < n; ++r)
+            if (magnitude(A[r * n + c]) > magnitude(A[piv * n + c])) piv = r;
+        if (magnitude(A[piv * n + c]) < 1e-300) return false;
+        if (piv != c) {
+            for (int k = 0; k < n; ++k) std::swap(A[c * n + k], A[piv * n + k]);
+            std::swap(b[c], b[piv]);
+        }
+        for (int r = c + 1; r < n; ++r) {
+            T f = A[r * n + c] / A[c * n + c];
+            for (int k = c; k < n; ++k) A[r * n + k] = A[r * n + k] - f * A[c * n + k];
+            b[r] = b[r] - f * b[c];
+        }
+    }
+    for (int r = n - 1; r >= 0; --r) {
+        T s = b[r];
+        for (int k = r + 1; k < n; ++k) s = s - A[r * n + k] * b[k];
+        b[r] = s / A[r * n + r];
+    }
+    return true;
+}
+
+/**
+ * @brief 对称 Toeplitz 方程组 T*x = b 的 Levinson 递推 (Golub & Van Loan, Alg. 4.7.2), O(n^2)
+ *
+ * col 为 T 的第一列; 递推中出现奇异主子式或结果非有限时返回 false, 由调用方退回 solveDense。
+ */
+template <typename T>
+bool solveSymmetricToeplitz(const std::vector<T>& col, const std::vector<T>& b, std::vector<T>& x)
+{
+    const int n = int(col.size());
+    x.assign(n, T(0.0));
+    if (n == 0 || magnitude(col[0]) < 1e-300) return false;
+
+    const T t0 = col[0];
+    std::vector<T> r(n), y(n), tmp(n);
+    for (int k = 1; k < n; ++k) r[k - 1] = col[k] / t0;
+
+    x[0] = b[0] / t0;
+    if (n > 1) {
+        y[0] = -r[0];
+        T beta = T(1.0), alpha = -r[0];
+        for (int k = 1; k < n; ++k) {
+            beta = (T(1.0) - alpha * alpha) * beta;
+            if (magnitude(beta) < 1e-14) return false;
+            T dot = T(0.0);
+            for (int i = 0; i < k; ++i) dot = dot + r[i] * x[k - 1 - i];
+            T mu = (b[k] / t0 - dot) / beta;
+            for (int i = 0; i < k; ++i) tmp[i] = x[i] + mu * y[k - 1 - i];
+            for (int i = 0; i < k; ++i) x[i] = tmp[i];
+            x[k] = mu;
+            if (k < n - 1) {
+                dot = T(0.0);
+                for (int i = 0; i < k; ++i) dot = dot + r[i] * y[k - 1 - i];
+                alpha = (-r[k] - dot) / beta;
+                for (int i = 0; i < k; ++i) tmp[i] = y[i] + alpha * y[k - 1 - i];
+                for (int i = 0; i < k; ++i) y[i] = tmp[i];
+                y[k] = alpha;
+            }
+        }
+    }
+    for (const T& v : x) if (!std::isfinite(magnitude(v))) return false;
+    return true;
+}
+
+/**
+ * @brief 影响矩阵元素 (未除以 2*M12): int_{-1}^{1} [K0 + Ac*I0](gama1*|offset - LfD*u|) du
+ *
+ * Ac*I0(g1*dist) = Ac_prefactor * I0e(g1*dist) * exp(g1*dist - g1*rmD), 避免 I0 溢出。
+ * 实数版本逐子区间批量求值, K0/I0e 走 BesselKernel 批量 (SIMD) 路径; 其余标量类型逐点求值。
+ */
+inline double influenceIntegral(double gama1, double arg_g1_rm, double Ac_prefactor, double LfD, double offset,
+                                QuadratureStats* stats, const CancellationToken* cancel)
+{
+    auto integrand = [&](const double* u, double* fx, int n) {
+        double arg[15], k0v[15], i0v[15];
+        for (int m = 0; m < n; ++m) {
+            double arg_dist = gama1 * std::abs(offset - LfD * u[m]);
+            arg[m] = (arg_dist < 1e-10) ? 1e-10 : arg_dist;
+        }
+        BesselKernel::k0(arg, n, k0v);
+        BesselKernel::i0e(arg, n, i0v);
+        for (int m = 0; m < n; ++m) {
+            double term2 = 0.0;
+            double exponent = arg[m] - arg_g1_rm;
+            if (exponent > -700.0) term2 = Ac_prefactor * i0v[m] * std::exp(exponent);
+            fx[m] = k0v[m] + term2;
+        }
+    };
+    return GaussKronrod::integrateBatch(integrand, -1.0, 1.0, 1e-5 / std::max(LfD, 1e-12), 1e-10, 10, stats, cancel);
+}
+
+template <typename T>
+T influenceIntegral(const T& gama1, const T& arg_g1_rm, const T& Ac_prefactor, const T& LfD, double offset,
+                    QuadratureStats* stats, const CancellationToken* cancel)
+{
+    using std::exp;
+    double minDist = 1e-10 / std::max(magnitude(gama1), 1e-300);
+    auto integrand = [&](double u) -> T {
+        T dist = signedAbs(T(offset) - LfD * u);
+        if (realValue(dist) < minDist) dist = T(minDist);
+        T arg_dist = gama1 * dist;
+        T exponent = arg_dist - arg_g1_rm;
+        T val = besselK0(arg_dist);
+        if (realValue(exponent) > -700.0) val = val + Ac_prefactor * besselI0e(arg_dist) * exp(exponent);
+        return val;
+    };
+    return GaussKronrod::integrate(integrand, -1.0, 1.0, 1e-5 / std::max(realValue(LfD), 1e-12), 1e-10, 10, stats, cancel);
+}
+
+/**
+ * @brief 多裂缝井底压力 (拉普拉斯空间, 不含井储表皮), 前置因子由调用方给出 (实数路径可缓存复用)
+ *
+ * 裂缝在 [-0.9, 0.9] 上等间距分布, 积分区间关于 0 对称, 影响矩阵只依赖 |i-j|, 为对称 Toeplitz:
+ * 只需 nf 个积分 (第一列), 用 Levinson 递推 O(nf^2) 求解, 失稳时退回列主元消去。
+ * 积分变量取 a = LfD*u, u in [-1,1], 使积分限与参数无关: A_ij = col[|i-j|] / (2*M12)。
+ * 流量条件 T*q = p*1, z*sum(q) = 1  =>  p = 1 / (z*sum(u)), T*u = 1。
+ * 取消时返回 NaN。
+ */
+template <typename T>
+T pwdWithPrefactor(const T& z, const T& gama1, const T& Ac_prefactor, const T& M12, const T& LfD, const T& rmD,
+                   int nf, QuadratureStats* stats = nullptr, const CancellationToken* cancel = nullptr)
+{
+    T arg_g1_rm = gama1 * rmD;
+    double step = fractureSpacing(nf);
+
+    std::vector<T> col(nf);
+    for (int k = 0; k < nf; ++k) {
+        col[k] = influenceIntegral(gama1, arg_g1_rm, Ac_prefactor, LfD, k * step, stats, cancel) / (M12 * 2.0);
+        if (cancel && cancel->isCancelled()) return T(std::numeric_limits<double>::quiet_NaN());
+    }
+
+    std::vector<T> ones(nf, T(1.0)), u;
+    if (!solveSymmetricToeplitz(col, ones, u)) {
+        std::vector<T> A(nf * nf);
+        for (int i = 0; i < nf; ++i)
+            for (int j = 0; j < nf; ++j) A[i * nf + j] = col[std::abs(i - j)];
+        u = ones;
+        if (!solveDense(A, u, nf)) return T(0.0);
+    }
+
+    T sumU = T(0.0);
+    for (const T& v : u) sumU = sumU + v;
+    return T(1.0) / (z * sumU);
+}
+
+// 多裂缝井底压力 (拉普拉斯空间, 不含井储表皮), 前置因子按 fs1/fs2 与边界类型计算
+template <typename T>
+T pwd(const T& z, const T& fs1, const T& fs2, const T& M12, const T& LfD, const T& rmD, const T& reD,
+      int nf, Boundary boundary, QuadratureStats* stats = nullptr, const CancellationToken* cancel = nullptr)
+{
+    using std::sqrt;
+    T gama1 = sqrt(z * fs1);
+    T Ac_prefactor = prefactor(z, fs1, fs2, M12, rmD, reD, boundary);
+    return pwdWithPrefactor(z, gama1, Ac_prefactor, M12, LfD, rmD, nf, stats, cancel);
+}
+
+/**
+ * @brief 复合模型拉普拉斯空间解 pf(z)
+ * @param hasStorage 是否考虑井筒储存与表皮 (变井储模型 1, 3, 5)
+ */
+template <typename T>
+T laplace(const T& z, const Params<T>& p, Boundary boundary, bool hasStorage, QuadratureStats* stats = nullptr,
+          const CancellationToken* cancel = nullptr)
+{
+    int nf = p.nf < 1 ? 1 : p.nf;
+    T M12 = p.kf / p.km;
+    T fs1 = p.omega1 + p.lambda1 * p.omega2 / (p.lambda1 + z * p.omega2);
+    T fs2 = M12 * p.omega2;
+
+    T pf = pwd(z, fs1, fs2, M12, p.LfD, p.rmD, p.reD, nf, boundary, stats, cancel);
+
+    // 井筒储存和表皮 (对应 MATLAB: (z*pf+S)/(z+CD*z^2*(z*pf+S)))
+    if (hasStorage && (realValue(p.cD) > 1e-12 || std::abs(realValue(p.S)) > 1e-12)) {
+        T num = z * pf + p.S;
+        pf = num / (z + p.cD * z * z * num);
+    }
+    return pf;
+}
+
+} // namespace CompositeKernel
+
+#endif // COMPOSITEKERNEL_H
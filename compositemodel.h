@@ -0,0 +1,142 @@
+#ifndef COMPOSITEMODEL_H
+#define COMPOSITEMODEL_H
+
+#include <QMap>
+#include <QVector>
+#include <QStringList>
+#include <QMutex>
+#include <tuple>
+#include <functional>
+#include <atomic>
+#include <complex>
+#include "laplacecache.h"
+#include "laplaceinversion.h"
+#include "compositeparameters.h"
+#include "cancellationtoken.h"
+
+class QThreadPool;
+
+// 类型定义: <时间, 压力, 导数>
+using ModelCurveData = std::tuple<QVector<double>, QVector<double>, QVector<double>>;
+
+// 理论曲线及其参数灵敏度 (前向自动微分): dPressure[k][i] = dP(t_i)/dθ_k, dDerivative 同理
+struct ModelSensitivityData {
+    QVector<double> time, pressure, derivative;
+    QVector<QVector<double>> dPressure, dDerivative;
+    bool valid = false; // 当前反演算法或参数个数不支持自动微分时为 false
+};
+
+// 单次求值选项: 按值传入计算函数, 并发调用之间互不影响
+struct ModelEvaluationOptions {
+    bool highPrecision = true;   // 高精度: Stehfest 使用参数 N (否则 N=4), 复平面方法使用完整阶数 (否则减半)
+    bool parallel = true;        // 按时间点并行反演 (结果与串行逐位一致)
+    QThreadPool* pool = nullptr; // 按时间点并行使用的线程池 (由调用方持有), 为空时取全局线程池
+    LaplaceInversionMethod inversionMethod = LaplaceInversionMethod::Stehfest;
+    int inversionOrder = 0;      // <= 0 时取该算法默认阶数
+    // 可选的取消标记 (由调用方持有): 逐时间点与积分子区间检查, 取消后剩余时间点为 NaN
+    const CancellationToken* cancel = nullptr;
+
+    bool cancelled() const { return cancel && cancel->isCancelled(); }
+};
+
+/**
+ * @brief 压裂水平井复合页岩油模型 (Model 1-6) 的计算对象
+ *
+ * 从 ModelWidget01_06 中分离出的纯计算部分, 属于计算核心库 welltest_core, 只依赖 QtCore,
+ * 供界面程序与命令行批处理 (welltest_cli) 共用。模型类型构造后不可变; 计算入口以
+ * CompositeParameters 为参数, QMap 重载只在入口处转换一次。
+ * 线程安全: 计算函数不修改模型状态 (仅访问带锁缓存与原子计数),
+ * 默认求值选项由互斥锁保护, 每次调用取一份快照; 也可直接传入选项,
+ * 因此同一对象可被多个线程同时调用 (如雅可比各列并行求值)。
+ */
+class CompositeModel
+{
+public:
+    enum ModelType {
+        Model_1 = 0, // 无限大 + 变井储
+        Model_2,     // 无限大 + 恒定井储
+        Model_3,     // 封闭边界 + 变井储
+        Model_4,     // 封闭边界 + 恒定井储
+        Model_5,     // 定压边界 + 变井储
+        Model_6      // 定压边界 + 恒定井储
+    };
+
+    explicit CompositeModel(ModelType type);
+
+    ModelType type() const { return m_type; }
+
+    // 默认求值选项 (不显式传入选项的调用使用)
+    void setHighPrecision(bool high);
+    bool highPrecision() const;
+    void setParallelEvaluation(bool enabled);
+    void setInversionMethod(LaplaceInversionMethod method, int order = 0);
+    LaplaceInversionMethod inversionMethod() const;
+    ModelEvaluationOptions evaluationOptions() const;
+    void setEvaluationOptions(const ModelEvaluationOptions& options);
+
+    // 拉普拉斯空间求值缓存控制与命中统计
+    void setEvaluationCacheEnabled(bool enabled);
+    void clearEvaluationCache();
+    LaplaceCacheStats cacheStatistics() const;
+    void resetCacheStatistics();
+
+    // 积分核函数累计求值次数 (随 resetCacheStatistics 清零)
+    quint64 quadratureEvaluations() const;
+
+    // 计算理论曲线
+    ModelCurveData calculateTheoreticalCurve(const CompositeParameters& params, const QVector<double>& providedTime,
+                                             const ModelEvaluationOptions& options) const;
+    ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>()) const;
+    ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime,
+                                             const ModelEvaluationOptions& options) const;
+
+    // 计算理论曲线并同时求出对 paramNames 中各参数的偏导数 (一次求值, 仅支持 Stehfest 反演)
+    ModelSensitivityData calculateTheoreticalCurveSensitivity(const CompositeParameters& params, const QVector<CompositeParameters::Id>& paramIds,
+                                                              const QVector<double>& providedTime, const ModelEvaluationOptions& options) const;
+    ModelSensitivityData calculateTheoreticalCurveSensitivity(const QMap<QString, double>& params, const QStringList& paramNames,
+                                                              const QVector<double>& providedTime = QVector<double>()) const;
+    ModelSensitivityData calculateTheoreticalCurveSensitivity(const QMap<QString, double>& params, const QStringList& paramNames,
+                                                              const QVector<double>& providedTime, const ModelEvaluationOptions& options) const;
+
+    // 模型使用的参数 (界面显示顺序); 未列出的参数取 CompositeParameters 默认值
+    static QVector<CompositeParameters::Id> parameterSchema(ModelType type);
+
+    // 生成对数等间距时间步长
+    static QVector<double> logTimeSteps(int count, double startExp, double endExp);
+
+private:
+    // 数学计算核心 (数值反演循环, 复平面方法使用 complexFunc)
+    void calculatePDandDeriv(const QVector<double>& tD, const CompositeParameters& params,
+                             std::function<double(double, const CompositeParameters&)> laplaceFunc,
+                             std::function<std::complex<double>(std::complex<double>, const CompositeParameters&)> complexFunc,
+                             const ModelEvaluationOptions& options,
+                             QVector<double>& outPD, QVector<double>& outDeriv) const;
+
+    // 拉普拉斯空间解 (复合模型通用入口); 取消时返回 NaN 且不写入缓存
+    double flaplace_composite(double z, const CompositeParameters& p, const CancellationToken* cancel = nullptr) const;
+
+    // 复数 z 版本 (Talbot / de Hoog / Euler 反演使用, 基于 CompositeKernel 泛型实现)
+    std::complex<double> flaplace_composite_complex(std::complex<double> z, const CompositeParameters& p, const CancellationToken* cancel = nullptr) const;
+
+    // PWD 核心计算 (包含边界条件处理 Logic from MATLAB PWD_inf), 前置因子经缓存后交给 CompositeKernel
+    double PWD_composite(double z, double fs1, double fs2, double M12, double LfD, double rmD, double reD, int nf, ModelType type,
+                         const CancellationToken* cancel = nullptr) const;
+
+    // 内外区交界面 Bessel 前置因子 (Acup/Acdown, 含边界项 mAB)
+    static double compositePrefactor(double z, double fs1, double fs2, double M12, double rmD, double reD, ModelType type);
+
+private:
+    const ModelType m_type;
+
+    mutable QMutex m_optionsMutex;
+    ModelEvaluationOptions m_options;
+
+    // pf(z) 缓存与 Bessel 前置因子 (Ac) 缓存 (内部加锁, 计算函数为 const)
+    std::atomic<bool> m_cacheEnabled;
+    mutable LaplaceCache<double> m_pfCache;
+    mutable LaplaceCache<double> m_prefactorCache;
+    mutable LaplaceCache<std::complex<double>> m_pfComplexCache;
+    mutable std::atomic<quint64> m_quadEvaluations;
+};
+
+#endif // COMPOSITEMODEL_H
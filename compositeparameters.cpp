@@ -0,0 +1,88 @@
+#include "compositeparameters.h"
+
+namespace {
+
+// 键名, 按 CompositeParameters::Id 顺序
+const char* const kKeys[CompositeParameters::Count] = {
+    "phi", "h", "mu", "B", "Ct", "q",
+    "kf", "km", "L", "Lf", "LfD", "rmD", "reD",
+    "omega1", "omega2", "lambda1", "gamaD", "cD", "S",
+    "nf", "N"
+};
+
+} // namespace
+
+CompositeParameters::CompositeParameters()
+{
+    values.fill(0.0);
+    values[Phi] = 0.05;
+    values[H] = 20.0;
+    values[Mu] = 0.5;
+    values[B] = 1.05;
+    values[Ct] = 5e-4;
+    values[Q] = 5.0;
+    values[Kf] = 1e-3;
+    values[L] = 1000.0;
+    values[Nf] = 4;
+    values[N] = 4;
+}
+
+CompositeParameters::Id CompositeParameters::idOf(const QString& key)
+{
+    for (int i = 0; i < Count; ++i) {
+        if (key == QLatin1String(kKeys[i])) return (Id)i;
+    }
+    return Invalid;
+}
+
+QString CompositeParameters::keyOf(Id id)
+{
+    return (id >= 0 && id < Count) ? QString::fromLatin1(kKeys[id]) : QString();
+}
+
+QVector<CompositeParameters::Id> CompositeParameters::idsOf(const QStringList& keys)
+{
+    QVector<Id> ids;
+    ids.reserve(keys.size());
+    for (const QString& k : keys) ids.append(idOf(k));
+    return ids;
+}
+
+double CompositeParameters::value(const QString& key, double defaultValue) const
+{
+    Id id = idOf(key);
+    return (id == Invalid) ? defaultValue : values[id];
+}
+
+bool CompositeParameters::setValue(const QString& key, double v)
+{
+    Id id = idOf(key);
+    if (id == Invalid) return false;
+    values[id] = v;
+    return true;
+}
+
+const QStringList& CompositeParameters::keys()
+{
+    static const QStringList list = [] {
+        QStringList l;
+        for (int i = 0; i < Count; ++i) l << QString::fromLatin1(kKeys[i]);
+        return l;
+    }();
+    return list;
+}
+
+CompositeParameters CompositeParameters::fromMap(const QMap<QString, double>& map)
+{
+    CompositeParameters p;
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it) p.setValue(it.key(), it.value());
+    if (!map.contains("LfD")) p.syncDerived();
+    return p;
+}
+
+QMap<QString, double> CompositeParameters::toMap() const
+{
+    QMap<QString, double> map;
+    for (int i = 0; i < Count; ++i) map.insert(QString::fromLatin1(kKeys[i]), values[i]);
+    return map;
+}
@@ -0,0 +1,79 @@
+#ifndef COMPOSITEPARAMETERS_H
+#define COMPOSITEPARAMETERS_H
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <array>
+#include <algorithm>
+
+/**
+ * @brief 复合模型 (Model 1-6) 的参数组
+ *
+ * 以枚举为下标的定长数组, 取代计算与拟合路径上的 QMap<QString, double>:
+ * 键名在计算 / 拟合开始时解析一次 (idOf), 之后按下标访问, 复制也只是一块定长内存。
+ * QMap / JSON 形式只保留在界面与存档边界, 由 fromMap / toMap 转换;
+ * 键名与 ModelManager::getDefaultParameters 一致。各模型实际使用的参数见
+ * CompositeModel::parameterSchema。
+ */
+struct CompositeParameters
+{
+    enum Id {
+        Phi = 0,   // 孔隙度
+        H,         // 有效厚度 m
+        Mu,        // 粘度 mPa·s
+        B,         // 体积系数
+        Ct,        // 综合压缩系数 1/MPa
+        Q,         // 产量 m3/d
+        Kf,        // 内区渗透率
+        Km,        // 外区渗透率
+        L,         // 水平井长度
+        Lf,        // 裂缝半长
+        LfD,       // 无因次裂缝半长 Lf/L (由 syncDerived 维护)
+        RmD,       // 无因次复合半径
+        ReD,       // 无因次外边界半径 (0 表示无限大)
+        Omega1,
+        Omega2,
+        Lambda1,
+        GamaD,     // 压敏系数
+        CD,        // 井储系数 (变井储模型)
+        S,         // 表皮系数
+        Nf,        // 裂缝条数 (取整, >= 1)
+        N,         // Stehfest 节点数 (取整)
+        Count,
+        Invalid = -1
+    };
+
+    CompositeParameters();
+
+    double operator[](Id id) const { return values[id]; }
+    double& operator[](Id id) { return values[id]; }
+
+    // 整数参数
+    int fractureCount() const { return std::max(1, (int)values[Nf]); }
+    int stehfestN() const { return (int)values[N]; }
+
+    // LfD = Lf / L (修改 L 或 Lf 后调用)
+    void syncDerived() { if (values[L] > 1e-9) values[LfD] = values[Lf] / values[L]; }
+
+    // 键名解析: 未知键名返回 Invalid
+    static Id idOf(const QString& key);
+    static QString keyOf(Id id);
+    static QVector<Id> idsOf(const QStringList& keys);
+
+    // 按键名读写 (未知键名: value 返回 defaultValue, setValue 返回 false), 仅用于界面边界
+    double value(const QString& key, double defaultValue = 0.0) const;
+    bool setValue(const QString& key, double v);
+
+    // 全部键名 (按 Id 顺序)
+    static const QStringList& keys();
+
+    // QMap 转换: 缺失的键保持默认值; 未给出 LfD 时由 Lf/L 推出
+    static CompositeParameters fromMap(const QMap<QString, double>& map);
+    QMap<QString, double> toMap() const;
+
+    std::array<double, Count> values;
+};
+
+#endif // COMPOSITEPARAMETERS_H
@@ -0,0 +1,224 @@
+#include "csvparser.h"
+
+#include <QAtomicInt>
+#include <QFile>
+#include <QHash>
+#include <QThread>
+#include <QtConcurrent>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// 每块至少的行数; 块数取线程数的若干倍, 行长不均时各线程负载仍接近
+const int kMinChunkLines = 16384;
+const int kChunksPerThread = 4;
+
+bool isSpace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\f' || ch == '\v';
+}
+
+// 逐字段扫描一行, 规则同 MappedTextFile::splitLine (引号内的分隔符不拆分);
+// 对前 maxFields 个字段调用 f(序号, 起点, 终点, 是否含引号)
+template <typename F>
+void forEachField(const char* p, const char* end, const QByteArray& separator, int maxFields, F&& f)
+{
+    const int sepLen = separator.size();
+    const char first = sepLen > 0 ? separator.at(0) : '\0';
+    const char* start = p;
+    bool inQuotes = false;
+    bool quoted = false;
+    int index = 0;
+
+    for (const char* q = p;; ++q) {
+        const bool atEnd = q == end;
+        if (!atEnd) {
+            const char ch = *q;
+            if (ch == '"') {
+                inQuotes = !inQuotes;
+                quoted = true;
+                continue;
+            }
+            if (inQuotes || sepLen == 0 || ch != first) continue;
+            if (sepLen > 1 && (end - q < sepLen || std::memcmp(q, separator.constData(), size_t(sepLen)) != 0)) continue;
+        }
+        f(index, start, q, quoted);
+        if (atEnd || ++index >= maxFields) break;
+        q += sepLen - 1;
+        start = q + 1;
+        quoted = false;
+    }
+}
+
+// 字段的数值; 被一对引号包住的数值照常解析, 其余含引号的字段按文本处理
+double parseField(const char* begin, const char* end, bool quoted, bool* ok)
+{
+    if (quoted) {
+        while (begin < end && isSpace(*begin)) ++begin;
+        while (end > begin && isSpace(end[-1])) --end;
+        if (end - begin >= 2 && *begin == '"' && end[-1] == '"') {
+            ++begin;
+            --end;
+        }
+        if (std::memchr(begin, '"', size_t(end - begin))) {
+            *ok = false;
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+    return DataColumn::parse(begin, end, ok);
+}
+
+// 采样中的完整行 (丢弃可能被截断的最后一行与空行)
+QList<QByteArray> sampleLines(const QByteArray& sample)
+{
+    QList<QByteArray> lines = sample.split('\n');
+    if (lines.size() > 1 && !sample.endsWith('\n')) lines.removeLast();
+    QList<QByteArray> result;
+    for (const QByteArray& line : lines) {
+        if (!line.trimmed().isEmpty()) result.append(line);
+    }
+    return result;
+}
+
+// 引号外 separator 出现的次数
+int countSeparator(const QByteArray& line, const QByteArray& separator)
+{
+    int count = 0;
+    forEachField(line.constData(), line.constData() + line.size(), separator, std::numeric_limits<int>::max(),
+                 [&count](int index, const char*, const char*, bool) { count = index; });
+    return count;
+}
+
+} // namespace
+
+CsvParser::CsvParser(QObject* parent)
+    : QObject(parent)
+{
+}
+
+CsvParser::Result CsvParser::parse(const MappedTextFile& file, int firstLine, int columnCount, const QByteArray& separator)
+{
+    Result result;
+    result.rowCount = qMax(0, file.lineCount() - firstLine);
+    result.textFields = QVector<int>(qMax(0, columnCount), -1);
+    if (columnCount <= 0) return result;
+    const int rows = result.rowCount;
+
+    // 各列预先分配整列, 各块只写自己的行段, 不需要合并拷贝
+    QVector<QVector<double>> values(columnCount);
+    QVector<double*> out(columnCount);
+    for (int c = 0; c < columnCount; ++c) {
+        values[c] = QVector<double>(rows, std::numeric_limits<double>::quiet_NaN());
+        out[c] = values[c].data();
+    }
+
+    struct Chunk {
+        int begin;
+        int end;
+        QVector<char> nonNumeric;   // 该块中各列是否出现非数值文本
+    };
+    const int threads = qMax(1, QThread::idealThreadCount());
+    const int chunkLines = qMax(kMinChunkLines, rows / (threads * kChunksPerThread) + 1);
+    QVector<Chunk> chunks;
+    for (int begin = 0; begin < rows; begin += chunkLines) {
+        chunks.append(Chunk{begin, qMin(rows, begin + chunkLines), QVector<char>()});
+    }
+
+    double* const* columnData = out.constData();
+    QAtomicInt parsedRows(0);
+    QtConcurrent::blockingMap(chunks, [&](Chunk& chunk) {
+        chunk.nonNumeric = QVector<char>(columnCount, 0);
+        char* nonNumeric = chunk.nonNumeric.data();
+        for (int row = chunk.begin; row < chunk.end; ++row) {
+            const QByteArray line = file.line(firstLine + row);
+            forEachField(line.constData(), line.constData() + line.size(), separator, columnCount,
+                         [&](int col, const char* begin, const char* end, bool quoted) {
+                bool ok = false;
+                double v = parseField(begin, end, quoted, &ok);
+                if (!ok) nonNumeric[col] = 1;
+                else if (!std::isnan(v)) columnData[col][row] = v;
+            });
+        }
+        const int done = parsedRows.fetchAndAddRelaxed(chunk.end - chunk.begin) + (chunk.end - chunk.begin);
+        emit progress(int(qint64(done) * 100 / rows), QString("已解析 %1/%2 行").arg(done).arg(rows));
+    });
+
+    for (const Chunk& chunk : chunks) {
+        for (int c = 0; c < columnCount; ++c) {
+            if (chunk.nonNumeric[c]) result.textFields[c] = c;
+        }
+    }
+    result.columns.reserve(columnCount);
+    for (int c = 0; c < columnCount; ++c) {
+        result.columns.append(DataColumn(values[c]));
+        values[c] = QVector<double>();
+    }
+    return result;
+}
+
+QByteArray CsvParser::readSample(const QString& filePath, int bytes)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+    QByteArray sample = file.read(bytes);
+    if (sample.startsWith("\xEF\xBB\xBF")) sample.remove(0, 3);
+    return sample;
+}
+
+QString CsvParser::detectEncoding(const QByteArray& sample)
+{
+    const uchar* p = reinterpret_cast<const uchar*>(sample.constData());
+    const uchar* end = p + sample.size();
+    while (p < end) {
+        const uchar ch = *p;
+        if (ch == 0) return "UTF-8";    // 可能包含二进制数据
+        int follow = 0;
+        if (ch < 0x80) follow = 0;
+        else if (ch >= 0xC2 && ch <= 0xDF) follow = 1;
+        else if (ch >= 0xE0 && ch <= 0xEF) follow = 2;
+        else if (ch >= 0xF0 && ch <= 0xF4) follow = 3;
+        else return "GBK";
+        if (end - p <= follow) break;   // 采样末尾截断的字符
+        for (int i = 1; i <= follow; ++i) {
+            if ((p[i] & 0xC0) != 0x80) return "GBK";
+        }
+        p += follow + 1;
+    }
+    return "UTF-8";
+}
+
+QString CsvParser::detectSeparator(const QByteArray& sample, const QStringList& candidates)
+{
+    const QList<QByteArray> lines = sampleLines(sample).mid(0, 20);
+    QString best = candidates.isEmpty() ? QString(",") : candidates.first();
+    int bestLines = 0;
+    int bestCount = 0;
+
+    for (const QString& candidate : candidates) {
+        const QByteArray separator = candidate.toUtf8();
+        // 各行次数的众数及其行数: 说明行、表头与数据行的次数可能不同, 取多数行一致的次数
+        QHash<int, int> frequency;
+        for (const QByteArray& line : lines) {
+            int count = countSeparator(line, separator);
+            if (count > 0) ++frequency[count];
+        }
+        for (auto it = frequency.constBegin(); it != frequency.constEnd(); ++it) {
+            if (it.value() > bestLines || (it.value() == bestLines && it.key() > bestCount)) {
+                bestLines = it.value();
+                bestCount = it.key();
+                best = candidate;
+            }
+        }
+    }
+    return best;
+}
+
+CsvParser::Sniff CsvParser::sniff(const QByteArray& sample, const QStringList& separators)
+{
+    Sniff s;
+    s.encoding = detectEncoding(sample);
+    s.separator = detectSeparator(sample, separators);
+    return s;
+}
@@ -0,0 +1,56 @@
+#ifndef CSVPARSER_H
+#define CSVPARSER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "datacolumn.h"
+#include "mappedtextfile.h"
+
+/**
+ * @brief CSV / TXT 数据行的多线程解析
+ *
+ * parse() 把 MappedTextFile 的数据行按行号切成若干块 (行索引保证块边界落在行首),
+ * 各块在线程池中并行解析, 数值直接从 UTF-8 字节转换 (DataColumn::parse, 不经 QString 与区域设置),
+ * 结果写入预先分配的列中各块对应的行段, 合并后与串行解析的行序完全一致。
+ * 每块结束时由工作线程发出 progress 信号, 界面线程以排队连接接收, 解析循环内不调用 processEvents。
+ *
+ * 编码与分隔符检测 (sniff) 只看文件开头的一段采样, 一次读取同时得到两者。
+ */
+class CsvParser : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Result {
+        QVector<DataColumn> columns;    // 可解析的数值; 空单元格与非数值文本为 NaN
+        QVector<int> textFields;        // 含非数值文本的列为其字段序号, 其余为 -1
+        int rowCount = 0;
+    };
+
+    struct Sniff {
+        QString encoding;               // "UTF-8" 或 "GBK"
+        QString separator;
+    };
+
+    explicit CsvParser(QObject* parent = nullptr);
+
+    // 解析 file 第 firstLine 行起的全部数据行, 每行取前 columnCount 个字段; 可在任意线程调用
+    Result parse(const MappedTextFile& file, int firstLine, int columnCount, const QByteArray& separator);
+
+    // 文件开头 bytes 字节 (检测用采样)
+    static QByteArray readSample(const QString& filePath, int bytes = 64 * 1024);
+    // 采样不是合法 UTF-8 时判为 GBK (末尾被截断的多字节字符不计)
+    static QString detectEncoding(const QByteArray& sample);
+    // 在候选中选各行出现次数最一致的分隔符, 次数相同的行数相同时取次数多者; 引号内的不计
+    static QString detectSeparator(const QByteArray& sample, const QStringList& candidates);
+    static Sniff sniff(const QByteArray& sample, const QStringList& separators);
+
+signals:
+    // percent 为 0 ~ 100, 由工作线程发出
+    void progress(int percent, const QString& message);
+};
+
+#endif // CSVPARSER_H
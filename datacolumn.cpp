@@ -0,0 +1,198 @@
+#include "datacolumn.h"
+
+#include <QLocale>
+#include <cmath>
+#include <limits>
+#include <charconv>
+
+namespace {
+
+const double kEmpty = std::numeric_limits<double>::quiet_NaN();
+
+} // namespace
+
+DataColumn::DataColumn(int rows)
+    : m_kind(Numeric),
+      m_values(qMax(0, rows), kEmpty)
+{
+}
+
+DataColumn::DataColumn(const QVector<double>& values)
+    : m_kind(Numeric),
+      m_values(values)
+{
+}
+
+double DataColumn::parse(const QString& text, bool* ok)
+{
+    QString s = text.trimmed();
+    if (s.isEmpty()) {
+        if (ok) *ok = true;
+        return kEmpty;
+    }
+    bool parsed = false;
+    double v = s.toDouble(&parsed);
+    parsed = parsed && std::isfinite(v);
+    if (ok) *ok = parsed;
+    return parsed ? v : kEmpty;
+}
+
+double DataColumn::parse(const QByteArray& text, bool* ok)
+{
+    return parse(text.constData(), text.constData() + text.size(), ok);
+}
+
+double DataColumn::parse(const char* begin, const char* end, bool* ok)
+{
+    auto isSpace = [](char ch) { return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n' || ch == '\f' || ch == '\v'; };
+    while (begin < end && isSpace(*begin)) ++begin;
+    while (end > begin && isSpace(end[-1])) --end;
+    if (begin == end) {
+        if (ok) *ok = true;
+        return kEmpty;
+    }
+
+    bool parsed = false;
+    double v = kEmpty;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    // from_chars 不接受前导 '+', 也不跳过空白; 要求整个字段都被消耗
+    const char* p = begin;
+    if (*p == '+') {
+        ++p;
+        if (p == end || *p == '-' || *p == '+') p = nullptr;
+    }
+    if (p) {
+        std::from_chars_result r = std::from_chars(p, end, v);
+        parsed = r.ec == std::errc() && r.ptr == end;
+    }
+#else
+    v = QByteArray::fromRawData(begin, int(end - begin)).toDouble(&parsed);
+#endif
+    parsed = parsed && std::isfinite(v);
+    if (ok) *ok = parsed;
+    return parsed ? v : kEmpty;
+}
+
+QString DataColumn::format(double value, int precision)
+{
+    if (std::isnan(value)) return QString();
+    if (precision >= 0) return QString::number(value, 'f', precision);
+    // 最短的精确表示; 常见量级用定点 (1000000 而不是 1e+06), 极大或极小的值才用科学计数
+    const double magnitude = std::abs(value);
+    if (magnitude == 0.0 || (magnitude >= 1e-4 && magnitude < 1e15))
+        return QString::number(value, 'f', QLocale::FloatingPointShortest);
+    return QString::number(value, 'g', QLocale::FloatingPointShortest);
+}
+
+QString DataColumn::text(int row, int precision) const
+{
+    if (m_kind == Text) {
+        qint32 id = m_textIds[row];
+        // 写入数值的单元格没有原文, 按数值格式化
+        if (id == 0 && !std::isnan(m_values[row])) return format(m_values[row], precision);
+        return m_strings[id];
+    }
+    return format(m_values[row], precision);
+}
+
+bool DataColumn::isEmpty(int row) const
+{
+    if (m_kind == Text && m_textIds[row] != 0) return m_strings[m_textIds[row]].trimmed().isEmpty();
+    return std::isnan(m_values[row]);
+}
+
+void DataColumn::setValue(int row, double value)
+{
+    m_values[row] = value;
+    if (m_kind == Text) m_textIds[row] = 0;
+}
+
+void DataColumn::setText(int row, const QString& text)
+{
+    bool ok = false;
+    double v = parse(text, &ok);
+    if (ok && m_kind == Numeric) { m_values[row] = v; return; }
+    if (m_kind == Numeric) convertToText();
+    m_values[row] = v;
+    m_textIds[row] = intern(text);
+}
+
+void DataColumn::appendValue(double value)
+{
+    m_values.append(value);
+    if (m_kind == Text) m_textIds.append(0);
+}
+
+void DataColumn::appendText(const QString& text)
+{
+    appendValue(kEmpty);
+    setText(m_values.size() - 1, text);
+}
+
+void DataColumn::insert(int row, int count)
+{
+    if (count <= 0) return;
+    m_values.insert(row, count, kEmpty);
+    if (m_kind == Text) m_textIds.insert(row, count, 0);
+}
+
+void DataColumn::remove(int row, int count)
+{
+    if (count <= 0) return;
+    m_values.remove(row, count);
+    if (m_kind == Text) m_textIds.remove(row, count);
+}
+
+void DataColumn::resize(int rows)
+{
+    int old = m_values.size();
+    m_values.resize(rows);
+    for (int i = old; i < rows; ++i) m_values[i] = kEmpty;
+    if (m_kind == Text) m_textIds.resize(rows);
+}
+
+void DataColumn::reserve(int rows)
+{
+    m_values.reserve(rows);
+    if (m_kind == Text) m_textIds.reserve(rows);
+}
+
+qint64 DataColumn::memoryUsage() const
+{
+    qint64 bytes = qint64(m_values.capacity()) * sizeof(double) + qint64(m_textIds.capacity()) * sizeof(qint32);
+    for (const QString& s : m_strings) bytes += sizeof(QString) + qint64(s.capacity()) * sizeof(QChar);
+    return bytes;
+}
+
+DataColumn DataColumn::fromText(const QVector<double>& values, const QStringList& strings, const QVector<qint32>& textIds)
+{
+    DataColumn column(values);
+    if (textIds.size() != values.size() || strings.isEmpty()) return column;
+    column.m_kind = Text;
+    column.m_strings = strings;
+    column.m_textIds = textIds;
+    column.m_stringIndex.reserve(strings.size());
+    for (int i = 0; i < strings.size(); ++i) column.m_stringIndex.insert(strings[i], i);
+    return column;
+}
+
+void DataColumn::convertToText()
+{
+    // 已有的数值单元格保留数值, 文本为空 (读取时格式化)
+    m_kind = Text;
+    m_strings = QStringList{QString()};
+    m_stringIndex.clear();
+    m_stringIndex.insert(QString(), 0);
+    m_textIds = QVector<qint32>(m_values.size(), 0);
+    m_textIds.reserve(m_values.capacity());
+}
+
+qint32 DataColumn::intern(const QString& text)
+{
+    auto it = m_stringIndex.constFind(text);
+    if (it != m_stringIndex.constEnd()) return it.value();
+    qint32 id = m_strings.size();
+    m_strings.append(text);
+    m_stringIndex.insert(text, id);
+    return id;
+}
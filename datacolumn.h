@@ -0,0 +1,74 @@
+#ifndef DATACOLUMN_H
+#define DATACOLUMN_H
+
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+
+/**
+ * @brief 数据表的一列: 连续存放的 double 数组, 文本单元格使用字符串池
+ *
+ * 数值列每个单元格只占一个 double, 空单元格为 NaN, 显示文本在读取时格式化。
+ * 写入无法解析为数值的非空文本时整列转为文本列: 每个单元格另存字符串池下标 (相同文本只存一份),
+ * 可解析的单元格仍保留数值, 因此 value() 对两种列都不需要再解析文本。
+ * values() 与列等长, 隐式共享, 供导数、统计、拟合等按列计算时零拷贝读取。
+ */
+class DataColumn
+{
+public:
+    enum Kind { Numeric = 0, Text };
+
+    explicit DataColumn(int rows = 0);
+    explicit DataColumn(const QVector<double>& values);
+
+    Kind kind() const { return m_kind; }
+    bool isNumeric() const { return m_kind == Numeric; }
+    int size() const { return m_values.size(); }
+
+    // 数值 (空单元格或非数值文本为 NaN)
+    double value(int row) const { return m_values[row]; }
+    const QVector<double>& values() const { return m_values; }
+    // 显示文本; 数值单元格按 precision 位小数格式化, < 0 时取最短的精确表示
+    // (绝对值在 [1e-4, 1e15) 内为定点, 其余为科学计数)
+    QString text(int row, int precision = -1) const;
+    bool isEmpty(int row) const;
+
+    void setValue(int row, double value);
+    void setText(int row, const QString& text);
+    void appendValue(double value);
+    void appendText(const QString& text);
+
+    void insert(int row, int count);
+    void remove(int row, int count);
+    void resize(int rows);
+    void reserve(int rows);
+
+    // 占用的内存 (字节, 近似)
+    qint64 memoryUsage() const;
+
+    // 文本列的字符串池与各行下标 (序列化用, 数值列为空); fromText 按同样的内容重建文本列
+    const QStringList& strings() const { return m_strings; }
+    const QVector<qint32>& textIds() const { return m_textIds; }
+    static DataColumn fromText(const QVector<double>& values, const QStringList& strings, const QVector<qint32>& textIds);
+
+    // 单元格文本解析: 空白为 NaN 且 ok 为 true; 无法解析或非有限值时 ok 为 false
+    static double parse(const QString& text, bool* ok);
+    // 字节形式的字段 (映射文件), 规则同上, 不经 QString 解码
+    static double parse(const QByteArray& text, bool* ok);
+    // [begin, end) 字节区间; 按 C 区域设置解析 (小数点为 '.'), 有 std::from_chars 时直接使用
+    static double parse(const char* begin, const char* end, bool* ok);
+    static QString format(double value, int precision = -1);
+
+private:
+    void convertToText();
+    qint32 intern(const QString& text);
+
+    Kind m_kind;
+    QVector<double> m_values;
+    QVector<qint32> m_textIds;   // 仅文本列: 字符串池下标, 0 为空串
+    QStringList m_strings;
+    QHash<QString, qint32> m_stringIndex;
+};
+
+#endif // DATACOLUMN_H
@@ -0,0 +1,58 @@
+#include "datadecimation.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace DataDecimation {
+
+QVector<int> logUniformIndices(const QVector<double>& t, int pointsPerDecade)
+{
+    QVector<int> out;
+    if (t.isEmpty() || pointsPerDecade <= 0) return out;
+
+    int first = -1, last = -1;
+    double logMin = 0.0, logMax = 0.0;
+    for (int i = 0; i < t.size(); ++i) {
+        if (t[i] <= 0) continue;
+        double lt = std::log10(t[i]);
+        if (first < 0) { first = i; logMin = logMax = lt; }
+        logMin = std::min(logMin, lt);
+        logMax = std::max(logMax, lt);
+        last = i;
+    }
+    if (first < 0) return out;
+
+    // 每箱记录离箱中心最近的样本
+    int nBins = (int)std::floor((logMax - logMin) * pointsPerDecade) + 1;
+    QVector<int> best(nBins, -1);
+    QVector<double> bestDist(nBins, 0.0);
+    for (int i = 0; i < t.size(); ++i) {
+        if (t[i] <= 0) continue;
+        double pos = (std::log10(t[i]) - logMin) * pointsPerDecade;
+        int bin = std::min(nBins - 1, (int)std::floor(pos));
+        double dist = std::abs(pos - (bin + 0.5));
+        if (best[bin] < 0 || dist < bestDist[bin]) { best[bin] = i; bestDist[bin] = dist; }
+    }
+
+    out.reserve(nBins + 2);
+    for (int i : best) {
+        if (i >= 0) out.append(i);
+    }
+    out.append(first);
+    out.append(last);
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+QVector<double> take(const QVector<double>& v, const QVector<int>& indices)
+{
+    QVector<double> out;
+    out.reserve(indices.size());
+    for (int i : indices) {
+        if (i >= 0 && i < v.size()) out.append(v[i]);
+    }
+    return out;
+}
+
+} // namespace DataDecimation
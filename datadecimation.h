@@ -0,0 +1,26 @@
+#ifndef DATADECIMATION_H
+#define DATADECIMATION_H
+
+#include <QVector>
+
+/**
+ * @brief 观测数据的对数均匀抽稀
+ *
+ * 双对数拟合只需要 log(t) 上均匀覆盖; 压力计动辄 10^4~10^5 个点, 大部分集中在晚期。
+ * 按 log10(t) 等宽分箱, 每箱保留一个样本, 用于粗到细的分级拟合。
+ */
+namespace DataDecimation {
+
+/**
+ * @param t 时间序列 (非正的点被跳过)
+ * @param pointsPerDecade 每十倍时间的箱数
+ * @return 升序的保留下标: 每箱取 log(t) 最接近箱中心的样本, 首末 (正时间) 点总是保留
+ */
+QVector<int> logUniformIndices(const QVector<double>& t, int pointsPerDecade);
+
+// 按下标取子序列 (越界的下标被跳过)
+QVector<double> take(const QVector<double>& v, const QVector<int>& indices);
+
+} // namespace DataDecimation
+
+#endif // DATADECIMATION_H
@@ -4,7 +4,6 @@
 #include <QWidget>
 #include <QString>
 #include <QTableView>
-#include <QStandardItemModel>
 #include <QFile>
 #include <QInputDialog>
 #include <QMessageBox>
@@ -19,6 +18,8 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QFuture>
+#include <QFutureWatcher>
 #include <QSet>
 #include <QList>
 #include <QDialog>
@@ -63,6 +64,8 @@
 
 // 新增：压力导数计算器头文件
 #include "PressureDerivativeCalculator.h"
+#include "datatablemodel.h"
+#include "columnstatisticscache.h"
 
 namespace Ui {
 class DataEditorWidget;
@@ -127,6 +130,8 @@ struct DataStatistics {
     double maximum;
     double average;
     double median;
+    double lowerQuartile;
+    double upperQuartile;
     double standardDeviation;
     QString dataType;
     QString unit;
@@ -176,18 +181,18 @@ struct PressureDropResult {
 class DataEditCommand : public QUndoCommand
 {
 public:
-    DataEditCommand(QStandardItemModel* model, QUndoCommand* parent = nullptr);
+    DataEditCommand(DataTableModel* model, QUndoCommand* parent = nullptr);
     virtual ~DataEditCommand() = default;
 
 protected:
-    QStandardItemModel* m_model;
+    DataTableModel* m_model;
 };
 
 // 单元格编辑命令
 class CellEditCommand : public DataEditCommand
 {
 public:
-    CellEditCommand(QStandardItemModel* model, int row, int column,
+    CellEditCommand(DataTableModel* model, int row, int column,
                     const QString& oldValue, const QString& newValue,
                     QUndoCommand* parent = nullptr);
     void undo() override;
@@ -206,7 +211,7 @@ class RowEditCommand : public DataEditCommand
 public:
     enum Operation { Insert, Delete };
 
-    RowEditCommand(QStandardItemModel* model, Operation op, int row,
+    RowEditCommand(DataTableModel* model, Operation op, int row,
                    const QStringList& rowData = QStringList(),
                    QUndoCommand* parent = nullptr);
     void undo() override;
@@ -224,9 +229,9 @@ class ColumnEditCommand : public DataEditCommand
 public:
     enum Operation { Insert, Delete };
 
-    ColumnEditCommand(QStandardItemModel* model, Operation op, int column,
+    ColumnEditCommand(DataTableModel* model, Operation op, int column,
                       const QString& headerName = QString(),
-                      const QStringList& columnData = QStringList(),
+                      const DataColumn& columnData = DataColumn(),
                       QUndoCommand* parent = nullptr);
     void undo() override;
     void redo() override;
@@ -235,7 +240,7 @@ private:
     Operation m_operation;
     int m_column;
     QString m_headerName;
-    QStringList m_columnData;
+    DataColumn m_columnData;    // 删除的整列 (隐式共享, 不逐格复制)
 };
 
 // 数据读取配置对话框
@@ -261,8 +266,6 @@ private slots:
 private:
     void setupUI();
     void loadFilePreview();
-    QString detectEncoding(const QString& filePath);
-    QString detectSeparator(const QString& filePath);
 
     QString m_filePath;
     LoadConfig m_config;
@@ -419,14 +422,15 @@ public:
     explicit DataEditorWidget(QWidget *parent = nullptr);
     ~DataEditorWidget();
 
-    // 加载并显示数据
+    // 加载并显示数据; 文本文件的数据行在后台解析, 结束时发出 loadingFinished
     void loadData(const QString& filePath, const QString& fileType);
     void loadDataWithConfig(const QString& filePath, const QString& fileType, const DataLoadConfigDialog::LoadConfig& config);
 
     // 获取数据模型和文件信息的方法
-    QStandardItemModel* getDataModel() const { return m_dataModel; }
+    DataTableModel* getDataModel() const { return m_dataModel; }
     QString getCurrentFileName() const { return m_currentFilePath; }
     QString getCurrentFileType() const { return m_currentFileType; }
+    bool isLoading() const { return m_loading; }
     bool hasData() const { return m_dataModel && m_dataModel->rowCount() > 0 && m_dataModel->columnCount() > 0; }
 
     // 数据处理功能
@@ -477,6 +481,9 @@ signals:
     // 新增：压力导数计算完成信号
     void pressureDerivativeCalculated(const PressureDerivativeResult& result);
 
+    // 一次加载结束 (含后台解析), success 为 false 表示加载失败
+    void loadingFinished(bool success);
+
 private slots:
     // 文件操作槽函数
     void onOpenFile();
@@ -498,8 +505,7 @@ private slots:
     void onSearchData();
 
     // 模型数据变化槽函数
-    void onCellDataChanged(QStandardItem* item);
-    void onModelDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight);
+    void onModelDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QList<int>& roles);
 
     // 右键菜单槽函数
     void onTableContextMenuRequested(const QPoint& pos);
@@ -514,7 +520,8 @@ private:
     Ui::DataEditorWidget *ui;
 
     // 数据模型和代理
-    QStandardItemModel* m_dataModel;
+    DataTableModel* m_dataModel;
+    ColumnStatisticsCache* m_statisticsCache;   // 各列统计量, 随模型信号增量维护
     QSortFilterProxyModel* m_proxyModel;
 
     // 撤销重做栈
@@ -523,6 +530,11 @@ private:
     // 当前加载的文件信息
     QString m_currentFilePath;
     QString m_currentFileType;
+    QString m_loadKey;          // 加载方式 (文件类型与读取配置), 数据缓存按此区分
+
+    // 项目目录下的数据缓存: 当前数据对应的缓存文件与后台写入
+    QString m_dataCacheFile;
+    QFuture<bool> m_cacheWrite;
 
     // 数据状态
     bool m_dataModified;
@@ -537,7 +549,11 @@ private:
 
     // 数据缓存（用于大文件处理）
     bool m_largeFileMode;
-    int m_maxDisplayRows;
+    int m_maxDisplayRows;   // 达到该行数的文本文件加载后保留映射 (大文件模式), 不再截断
+
+    // 加载状态: 从 beginLoading 到 finishLoading 为 true; m_textLoad 为正在进行的后台文本解析
+    bool m_loading;
+    QFutureWatcherBase* m_textLoad;
 
     // 右键菜单相关
     QMenu* m_contextMenu;
@@ -584,6 +600,20 @@ private:
     bool loadCSVFile(const QString& filePath, const QString& separator, QString& errorMessage);
     QStringList splitCSVLine(const QString& line, const QString& separator);
 
+    // 映射文本文件并建立行索引, 失败时返回空指针
+    QSharedPointer<MappedTextFile> openTextFile(const QString& filePath, MappedTextFile::LineMode mode, QString& errorMessage);
+    // 从 firstDataLine 行起在后台多线程解析全部数据行 (CsvParser), 返回 true 表示解析已开始, 完成后调用 finishLoading:
+    // 数值列存为 double; 行数达到 m_maxDisplayRows 时为大文件模式, 文本列留在映射中按需读取, 否则立即转为文本列并释放映射
+    bool loadTextRows(const QSharedPointer<MappedTextFile>& file, int firstDataLine,
+                      const QStringList& headers, const QString& separator, QString& errorMessage);
+
+    // 数据缓存 (DataSetCache): 来源文件与加载方式未变时直接读取, 跳过解析; 未打开项目时不使用
+    bool loadDataCache(const QString& filePath, const QString& loadKey);
+    void saveDataCache();
+    void saveColumnDefinitionsToCache();
+    QJsonObject columnDefinitionsToJson() const;
+    static QList<ColumnDefinition> columnDefinitionsFromJson(const QJsonObject& root);
+
     // 文件保存方法
     bool saveExcelFile(const QString& filePath);
     bool saveCsvFile(const QString& filePath);
@@ -631,6 +661,12 @@ private:
     void showAnimatedProgress(const QString& title, const QString& message);
     void hideAnimatedProgress();
     void updateProgress(int value, const QString& message = QString());
+    void setProgressValue(int value, const QString& message = QString());   // 只更新进度, 不处理事件 (加载期间 updateProgress 同此)
+
+    // 加载流程: 检查并进入加载状态 / 收尾 (状态、缓存、列定义) 并发出 loadingFinished
+    bool beginLoading(const QString& filePath, const QString& fileType);
+    void finishLoading(bool loadSuccess, bool fromCache, const QString& errorMessage);
+    void setLoading(bool loading);
 
     // 数据处理方法
     void clearData();
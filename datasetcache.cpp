@@ -0,0 +1,274 @@
+#include "datasetcache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <cstring>
+
+namespace {
+
+const char kMagic[4] = {'W', 'T', 'D', 'C'};
+const quint32 kByteOrder = 0x01020304;
+
+// 文件开头的固定前导, 按本机字节序写出 (byteOrder 不符时拒绝读取)
+struct Preamble {
+    char magic[4];
+    quint32 version;
+    quint32 byteOrder;
+    quint32 reserved;
+    qint64 directoryOffset;   // 目录块; 其后直到文件末尾为列定义 JSON
+    qint64 directorySize;
+};
+static_assert(sizeof(Preamble) == 32, "Preamble layout");
+
+void setError(QString* errorMessage, const QString& text)
+{
+    if (errorMessage) *errorMessage = text;
+}
+
+void prepareStream(QDataStream& stream)
+{
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream.setByteOrder(QDataStream::LittleEndian);
+}
+
+bool readPreamble(const char* data, qint64 size, Preamble* preamble)
+{
+    if (size < qint64(sizeof(Preamble))) return false;
+    std::memcpy(preamble, data, sizeof(Preamble));
+    return std::memcmp(preamble->magic, kMagic, 4) == 0
+           && preamble->version == DataSetCache::kVersion
+           && preamble->byteOrder == kByteOrder
+           && preamble->directoryOffset >= qint64(sizeof(Preamble))
+           && preamble->directorySize >= 0
+           && preamble->directoryOffset + preamble->directorySize <= size;
+}
+
+} // namespace
+
+namespace DataSetCache {
+
+QString cacheDirectory(const QString& projectDir)
+{
+    return QDir(projectDir).filePath("cache");
+}
+
+QString cacheFilePath(const QString& projectDir, const QString& sourcePath)
+{
+    QFileInfo info(sourcePath);
+    QByteArray hash = QCryptographicHash::hash(info.absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex().left(12);
+    return QDir(cacheDirectory(projectDir)).filePath(QString("%1-%2.wtdc").arg(info.completeBaseName(), QString::fromLatin1(hash)));
+}
+
+Source describe(const QString& sourcePath, const QString& loadKey)
+{
+    QFileInfo info(sourcePath);
+    Source source;
+    source.path = info.absoluteFilePath();
+    source.size = info.exists() ? info.size() : -1;
+    source.modified = info.lastModified().toMSecsSinceEpoch();
+    source.loadKey = loadKey;
+    return source;
+}
+
+bool write(const QString& cacheFile, const Content& content, QString* errorMessage)
+{
+    QDir().mkpath(QFileInfo(cacheFile).absolutePath());
+    QSaveFile file(cacheFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        setError(errorMessage, QString("无法写入缓存: %1").arg(file.errorString()));
+        return false;
+    }
+
+    Preamble preamble;
+    std::memset(&preamble, 0, sizeof(preamble));
+    file.write(reinterpret_cast<const char*>(&preamble), sizeof(preamble));
+
+    // 数组按 8 字节对齐, 映射后可直接按 double 读取
+    auto writeBlock = [&file](const void* data, qint64 bytes) -> qint64 {
+        qint64 pad = (8 - file.pos() % 8) % 8;
+        if (pad > 0) file.write(QByteArray(int(pad), '\0'));
+        qint64 offset = file.pos();
+        if (bytes > 0) file.write(static_cast<const char*>(data), bytes);
+        return offset;
+    };
+
+    const int rows = content.rowCount;
+    QByteArray directory;
+    QDataStream out(&directory, QIODevice::WriteOnly);
+    prepareStream(out);
+    out << content.source.path << content.source.size << content.source.modified << content.source.loadKey;
+    out << qint32(rows) << qint32(content.columns.size());
+    for (const Column& column : content.columns) {
+        if (column.data.size() != rows) {
+            setError(errorMessage, "列长度与行数不一致");
+            file.cancelWriting();
+            return false;
+        }
+        const bool text = column.data.kind() == DataColumn::Text;
+        qint64 valuesOffset = writeBlock(column.data.values().constData(), qint64(rows) * qint64(sizeof(double)));
+        qint64 idsOffset = text ? writeBlock(column.data.textIds().constData(), qint64(rows) * qint64(sizeof(qint32))) : -1;
+        out << column.header << qint32(column.data.kind()) << qint32(column.sourceField)
+            << valuesOffset << idsOffset << (text ? column.data.strings() : QStringList());
+    }
+    out << qint32(content.firstLine) << content.separator << content.localEncoding << qint32(content.lineMode);
+
+    preamble.directoryOffset = writeBlock(directory.constData(), directory.size());
+    preamble.directorySize = directory.size();
+    file.write(QJsonDocument(content.metadata).toJson(QJsonDocument::Compact));
+
+    std::memcpy(preamble.magic, kMagic, 4);
+    preamble.version = kVersion;
+    preamble.byteOrder = kByteOrder;
+    if (!file.seek(0) || file.write(reinterpret_cast<const char*>(&preamble), sizeof(preamble)) != qint64(sizeof(preamble))) {
+        setError(errorMessage, QString("无法写入缓存: %1").arg(file.errorString()));
+        file.cancelWriting();
+        return false;
+    }
+    if (!file.commit()) {
+        setError(errorMessage, QString("无法写入缓存: %1").arg(file.errorString()));
+        return false;
+    }
+    return true;
+}
+
+bool read(const QString& cacheFile, const Source& expected, Content* content, QString* errorMessage)
+{
+    QFile file(cacheFile);
+    if (!file.exists()) {
+        setError(errorMessage, "缓存不存在");
+        return false;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        setError(errorMessage, QString("无法打开缓存: %1").arg(file.errorString()));
+        return false;
+    }
+    const qint64 size = file.size();
+    QByteArray buffer;
+    uchar* mapped = size > 0 ? file.map(0, size) : nullptr;
+    if (!mapped) buffer = file.readAll();
+    const char* base = mapped ? reinterpret_cast<const char*>(mapped) : buffer.constData();
+    auto fail = [&](const QString& text) {
+        setError(errorMessage, text);
+        if (mapped) file.unmap(mapped);
+        return false;
+    };
+
+    Preamble preamble;
+    if (!readPreamble(base, size, &preamble)) return fail("缓存格式或版本不符");
+
+    QDataStream in(QByteArray::fromRawData(base + preamble.directoryOffset, int(preamble.directorySize)));
+    prepareStream(in);
+
+    Content result;
+    in >> result.source.path >> result.source.size >> result.source.modified >> result.source.loadKey;
+    if (in.status() != QDataStream::Ok) return fail("缓存目录损坏");
+    if (result.source.path != expected.path || result.source.size != expected.size
+        || result.source.modified != expected.modified || result.source.loadKey != expected.loadKey) {
+        return fail("数据文件已修改或加载方式不同, 缓存失效");
+    }
+
+    qint32 rows = 0, columnCount = 0;
+    in >> rows >> columnCount;
+    if (in.status() != QDataStream::Ok || rows < 0 || columnCount < 0) return fail("缓存目录损坏");
+    result.rowCount = rows;
+    result.columns.reserve(columnCount);
+
+    // 数组必须完整位于目录块之前
+    auto inData = [&](qint64 offset, qint64 bytes) {
+        return offset >= qint64(sizeof(Preamble)) && bytes >= 0 && offset + bytes <= preamble.directoryOffset;
+    };
+    for (int c = 0; c < columnCount; ++c) {
+        Column column;
+        qint32 kind = 0, sourceField = -1;
+        qint64 valuesOffset = 0, idsOffset = -1;
+        QStringList strings;
+        in >> column.header >> kind >> sourceField >> valuesOffset >> idsOffset >> strings;
+        if (in.status() != QDataStream::Ok) return fail("缓存目录损坏");
+
+        const qint64 valueBytes = qint64(rows) * qint64(sizeof(double));
+        if (!inData(valuesOffset, valueBytes)) return fail("缓存数据不完整");
+        QVector<double> values(rows);
+        if (rows > 0) std::memcpy(values.data(), base + valuesOffset, size_t(valueBytes));
+
+        if (kind == DataColumn::Text) {
+            const qint64 idBytes = qint64(rows) * qint64(sizeof(qint32));
+            if (!inData(idsOffset, idBytes)) return fail("缓存数据不完整");
+            QVector<qint32> ids(rows);
+            if (rows > 0) std::memcpy(ids.data(), base + idsOffset, size_t(idBytes));
+            for (qint32 id : ids) {
+                if (id < 0 || id >= strings.size()) return fail("缓存数据损坏");
+            }
+            column.data = DataColumn::fromText(values, strings, ids);
+        } else {
+            column.data = DataColumn(values);
+        }
+        column.sourceField = sourceField;
+        result.columns.append(column);
+    }
+
+    qint32 firstLine = 0, lineMode = 0;
+    in >> firstLine >> result.separator >> result.localEncoding >> lineMode;
+    if (in.status() != QDataStream::Ok) return fail("缓存目录损坏");
+    result.firstLine = firstLine;
+    result.lineMode = lineMode;
+
+    const qint64 metadataOffset = preamble.directoryOffset + preamble.directorySize;
+    QByteArray metadata(base + metadataOffset, int(size - metadataOffset));
+    result.metadata = QJsonDocument::fromJson(metadata).object();
+
+    if (mapped) file.unmap(mapped);
+    *content = result;
+    return true;
+}
+
+bool updateMetadata(const QString& cacheFile, const QJsonObject& metadata, QString* errorMessage)
+{
+    QFile source(cacheFile);
+    if (!source.exists()) {
+        setError(errorMessage, "缓存不存在");
+        return false;
+    }
+    if (!source.open(QIODevice::ReadOnly)) {
+        setError(errorMessage, QString("无法打开缓存: %1").arg(source.errorString()));
+        return false;
+    }
+    Preamble preamble;
+    QByteArray head = source.read(sizeof(Preamble));
+    if (head.size() != int(sizeof(Preamble)) || !readPreamble(head.constData(), source.size(), &preamble)) {
+        setError(errorMessage, "缓存格式或版本不符");
+        return false;
+    }
+
+    // 复制前导、各列数组与目录块, 换上新的列定义后整体替换, 中途失败时原缓存不变
+    QSaveFile file(cacheFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        setError(errorMessage, QString("无法写入缓存: %1").arg(file.errorString()));
+        return false;
+    }
+    const qint64 metadataOffset = preamble.directoryOffset + preamble.directorySize;
+    file.write(head);
+    for (qint64 remaining = metadataOffset - head.size(); remaining > 0;) {
+        QByteArray chunk = source.read(qMin<qint64>(remaining, 4 << 20));
+        if (chunk.isEmpty() || file.write(chunk) != chunk.size()) {
+            setError(errorMessage, QString("无法复制缓存: %1").arg(chunk.isEmpty() ? source.errorString() : file.errorString()));
+            file.cancelWriting();
+            return false;
+        }
+        remaining -= chunk.size();
+    }
+    file.write(QJsonDocument(metadata).toJson(QJsonDocument::Compact));
+    source.close();
+    if (!file.commit()) {
+        setError(errorMessage, QString("无法写入缓存: %1").arg(file.errorString()));
+        return false;
+    }
+    return true;
+}
+
+} // namespace DataSetCache
@@ -0,0 +1,70 @@
+#ifndef DATASETCACHE_H
+#define DATASETCACHE_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "datacolumn.h"
+
+/**
+ * @brief 项目目录下的数据集二进制缓存 (按列存放)
+ *
+ * 数据文件加载后把解析结果写入项目目录 cache/ 下的 .wtdc 文件, 再次打开同一数据文件时
+ * 直接映射缓存, 各列 double 数组按 8 字节对齐连续存放, 整块复制进 DataColumn, 不再经过编码 / 分隔符检测与文本解析。
+ *
+ * 文件结构: 32 字节前导 (魔数、版本、字节序标记、目录块偏移与长度) | 各列数组 | 目录块。
+ * 目录块由 QDataStream 写出: 来源文件的路径、大小、修改时间与加载方式, 各列表头、类型与数组偏移,
+ * 文本列的字符串池, 以及界面层的列定义 (metadata, 含单位)。
+ * 来源文件的大小、修改时间或加载方式与缓存记录不一致时视为失效, 由调用方重新解析并覆盖。
+ * 大文件模式下留在映射中的文本列只记录字段序号, 读取缓存后由调用方重新映射来源文件。
+ */
+namespace DataSetCache {
+
+// 缓存格式版本, 结构变化时递增 (旧版本缓存视为失效)
+const quint32 kVersion = 1;
+
+// 来源文件与加载方式, 用于判断缓存是否有效
+struct Source {
+    QString path;           // 绝对路径
+    qint64 size = -1;
+    qint64 modified = 0;    // 修改时间 (ms since epoch, UTC)
+    QString loadKey;        // 加载方式 (文件类型、分隔符、起始行等), 不同方式的结果不共用缓存
+};
+
+struct Column {
+    QString header;
+    DataColumn data;
+    int sourceField = -1;   // >= 0: 留在来源文件映射中的文本列
+};
+
+struct Content {
+    Source source;
+    int rowCount = 0;
+    QVector<Column> columns;
+    // 映射列的取值方式 (与 DataTableModel::setMappedTable 对应)
+    int firstLine = 0;
+    QByteArray separator;
+    bool localEncoding = false;
+    int lineMode = 0;
+    QJsonObject metadata;   // 列定义等, 由界面层解释
+};
+
+// 项目目录下存放缓存的子目录
+QString cacheDirectory(const QString& projectDir);
+// 来源文件对应的缓存文件 (文件名含路径散列, 同名不同目录的数据文件互不覆盖)
+QString cacheFilePath(const QString& projectDir, const QString& sourcePath);
+// 来源文件当前的大小与修改时间
+Source describe(const QString& sourcePath, const QString& loadKey);
+
+// 写入缓存 (先写临时文件再替换, 中途失败不留下半个文件); 可在工作线程调用
+bool write(const QString& cacheFile, const Content& content, QString* errorMessage = nullptr);
+// 读取缓存; 来源不匹配、版本不同或文件损坏时返回 false
+bool read(const QString& cacheFile, const Source& expected, Content* content, QString* errorMessage = nullptr);
+// 只替换列定义: 复制原缓存的各列数组与目录块后整体替换 (QSaveFile); 缓存不存在或格式不符时返回 false
+bool updateMetadata(const QString& cacheFile, const QJsonObject& metadata, QString* errorMessage = nullptr);
+
+} // namespace DataSetCache
+
+#endif // DATASETCACHE_H
@@ -0,0 +1,338 @@
+#include "datatablemodel.h"
+
+#include <QBrush>
+#include <limits>
+
+DataTableModel::DataTableModel(QObject* parent)
+    : QAbstractTableModel(parent),
+      m_rows(0),
+      m_sourceFirstLine(0)
+{
+}
+
+int DataTableModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rows;
+}
+
+int DataTableModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_columns.size();
+}
+
+QVariant DataTableModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows || index.column() >= m_columns.size()) return QVariant();
+    int r = index.row(), c = index.column();
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        return isDeferred(c) ? sourceText(r, c) : m_columns[c].text(r, m_info[c].precision);
+    case Qt::ForegroundRole: {
+        auto it = m_cellForeground.constFind(cellKey(r, c));
+        if (it != m_cellForeground.constEnd()) return QBrush(it.value());
+        if (m_info[c].foreground.isValid()) return QBrush(m_info[c].foreground);
+        return QVariant();
+    }
+    case Qt::BackgroundRole:
+        return m_info[c].background.isValid() ? QVariant(QBrush(m_info[c].background)) : QVariant();
+    default:
+        return QVariant();
+    }
+}
+
+bool DataTableModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if (!index.isValid() || role != Qt::EditRole || index.row() >= m_rows || index.column() >= m_columns.size()) return false;
+    materializeColumn(index.column());
+    emit cellAboutToChange(index.row(), index.column());
+    m_columns[index.column()].setText(index.row(), value.toString());
+    emit dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole});
+    return true;
+}
+
+QVariant DataTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole && role != Qt::EditRole) return QVariant();
+    if (orientation == Qt::Vertical) return section + 1;
+    if (section < 0 || section >= m_info.size()) return QVariant();
+    // 未设置表头的列与 QStandardItemModel 一致显示列号
+    return m_info[section].header.isNull() ? QVariant(section + 1) : QVariant(m_info[section].header);
+}
+
+bool DataTableModel::setHeaderData(int section, Qt::Orientation orientation, const QVariant& value, int role)
+{
+    if (orientation != Qt::Horizontal || (role != Qt::DisplayRole && role != Qt::EditRole)) return false;
+    if (section < 0 || section >= m_info.size()) return false;
+    m_info[section].header = value.toString();
+    emit headerDataChanged(Qt::Horizontal, section, section);
+    return true;
+}
+
+Qt::ItemFlags DataTableModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid()) return Qt::NoItemFlags;
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsEditable;
+}
+
+bool DataTableModel::insertRows(int row, int count, const QModelIndex& parent)
+{
+    if (parent.isValid() || row < 0 || row > m_rows || count <= 0) return false;
+    materialize();
+    beginInsertRows(QModelIndex(), row, row + count - 1);
+    for (DataColumn& col : m_columns) col.insert(row, count);
+    m_rows += count;
+    m_cellForeground.clear();
+    endInsertRows();
+    return true;
+}
+
+bool DataTableModel::removeRows(int row, int count, const QModelIndex& parent)
+{
+    if (parent.isValid() || row < 0 || count <= 0 || row + count > m_rows) return false;
+    materialize();
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    for (DataColumn& col : m_columns) col.remove(row, count);
+    m_rows -= count;
+    m_cellForeground.clear();
+    endRemoveRows();
+    return true;
+}
+
+bool DataTableModel::insertColumns(int column, int count, const QModelIndex& parent)
+{
+    if (parent.isValid() || column < 0 || column > m_columns.size() || count <= 0) return false;
+    beginInsertColumns(QModelIndex(), column, column + count - 1);
+    m_columns.insert(column, count, DataColumn(m_rows));
+    m_info.insert(column, count, ColumnInfo());
+    m_cellForeground.clear();
+    endInsertColumns();
+    return true;
+}
+
+bool DataTableModel::removeColumns(int column, int count, const QModelIndex& parent)
+{
+    if (parent.isValid() || column < 0 || count <= 0 || column + count > m_columns.size()) return false;
+    beginRemoveColumns(QModelIndex(), column, column + count - 1);
+    m_columns.remove(column, count);
+    m_info.remove(column, count);
+    m_cellForeground.clear();
+    endRemoveColumns();
+    releaseSourceIfUnused();
+    return true;
+}
+
+void DataTableModel::clear()
+{
+    beginResetModel();
+    m_rows = 0;
+    m_columns.clear();
+    m_info.clear();
+    m_cellForeground.clear();
+    m_source.reset();
+    endResetModel();
+}
+
+void DataTableModel::setTable(const QStringList& headers, const QVector<DataColumn>& columns)
+{
+    setMappedTable(headers, columns, QSharedPointer<MappedTextFile>(), 0, QByteArray(), QVector<int>());
+}
+
+void DataTableModel::setMappedTable(const QStringList& headers, const QVector<DataColumn>& columns,
+                                    const QSharedPointer<MappedTextFile>& source, int firstLine,
+                                    const QByteArray& separator, const QVector<int>& sourceFields)
+{
+    beginResetModel();
+    m_columns = columns;
+    m_rows = columns.isEmpty() ? 0 : columns.first().size();
+    for (DataColumn& col : m_columns) if (col.size() != m_rows) col.resize(m_rows);
+    m_info = QVector<ColumnInfo>(m_columns.size());
+    for (int c = 0; c < m_info.size() && c < headers.size(); ++c) m_info[c].header = headers[c];
+    m_cellForeground.clear();
+    m_source = source;
+    m_sourceFirstLine = firstLine;
+    m_sourceSeparator = separator;
+    if (m_source) {
+        for (int c = 0; c < m_info.size() && c < sourceFields.size(); ++c) m_info[c].sourceField = sourceFields[c];
+    }
+    releaseSourceIfUnused();
+    endResetModel();
+}
+
+void DataTableModel::materializeColumn(int column)
+{
+    if (column < 0 || column >= m_columns.size() || !isDeferred(column)) return;
+    DataColumn text;
+    text.reserve(m_rows);
+    for (int r = 0; r < m_rows; ++r) text.appendText(sourceText(r, column));
+    m_columns[column] = text;
+    m_info[column].sourceField = -1;
+    releaseSourceIfUnused();
+}
+
+void DataTableModel::materialize()
+{
+    for (int c = 0; c < m_columns.size() && m_source; ++c) materializeColumn(c);
+    m_source.reset();
+}
+
+void DataTableModel::setRowCount(int rows)
+{
+    rows = qMax(0, rows);
+    if (rows > m_rows) insertRows(m_rows, rows - m_rows);
+    else if (rows < m_rows) removeRows(rows, m_rows - rows);
+}
+
+void DataTableModel::setColumnCount(int columns)
+{
+    columns = qMax(0, columns);
+    if (columns > m_columns.size()) insertColumns(m_columns.size(), columns - m_columns.size());
+    else if (columns < m_columns.size()) removeColumns(columns, m_columns.size() - columns);
+}
+
+void DataTableModel::setHorizontalHeaderLabels(const QStringList& labels)
+{
+    if (labels.size() > m_columns.size()) setColumnCount(labels.size());
+    for (int c = 0; c < labels.size(); ++c) m_info[c].header = labels[c];
+    if (!labels.isEmpty()) emit headerDataChanged(Qt::Horizontal, 0, labels.size() - 1);
+}
+
+QString DataTableModel::text(int row, int column) const
+{
+    if (row < 0 || row >= m_rows || column < 0 || column >= m_columns.size()) return QString();
+    if (isDeferred(column)) return sourceText(row, column);
+    return m_columns[column].text(row, m_info[column].precision);
+}
+
+double DataTableModel::value(int row, int column) const
+{
+    if (row < 0 || row >= m_rows || column < 0 || column >= m_columns.size()) return std::numeric_limits<double>::quiet_NaN();
+    return m_columns[column].value(row);
+}
+
+bool DataTableModel::isEmpty(int row, int column) const
+{
+    if (row < 0 || row >= m_rows || column < 0 || column >= m_columns.size()) return true;
+    if (isDeferred(column)) return sourceText(row, column).isEmpty();
+    return m_columns[column].isEmpty(row);
+}
+
+void DataTableModel::setText(int row, int column, const QString& text)
+{
+    // 与 QStandardItemModel::setItem 一致: 超出范围时扩展行列
+    if (row < 0 || column < 0) return;
+    if (row >= m_rows) setRowCount(row + 1);
+    if (column >= m_columns.size()) setColumnCount(column + 1);
+    materializeColumn(column);
+    emit cellAboutToChange(row, column);
+    m_columns[column].setText(row, text);
+    QModelIndex idx = index(row, column);
+    emit dataChanged(idx, idx, {Qt::DisplayRole, Qt::EditRole});
+}
+
+void DataTableModel::setValue(int row, int column, double value)
+{
+    if (row < 0 || column < 0) return;
+    if (row >= m_rows) setRowCount(row + 1);
+    if (column >= m_columns.size()) setColumnCount(column + 1);
+    materializeColumn(column);
+    emit cellAboutToChange(row, column);
+    m_columns[column].setValue(row, value);
+    QModelIndex idx = index(row, column);
+    emit dataChanged(idx, idx, {Qt::DisplayRole, Qt::EditRole});
+}
+
+void DataTableModel::setColumn(int column, const DataColumn& data)
+{
+    if (column < 0 || column >= m_columns.size()) return;
+    m_columns[column] = data;
+    if (m_columns[column].size() != m_rows) m_columns[column].resize(m_rows);
+    m_info[column].sourceField = -1;
+    releaseSourceIfUnused();
+    emitColumnChanged(column);
+}
+
+bool DataTableModel::isNumericColumn(int column) const
+{
+    if (column < 0 || column >= m_columns.size()) return false;
+    return !isDeferred(column) && m_columns[column].isNumeric();
+}
+
+QString DataTableModel::headerText(int column) const
+{
+    if (column < 0 || column >= m_info.size()) return QString();
+    return m_info[column].header;
+}
+
+void DataTableModel::setHeaderText(int column, const QString& text)
+{
+    setHeaderData(column, Qt::Horizontal, text);
+}
+
+void DataTableModel::setColumnPrecision(int column, int decimals)
+{
+    if (column < 0 || column >= m_info.size() || m_info[column].precision == decimals) return;
+    m_info[column].precision = decimals;
+    emitColumnChanged(column);
+}
+
+int DataTableModel::columnPrecision(int column) const
+{
+    return (column < 0 || column >= m_info.size()) ? -1 : m_info[column].precision;
+}
+
+void DataTableModel::setColumnForeground(int column, const QColor& color)
+{
+    if (column < 0 || column >= m_info.size()) return;
+    m_info[column].foreground = color;
+    emitColumnChanged(column, {Qt::ForegroundRole});
+}
+
+void DataTableModel::setColumnBackground(int column, const QColor& color)
+{
+    if (column < 0 || column >= m_info.size()) return;
+    m_info[column].background = color;
+    emitColumnChanged(column, {Qt::BackgroundRole});
+}
+
+void DataTableModel::setCellForeground(int row, int column, const QColor& color)
+{
+    if (row < 0 || row >= m_rows || column < 0 || column >= m_columns.size()) return;
+    m_cellForeground.insert(cellKey(row, column), color);
+    QModelIndex idx = index(row, column);
+    emit dataChanged(idx, idx, {Qt::ForegroundRole});
+}
+
+void DataTableModel::clearCellStyles()
+{
+    m_cellForeground.clear();
+    if (m_rows > 0 && !m_columns.isEmpty()) emit dataChanged(index(0, 0), index(m_rows - 1, m_columns.size() - 1), {Qt::ForegroundRole});
+}
+
+qint64 DataTableModel::memoryUsage() const
+{
+    qint64 bytes = 0;
+    for (const DataColumn& col : m_columns) bytes += col.memoryUsage();
+    if (m_source) bytes += m_source->indexMemory();
+    return bytes;
+}
+
+QString DataTableModel::sourceText(int row, int column) const
+{
+    QByteArray line = m_source->line(m_sourceFirstLine + row);
+    return m_source->decode(MappedTextFile::field(line, m_sourceSeparator, m_info[column].sourceField));
+}
+
+void DataTableModel::releaseSourceIfUnused()
+{
+    if (!m_source) return;
+    for (const ColumnInfo& info : m_info) {
+        if (info.sourceField >= 0) return;
+    }
+    m_source.reset();
+}
+
+void DataTableModel::emitColumnChanged(int column, const QList<int>& roles)
+{
+    if (m_rows > 0) emit dataChanged(index(0, column), index(m_rows - 1, column), roles);
+}
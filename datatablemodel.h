@@ -0,0 +1,127 @@
+#ifndef DATATABLEMODEL_H
+#define DATATABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QColor>
+#include <QHash>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+#include "datacolumn.h"
+#include "mappedtextfile.h"
+
+/**
+ * @brief 数据编辑器的表格模型: 按列存放 (DataColumn), 不为单元格创建对象
+ *
+ * 显示文本只在 data() 中为可见单元格格式化; 计算代码通过 value() / columnValues() 直接读取 double。
+ * 接口与原先使用的 QStandardItemModel 对应 (text / setText 代替 item()->text() / setItem),
+ * 行列的插入删除走 QAbstractItemModel 的标准信号, 代理模型与视图无需改动。
+ * 单元格前景色 (如填充值标记) 为稀疏表, 行列结构变化时清空; 列的前景 / 背景色随列移动。
+ *
+ * 大文件模式 (setMappedTable): 数值列照常存为 double 列; 含非数值文本的列不物化,
+ * 显示时从内存映射文件的对应行取字段。写入这类列时先把该列转为普通文本列,
+ * 增删行前转换全部映射列 (行号与文件行的对应关系随之失效), 全部转换后释放映射。
+ */
+class DataTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit DataTableModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    bool setHeaderData(int section, Qt::Orientation orientation, const QVariant& value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    bool insertRows(int row, int count, const QModelIndex& parent = QModelIndex()) override;
+    bool removeRows(int row, int count, const QModelIndex& parent = QModelIndex()) override;
+    bool insertColumns(int column, int count, const QModelIndex& parent = QModelIndex()) override;
+    bool removeColumns(int column, int count, const QModelIndex& parent = QModelIndex()) override;
+
+    // 整表
+    void clear();
+    // 一次性替换全部数据 (加载文件); columns 须等长
+    void setTable(const QStringList& headers, const QVector<DataColumn>& columns);
+    // 大文件模式: 第 row 行对应 source 的第 firstLine + row 行; sourceFields[c] >= 0 的列不物化,
+    // 显示时取该行按 separator 拆分后的第 sourceFields[c] 个字段, columns[c] 中只有可解析的数值
+    void setMappedTable(const QStringList& headers, const QVector<DataColumn>& columns,
+                        const QSharedPointer<MappedTextFile>& source, int firstLine,
+                        const QByteArray& separator, const QVector<int>& sourceFields);
+    bool isMapped() const { return !m_source.isNull(); }
+    QString sourceFileName() const { return m_source ? m_source->fileName() : QString(); }
+    // 映射的来源 (写入数据缓存时记录): 文件、起始行、分隔符与各列的字段序号 (未映射的列为 -1)
+    QSharedPointer<MappedTextFile> source() const { return m_source; }
+    int sourceFirstLine() const { return m_sourceFirstLine; }
+    QByteArray sourceSeparator() const { return m_sourceSeparator; }
+    int sourceField(int column) const { return isDeferred(column) ? m_info[column].sourceField : -1; }
+    // 把映射列转为普通文本列 (覆盖源文件、增删行前调用); materialize() 转换全部并释放映射
+    void materializeColumn(int column);
+    void materialize();
+    void setRowCount(int rows);
+    void setColumnCount(int columns);
+    void setHorizontalHeaderLabels(const QStringList& labels);
+
+    // 单元格
+    QString text(int row, int column) const;
+    double value(int row, int column) const;
+    bool isEmpty(int row, int column) const;
+    void setText(int row, int column, const QString& text);
+    void setValue(int row, int column, double value);
+
+    // 列; 映射列的 DataColumn 只含可解析的数值, 文本请经 text() / isEmpty() 读取
+    const DataColumn& column(int column) const { return m_columns[column]; }
+    // 整列均为数值 (映射列不算)
+    bool isNumericColumn(int column) const;
+    // 整列数值 (隐式共享, 不复制); 空单元格与非数值文本为 NaN
+    QVector<double> columnValues(int column) const { return m_columns[column].values(); }
+    // 替换整列数据 (发出该列的 dataChanged)
+    void setColumn(int column, const DataColumn& data);
+    QString headerText(int column) const;
+    void setHeaderText(int column, const QString& text);
+    // 数值单元格的显示小数位, < 0 为最短精确表示
+    void setColumnPrecision(int column, int decimals);
+    int columnPrecision(int column) const;
+
+    // 样式
+    void setColumnForeground(int column, const QColor& color);
+    void setColumnBackground(int column, const QColor& color);
+    void setCellForeground(int row, int column, const QColor& color);
+    void clearCellStyles();
+
+    // 全部列占用的内存 (字节, 近似)
+    qint64 memoryUsage() const;
+
+signals:
+    // 单元格写入前 (setText / setValue / setData, 随后发出该单元格的 dataChanged), 此时仍可读到旧值;
+    // 供统计缓存按新旧值增量更新
+    void cellAboutToChange(int row, int column);
+
+private:
+    struct ColumnInfo {
+        QString header;
+        int precision = -1;
+        QColor foreground;
+        QColor background;
+        int sourceField = -1;   // 大文件模式下的映射列: 源文件中的字段序号
+    };
+
+    static qint64 cellKey(int row, int column) { return (qint64(row) << 32) | quint32(column); }
+    void emitColumnChanged(int column, const QList<int>& roles = QList<int>());
+    bool isDeferred(int column) const { return m_source && m_info[column].sourceField >= 0; }
+    QString sourceText(int row, int column) const;
+    void releaseSourceIfUnused();
+
+    int m_rows;
+    QVector<DataColumn> m_columns;
+    QVector<ColumnInfo> m_info;
+    QHash<qint64, QColor> m_cellForeground;
+
+    QSharedPointer<MappedTextFile> m_source;
+    int m_sourceFirstLine;
+    QByteArray m_sourceSeparator;
+};
+
+#endif // DATATABLEMODEL_H
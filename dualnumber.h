@@ -0,0 +1,117 @@
+#ifndef DUALNUMBER_H
+#define DUALNUMBER_H
+
+#include <cmath>
+#include <algorithm>
+#include "besselkernel.h"
+
+/**
+ * @brief 前向模式自动微分的多分量对偶数 v + sum_k d[k]*eps_k
+ *
+ * 一次求值同时得到函数值与对 n 个参数的偏导数, 用于 LM 拟合的解析雅可比。
+ * n 为运行期的有效分量数 (常量 n = 0, 参与运算时按 0 补齐), 上限 MaxDerivatives,
+ * 数组定长以避免堆分配。
+ *
+ * 提供 CompositeKernel 所需的 realValue / magnitude / Bessel 重载 (经 ADL 查找),
+ * 以及 GaussKronrod 误差估计用的 abs() (返回函数值的绝对值)。
+ */
+class Dual
+{
+public:
+    static constexpr int MaxDerivatives = 16;
+
+    double v;
+    int n;
+    double d[MaxDerivatives];
+
+    Dual() : v(0.0), n(0) {}
+    Dual(double value) : v(value), n(0) {}
+
+    // 第 k 个自变量 (共 count 个), 导数分量为单位向量
+    static Dual variable(double value, int k, int count) {
+        Dual r(value);
+        r.n = count;
+        std::fill(r.d, r.d + count, 0.0);
+        r.d[k] = 1.0;
+        return r;
+    }
+
+    double grad(int k) const { return k < n ? d[k] : 0.0; }
+
+    // r = a*x + b*y 的导数部分 (x, y 的有效分量数可不同)
+    static void combine(Dual& r, double a, const Dual& x, double b, const Dual& y) {
+        int m = std::max(x.n, y.n);
+        for (int k = 0; k < m; ++k) r.d[k] = a * x.grad(k) + b * y.grad(k);
+        r.n = m;
+    }
+    // r = a*x 的导数部分
+    static void scale(Dual& r, double a, const Dual& x) {
+        for (int k = 0; k < x.n; ++k) r.d[k] = a * x.d[k];
+        r.n = x.n;
+    }
+
+    Dual operator-() const { Dual r(-v); scale(r, -1.0, *this); return r; }
+
+    Dual& operator+=(const Dual& o) { *this = *this + o; return *this; }
+    Dual& operator-=(const Dual& o) { *this = *this - o; return *this; }
+    Dual& operator*=(const Dual& o) { *this = *this * o; return *this; }
+    Dual& operator/=(const Dual& o) { *this = *this / o; return *this; }
+
+    friend Dual operator+(const Dual& a, const Dual& b) { Dual r(a.v + b.v); combine(r, 1.0, a, 1.0, b); return r; }
+    friend Dual operator-(const Dual& a, const Dual& b) { Dual r(a.v - b.v); combine(r, 1.0, a, -1.0, b); return r; }
+    friend Dual operator*(const Dual& a, const Dual& b) { Dual r(a.v * b.v); combine(r, b.v, a, a.v, b); return r; }
+    friend Dual operator/(const Dual& a, const Dual& b) {
+        Dual r(a.v / b.v);
+        combine(r, 1.0 / b.v, a, -r.v / b.v, b);
+        return r;
+    }
+
+    // 与 double 的混合运算 (避免构造临时对偶数)
+    friend Dual operator+(const Dual& a, double b) { Dual r(a.v + b); scale(r, 1.0, a); return r; }
+    friend Dual operator+(double a, const Dual& b) { return b + a; }
+    friend Dual operator-(const Dual& a, double b) { Dual r(a.v - b); scale(r, 1.0, a); return r; }
+    friend Dual operator-(double a, const Dual& b) { Dual r(a - b.v); scale(r, -1.0, b); return r; }
+    friend Dual operator*(const Dual& a, double b) { Dual r(a.v * b); scale(r, b, a); return r; }
+    friend Dual operator*(double a, const Dual& b) { return b * a; }
+    friend Dual operator/(const Dual& a, double b) { return a * (1.0 / b); }
+    friend Dual operator/(double a, const Dual& b) { Dual r(a / b.v); scale(r, -r.v / b.v, b); return r; }
+};
+
+// 链式法则: f(x) 的值为 fv, 导数为 dfdx
+inline Dual chain(const Dual& x, double fv, double dfdx)
+{
+    Dual r(fv);
+    Dual::scale(r, dfdx, x);
+    return r;
+}
+
+inline Dual sqrt(const Dual& x) { double s = std::sqrt(x.v); return chain(x, s, s > 0.0 ? 0.5 / s : 0.0); }
+inline Dual exp(const Dual& x) { double e = std::exp(x.v); return chain(x, e, e); }
+inline Dual log(const Dual& x) { return chain(x, std::log(x.v), 1.0 / x.v); }
+inline double abs(const Dual& x) { return std::abs(x.v); }
+
+// CompositeKernel 标量类型适配
+inline double realValue(const Dual& x) { return x.v; }
+inline double magnitude(const Dual& x) { return std::abs(x.v); }
+
+// K0' = -K1, K1' = -K0 - K1/x
+inline Dual besselK0(const Dual& x) { return chain(x, BesselKernel::k0(x.v), -BesselKernel::k1(x.v)); }
+inline Dual besselK1(const Dual& x)
+{
+    double k0 = BesselKernel::k0(x.v), k1 = BesselKernel::k1(x.v);
+    return chain(x, k1, -k0 - k1 / x.v);
+}
+// I0e = e^{-x} I0: I0e' = I1e - I0e;  I1e' = I0e - I1e/x - I1e   (x > 0)
+inline Dual besselI0e(const Dual& x)
+{
+    double i0 = BesselKernel::i0e(x.v), i1 = BesselKernel::i1e(x.v);
+    return chain(x, i0, i1 - i0);
+}
+inline Dual besselI1e(const Dual& x)
+{
+    double i0 = BesselKernel::i0e(x.v), i1 = BesselKernel::i1e(x.v);
+    double di = (x.v > 1e-300) ? i0 - i1 / x.v - i1 : 0.5;
+    return chain(x, i1, di);
+}
+
+#endif // DUALNUMBER_H
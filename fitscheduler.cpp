@@ -0,0 +1,134 @@
+#include "fitscheduler.h"
+
+#include <QThread>
+#include <QtConcurrent>
+#include <limits>
+
+FitScheduler::FitScheduler(QObject* parent)
+    : QObject(parent),
+      m_lastId(0),
+      m_lastGroup(0)
+{
+    // 默认两个任务并行, 单核机器上为 1
+    m_pool.setMaxThreadCount(qBound(1, 2, QThread::idealThreadCount()));
+}
+
+FitScheduler::~FitScheduler()
+{
+    // 提交方 (分析页) 应先于调度器析构并等待各自的任务; 这里只兜底等待线程池清空
+    cancelAll();
+    m_pool.waitForDone();
+}
+
+void FitScheduler::setWorkerBudget(int workers)
+{
+    // 已在运行的任务不受影响, 之后开始的任务按新的预算划分线程
+    m_pool.setMaxThreadCount(qBound(1, workers, qMax(1, QThread::idealThreadCount())));
+}
+
+int FitScheduler::threadsPerJob() const
+{
+    // 任务线程在 blockingMap 中也参与计算, 从每任务的份额中扣除
+    return qMax(1, QThread::idealThreadCount() / qMax(1, m_pool.maxThreadCount()) - 1);
+}
+
+QFuture<void> FitScheduler::submit(QObject* owner, const QString& modelName, const std::function<void()>& task,
+                                   CancellationToken* cancel, int group, int* jobId)
+{
+    Job j;
+    j.id = ++m_lastId;
+    j.group = group;
+    j.owner = owner;
+    j.modelName = modelName;
+    j.mse = std::numeric_limits<double>::quiet_NaN();
+    j.cancel = cancel;
+    m_jobs.insert(j.id, j);
+    if(jobId) *jobId = j.id;
+    emit jobChanged(j.id);
+
+    int id = j.id;
+    return QtConcurrent::run(&m_pool, [this, id, task]() {
+        QMetaObject::invokeMethod(this, [this, id]() { markRunning(id); }, Qt::QueuedConnection);
+        task();
+    });
+}
+
+void FitScheduler::markRunning(int jobId)
+{
+    auto it = m_jobs.find(jobId);
+    // finishJob 也是排队调用, 顺序在此之后; 这里只处理仍在排队的任务
+    if(it == m_jobs.end() || it->state != Queued) return;
+    it->state = Running;
+    it->timer.start();
+    emit jobChanged(jobId);
+}
+
+void FitScheduler::finishJob(int jobId, double mse, bool cancelled)
+{
+    auto it = m_jobs.find(jobId);
+    if(it == m_jobs.end() || !isActive(jobId)) return;
+    it->state = cancelled ? Cancelled : Finished;
+    it->mse = mse;
+    it->elapsedMs = it->timer.isValid() ? it->timer.elapsed() : 0;
+    it->cancel = nullptr;
+    emit jobChanged(jobId);
+}
+
+void FitScheduler::cancelJob(int jobId)
+{
+    auto it = m_jobs.find(jobId);
+    if(it != m_jobs.end() && it->cancel) it->cancel->cancel();
+}
+
+void FitScheduler::cancelAll()
+{
+    for(auto it = m_jobs.begin(); it != m_jobs.end(); ++it)
+        if(it->cancel) it->cancel->cancel();
+}
+
+void FitScheduler::clearFinished()
+{
+    for(auto it = m_jobs.begin(); it != m_jobs.end(); ) {
+        if(it->state == Finished || it->state == Cancelled) it = m_jobs.erase(it);
+        else ++it;
+    }
+    emit jobsCleared();
+}
+
+const FitScheduler::Job* FitScheduler::job(int jobId) const
+{
+    auto it = m_jobs.constFind(jobId);
+    return it == m_jobs.constEnd() ? nullptr : &it.value();
+}
+
+bool FitScheduler::isActive(int jobId) const
+{
+    const Job* j = job(jobId);
+    return j && (j->state == Queued || j->state == Running);
+}
+
+bool FitScheduler::groupFinished(int group) const
+{
+    for(const Job& j : m_jobs)
+        if(j.group == group && (j.state == Queued || j.state == Running)) return false;
+    return true;
+}
+
+QList<int> FitScheduler::groupJobs(int group) const
+{
+    QList<int> ids;
+    for(const Job& j : m_jobs)
+        if(j.group == group) ids.append(j.id);
+    return ids;
+}
+
+QString FitScheduler::stateName(JobState state)
+{
+    switch(state) {
+    case Queued: return "排队";
+    case Running: return "运行中";
+    case Finished: return "完成";
+    case Cancelled: return "已取消";
+    }
+    return QString();
+}
@@ -0,0 +1,91 @@
+#ifndef FITSCHEDULER_H
+#define FITSCHEDULER_H
+
+#include <QObject>
+#include <QMap>
+#include <QPointer>
+#include <QFuture>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <functional>
+#include "cancellationtoken.h"
+
+/**
+ * @brief FittingPage 各分析页共用的拟合调度器
+ *
+ * 拟合任务提交到调度器自己的线程池, 同时运行的任务数不超过工作线程预算, 其余排队。
+ * 每个任务内部的并行求值 (雅可比各列、全局搜索候选、按时间点反演) 都在提交方自己的线程池中进行,
+ * 该池大小取 threadsPerJob(); 任务线程在等待并行求值时也参与计算, 因此每个任务占用
+ * CPU 核数 / 预算 个线程, 总线程数不超过核数 (每任务至少 2 个线程, 预算超过核数一半时例外)。
+ * 任务状态只在主线程维护: 开始由工作线程排队通知, 结束由提交方在主线程调用 finishJob。
+ * 取消只设置任务的取消标记, 不从队列中移除: 任务照常开始并立即结束, 提交方的收尾逻辑不变。
+ */
+class FitScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum JobState { Queued = 0, Running, Finished, Cancelled };
+
+    struct Job {
+        int id = 0;
+        int group = 0;              // 同一批提交 (如六模型对比) 的编号, 0 为单独提交
+        QPointer<QObject> owner;    // 提交任务的分析页, 状态表按其页签名显示
+        QString modelName;
+        JobState state = Queued;
+        double mse = 0.0;           // 结束时的 MSE, 无有效结果为 NaN
+        qint64 elapsedMs = 0;
+        CancellationToken* cancel = nullptr;  // 由提交方持有, 结束后清空
+        QElapsedTimer timer;
+    };
+
+    explicit FitScheduler(QObject* parent = nullptr);
+    ~FitScheduler();
+
+    // 同时运行的拟合任务数 (1 ~ CPU 核数)
+    void setWorkerBudget(int workers);
+    int workerBudget() const { return m_pool.maxThreadCount(); }
+    // 单个任务内部线程池的大小 (不含任务线程自身)
+    int threadsPerJob() const;
+
+    // 新的批次编号 (submit 的 group 参数)
+    int newGroup() { return ++m_lastGroup; }
+
+    /**
+     * @brief 提交一个拟合任务, task 在线程池中执行
+     * @param cancel 提交方持有的取消标记, 须保持有效直到 finishJob
+     * @param jobId 输出任务编号, 供之后调用 finishJob
+     */
+    QFuture<void> submit(QObject* owner, const QString& modelName, const std::function<void()>& task,
+                         CancellationToken* cancel, int group, int* jobId);
+    // 任务结束 (主线程调用); cancelled 为 true 时记为已取消
+    void finishJob(int jobId, double mse, bool cancelled);
+
+    void cancelJob(int jobId);
+    void cancelAll();
+    // 移除已结束的任务记录
+    void clearFinished();
+
+    QList<int> jobIds() const { return m_jobs.keys(); }
+    const Job* job(int jobId) const;
+    bool isActive(int jobId) const;
+    // 批次内的任务是否全部结束
+    bool groupFinished(int group) const;
+    QList<int> groupJobs(int group) const;
+
+    static QString stateName(JobState state);
+
+signals:
+    void jobChanged(int jobId);
+    void jobsCleared();
+
+private:
+    void markRunning(int jobId);
+
+    QThreadPool m_pool;
+    QMap<int, Job> m_jobs;
+    int m_lastId;
+    int m_lastGroup;
+};
+
+#endif // FITSCHEDULER_H
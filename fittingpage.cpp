@@ -1,24 +1,42 @@
 #include "fittingpage.h"
 #include "ui_fittingpage.h"
 #include "fittingwidget.h"
+#include "fitscheduler.h"
 #include "modelparameter.h"
 #include <QInputDialog>
 #include <QMessageBox>
 #include <QJsonArray>
+#include <QHeaderView>
+#include <QThread>
 #include <QDebug>
+#include <algorithm>
+#include <cmath>
 
 FittingPage::FittingPage(QWidget *parent) :
     QWidget(parent),
     ui(new Ui::FittingPage),
-    m_modelManager(nullptr)
+    m_modelManager(nullptr),
+    m_scheduler(new FitScheduler(this))
 {
     ui->setupUi(this);
 
     // [修改] 移除了 setStyleSheet，样式已移至 ui 文件
+
+    ui->spinWorkers->blockSignals(true);
+    ui->spinWorkers->setMaximum(qMax(1, QThread::idealThreadCount()));
+    ui->spinWorkers->setValue(m_scheduler->workerBudget());
+    ui->spinWorkers->blockSignals(false);
+    ui->tableJobs->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    ui->tableJobs->verticalHeader()->setVisible(false);
+    connect(m_scheduler, &FitScheduler::jobChanged, this, &FittingPage::onJobChanged);
+    connect(m_scheduler, &FitScheduler::jobsCleared, this, &FittingPage::refreshJobTable);
 }
 
 FittingPage::~FittingPage()
 {
+    // 各页析构时取消并等待自己的拟合任务, 须在调度器之前; 此时不再刷新任务表
+    disconnect(m_scheduler, nullptr, this, nullptr);
+    while(ui->tabWidget->count() > 0) delete ui->tabWidget->widget(0);
     delete ui;
 }
 
@@ -55,6 +73,7 @@ FittingWidget* FittingPage::createNewTab(const QString &name, const QJsonObject
 {
     FittingWidget* w = new FittingWidget(this);
     if(m_modelManager) w->setModelManager(m_modelManager);
+    w->setScheduler(m_scheduler);
 
     connect(w, &FittingWidget::sigRequestSave, this, &FittingPage::onChildRequestSave);
 
@@ -125,6 +144,7 @@ void FittingPage::on_btnRenameAnalysis_clicked()
     QString newName = QInputDialog::getText(this, "重命名", "请输入新的分析名称:", QLineEdit::Normal, oldName, &ok);
     if(ok && !newName.isEmpty()) {
         ui->tabWidget->setTabText(idx, newName);
+        refreshJobTable();
     }
 }
 
@@ -142,6 +162,7 @@ void FittingPage::on_btnDeleteAnalysis_clicked()
         QWidget* w = ui->tabWidget->widget(idx);
         ui->tabWidget->removeTab(idx);
         delete w;
+        refreshJobTable();
     }
 }
 
@@ -195,3 +216,97 @@ void FittingPage::onChildRequestSave()
     QMessageBox::information(this, "保存成功", "所有分析页的状态已保存到项目文件 (pwt) 中。");
 }
 
+
+void FittingPage::on_btnFitAllModels_clicked()
+{
+    FittingWidget* source = qobject_cast<FittingWidget*>(ui->tabWidget->currentWidget());
+    if(!source || !source->hasObservedData()) {
+        QMessageBox::warning(this, "提示", "请先在当前分析页加载观测数据并勾选被拟合参数。");
+        return;
+    }
+    QJsonObject state = source->getJsonState();
+    state.remove("uncertainty");
+
+    // 每个模型一页: 数据、权重与同名参数 (值、拟合勾选、上下限) 取自当前页, 各页的拟合作为同一批次排队
+    int group = m_scheduler->newGroup();
+    const ModelManager::ModelType types[] = { ModelManager::Model_1, ModelManager::Model_2, ModelManager::Model_3,
+                                              ModelManager::Model_4, ModelManager::Model_5, ModelManager::Model_6 };
+    for(ModelManager::ModelType type : types) {
+        FittingWidget* w = createNewTab(generateUniqueName(QString("对比%1-模型%2").arg(group).arg((int)type + 1)), state);
+        w->setModelType(type, true);
+        w->startFit(true, group);
+    }
+    ui->tabWidget->setCurrentWidget(source);
+}
+
+void FittingPage::on_spinWorkers_valueChanged(int value)
+{
+    m_scheduler->setWorkerBudget(value);
+}
+
+void FittingPage::on_btnCancelJob_clicked()
+{
+    QSet<int> rows;
+    for(QTableWidgetItem* item : ui->tableJobs->selectedItems()) rows.insert(item->row());
+    for(int row : rows) {
+        if(row >= 0 && row < m_jobRows.size()) m_scheduler->cancelJob(m_jobRows[row]);
+    }
+}
+
+void FittingPage::on_btnClearJobs_clicked()
+{
+    m_scheduler->clearFinished();
+}
+
+void FittingPage::on_tableJobs_cellDoubleClicked(int row, int column)
+{
+    Q_UNUSED(column);
+    if(row < 0 || row >= m_jobRows.size()) return;
+    const FitScheduler::Job* job = m_scheduler->job(m_jobRows[row]);
+    QWidget* w = job ? qobject_cast<QWidget*>(job->owner.data()) : nullptr;
+    if(w && ui->tabWidget->indexOf(w) >= 0) ui->tabWidget->setCurrentWidget(w);
+}
+
+void FittingPage::onJobChanged(int jobId)
+{
+    const FitScheduler::Job* job = m_scheduler->job(jobId);
+    if(job && job->group > 0 && !m_rankedGroups.contains(job->group) && m_scheduler->groupFinished(job->group))
+        rankGroup(job->group);
+    refreshJobTable();
+}
+
+void FittingPage::rankGroup(int group)
+{
+    m_rankedGroups.insert(group);
+    QList<const FitScheduler::Job*> ranked;
+    for(int id : m_scheduler->groupJobs(group)) {
+        const FitScheduler::Job* job = m_scheduler->job(id);
+        if(job && job->state == FitScheduler::Finished && std::isfinite(job->mse)) ranked.append(job);
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const FitScheduler::Job* a, const FitScheduler::Job* b) { return a->mse < b->mse; });
+    for(int k = 0; k < ranked.size(); ++k) m_jobRanks.insert(ranked[k]->id, k + 1);
+
+    if(ranked.isEmpty()) return;
+    QWidget* best = qobject_cast<QWidget*>(ranked.first()->owner.data());
+    if(best && ui->tabWidget->indexOf(best) >= 0) ui->tabWidget->setCurrentWidget(best);
+}
+
+void FittingPage::refreshJobTable()
+{
+    m_jobRows = m_scheduler->jobIds();
+    ui->tableJobs->setRowCount(m_jobRows.size());
+    for(int row = 0; row < m_jobRows.size(); ++row) {
+        const FitScheduler::Job* job = m_scheduler->job(m_jobRows[row]);
+        QWidget* owner = qobject_cast<QWidget*>(job->owner.data());
+        int tab = owner ? ui->tabWidget->indexOf(owner) : -1;
+        bool ended = job->state == FitScheduler::Finished || job->state == FitScheduler::Cancelled;
+        QStringList cells;
+        cells << (tab >= 0 ? ui->tabWidget->tabText(tab) : QString("(已删除)"))
+              << job->modelName
+              << FitScheduler::stateName(job->state)
+              << (ended && std::isfinite(job->mse) ? QString::number(job->mse, 'e', 3) : QString("-"))
+              << (ended ? QString::number(job->elapsedMs / 1000.0, 'f', 1) : QString("-"))
+              << (m_jobRanks.contains(job->id) ? QString::number(m_jobRanks[job->id]) : QString("-"));
+        for(int c = 0; c < cells.size(); ++c) ui->tableJobs->setItem(row, c, new QTableWidgetItem(cells[c]));
+    }
+}
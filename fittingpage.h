@@ -4,10 +4,12 @@
 #include <QWidget>
 #include <QJsonObject>
 #include <QTabWidget>
+#include <QSet>
 #include "modelmanager.h"
 
 // 前置声明
 class FittingWidget;
+class FitScheduler;
 
 namespace Ui {
 class FittingPage;
@@ -47,9 +49,30 @@ private slots:
     // 响应子页面发出的保存请求
     void onChildRequestSave();
 
+    // 以当前页的数据与参数为六个模型各建一页并提交拟合, 全部结束后按 MSE 排名
+    void on_btnFitAllModels_clicked();
+    void on_spinWorkers_valueChanged(int value);
+    void on_btnCancelJob_clicked();
+    void on_btnClearJobs_clicked();
+    // 双击任务行切换到对应的分析页
+    void on_tableJobs_cellDoubleClicked(int row, int column);
+    void onJobChanged(int jobId);
+
 private:
     Ui::FittingPage *ui;
     ModelManager* m_modelManager;
+    // 各分析页共用的拟合调度器 (工作线程预算与任务队列)
+    FitScheduler* m_scheduler;
+    // 任务表各行对应的任务编号
+    QList<int> m_jobRows;
+    // 已结束批次的排名 (任务编号 -> 名次, 无有效结果的任务不排名)
+    QMap<int, int> m_jobRanks;
+    QSet<int> m_rankedGroups;
+
+    // 按调度器中的任务重建任务表
+    void refreshJobTable();
+    // 批次全部结束后按 MSE 排名并切换到最优的分析页
+    void rankGroup(int group);
 
     // 创建一个新的拟合页的内部函数
     // name: 页签名称
@@ -3,8 +3,13 @@
 #include "pressurederivativecalculator.h"
 #include "modelparameter.h"
 #include "modelselect.h"
+#include "globalsearch.h"
+#include "datadecimation.h"
+#include "fitscheduler.h"
 
 #include <QtConcurrent>
+#include <QThread>
+#include <numeric>
 #include <QMessageBox>
 #include <QDebug>
 #include <cmath>
@@ -21,6 +26,10 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <atomic>
+#include <limits>
 #include <QBuffer>
 #include <Eigen/Dense>
 
@@ -69,6 +78,43 @@ FittingDataLoadDialog::FittingDataLoadDialog(const QList<QStringList>& previewDa
     connect(ok, &QPushButton::clicked, this, &FittingDataLoadDialog::validateSelection); connect(cancel, &QPushButton::clicked, this, &QDialog::reject);
     btns->addStretch(); btns->addWidget(ok); btns->addWidget(cancel); layout->addLayout(btns);
 }
+FittingCandidatesDialog::FittingCandidatesDialog(const QList<FitCandidate>& candidates, const QVector<CompositeParameters::Id>& fitIds, QWidget *parent) : QDialog(parent) {
+    setWindowTitle("全局搜索候选解"); resize(760, 360);
+
+    this->setStyleSheet(
+        "QDialog { background-color: #ffffff; color: #000000; font-family: 'Microsoft YaHei'; }"
+        "QLabel, QTableWidget { color: #000000; }"
+        "QTableWidget { gridline-color: #d0d0d0; border: 1px solid #c0c0c0; }"
+        "QHeaderView::section { background-color: #f0f0f0; border: 1px solid #d0d0d0; color: #000000; }"
+        );
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->addWidget(new QLabel(QString("找到 %1 个不同的极小值 (按 MSE 升序), 请选择一个应用到参数表:").arg(candidates.size()), this));
+
+    m_table = new QTableWidget(candidates.size(), 3 + fitIds.size(), this);
+    QStringList headers; headers << "MSE" << "迭代" << "来源";
+    for(CompositeParameters::Id id : fitIds) headers << CompositeParameters::keyOf(id);
+    m_table->setHorizontalHeaderLabels(headers);
+    for(int i=0; i<candidates.size(); ++i) {
+        const FitCandidate& c = candidates[i];
+        m_table->setItem(i, 0, new QTableWidgetItem(QString::number(c.mse, 'e', 3)));
+        m_table->setItem(i, 1, new QTableWidgetItem(QString::number(c.iterations)));
+        m_table->setItem(i, 2, new QTableWidgetItem(c.origin));
+        for(int j=0; j<fitIds.size(); ++j) m_table->setItem(i, 3 + j, new QTableWidgetItem(QString::number(c.params[fitIds[j]], 'g', 5)));
+    }
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows); m_table->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    if(!candidates.isEmpty()) m_table->selectRow(0);
+    m_table->setAlternatingRowColors(true); layout->addWidget(m_table);
+    connect(m_table, &QTableWidget::cellDoubleClicked, this, &QDialog::accept);
+
+    QHBoxLayout* btns = new QHBoxLayout; QPushButton* ok = new QPushButton("应用所选",this); QPushButton* cancel = new QPushButton("关闭",this);
+    connect(ok, &QPushButton::clicked, this, &QDialog::accept); connect(cancel, &QPushButton::clicked, this, &QDialog::reject);
+    btns->addStretch(); btns->addWidget(ok); btns->addWidget(cancel); layout->addLayout(btns);
+}
+int FittingCandidatesDialog::selectedIndex() const { return m_table->currentRow(); }
+
 void FittingDataLoadDialog::validateSelection() { if(m_comboTime->currentIndex()<0) return; accept(); }
 int FittingDataLoadDialog::getTimeColumnIndex() const { return m_comboTime->currentIndex(); }
 int FittingDataLoadDialog::getPressureColumnIndex() const { return m_comboPressure->currentIndex()-1; }
@@ -81,15 +127,58 @@ int FittingDataLoadDialog::getPressureDataType() const { return m_comboPressureT
 // FittingWidget 实现
 // ===========================================================================
 
+namespace {
+
+// 全局搜索展示的不同极小值个数
+const int kCandidateCount = 5;
+// 迭代显示的刷新间隔 (最高约 30 帧/秒)
+const int kUiFrameIntervalMs = 33;
+// 预览曲线的点数 (覆盖观测时间范围的对数均匀点)
+const int kPreviewPoints = 60;
+// 显示曲线超过该点数时按每十倍 kDisplayPointsPerDecade 点抽稀
+const int kDisplayPointLimit = 2000;
+const int kDisplayPointsPerDecade = 100;
+
+// 全局搜索的区间映射: 正区间且非 S / nf 时对数均匀 (与 LM 的对数参数化一致), 否则线性
+bool isLogBounded(CompositeParameters::Id id, double lo, double hi) {
+    return lo > 0.0 && hi > lo && id != CompositeParameters::S && id != CompositeParameters::Nf;
+}
+
+double fromUnit(CompositeParameters::Id id, double lo, double hi, double u) {
+    double v = isLogBounded(id, lo, hi) ? lo * std::pow(hi / lo, u) : lo + u * (hi - lo);
+    if(id == CompositeParameters::Nf) v = std::round(v);
+    return qBound(lo, v, qMax(lo, hi));
+}
+
+double toUnit(CompositeParameters::Id id, double lo, double hi, double v) {
+    if(hi <= lo) return 0.0;
+    double u = isLogBounded(id, lo, hi) ? std::log(qMax(v, lo) / lo) / std::log(hi / lo) : (v - lo) / (hi - lo);
+    return qBound(0.0, u, 1.0);
+}
+
+} // namespace
+
 FittingWidget::FittingWidget(QWidget *parent) :
     QWidget(parent),
     ui(new Ui::FittingWidget),
     m_modelManager(nullptr),
+    m_scheduler(nullptr),
+    m_jobId(0),
+    m_quietFinish(false),
+    m_lastFitMse(std::numeric_limits<double>::quiet_NaN()),
     m_plotTitle(nullptr),
     m_currentModelType(ModelManager::Model_1),
-    m_isFitting(false)
+    m_candidatesModelType(ModelManager::Model_1),
+    m_modelEvaluations(0),
+    m_isFitting(false),
+    m_analyticJacobian(true),
+    m_previewPending(false),
+    m_previewModelType(ModelManager::Model_1),
+    m_previewHighPrecision(false)
 {
     ui->setupUi(this);
+    m_jacobianPool.setMaxThreadCount(QThread::idealThreadCount());
+    on_comboFitMode_currentIndexChanged(ui->comboFitMode->currentIndex());
 
     ui->splitter->setSizes(QList<int>{420, 680});
     ui->splitter->setCollapsible(0, false);
@@ -106,6 +195,10 @@ FittingWidget::FittingWidget(QWidget *parent) :
     connect(this, &FittingWidget::sigIterationUpdated, this, &FittingWidget::onIterationUpdate, Qt::QueuedConnection);
     connect(this, &FittingWidget::sigProgress, ui->progressBar, &QProgressBar::setValue);
     connect(&m_watcher, &QFutureWatcher<void>::finished, this, &FittingWidget::onFitFinished);
+    m_uiTimer.setSingleShot(true);
+    m_uiTimer.setInterval(kUiFrameIntervalMs);
+    connect(&m_uiTimer, &QTimer::timeout, this, &FittingWidget::flushIterationUpdate);
+    connect(&m_previewWatcher, &QFutureWatcher<ModelCurveData>::finished, this, &FittingWidget::onPreviewFinished);
 
     connect(ui->sliderWeight, &QSlider::valueChanged, this, [this](int val){
         ui->spinWeight->blockSignals(true);
@@ -119,13 +212,25 @@ FittingWidget::FittingWidget(QWidget *parent) :
     });
 }
 
-FittingWidget::~FittingWidget() { delete ui; }
+FittingWidget::~FittingWidget() {
+    // 拟合线程引用本对象, 先取消再等待其退出; 仍在调度队列中的任务直接撤销
+    m_cancelToken.cancel();
+    m_fitFuture.cancel();
+    m_fitFuture.waitForFinished();
+    if(m_scheduler && m_jobId > 0) m_scheduler->finishJob(m_jobId, m_lastFitMse, true);
+    m_previewWatcher.waitForFinished();
+    delete ui;
+}
 
 void FittingWidget::setModelManager(ModelManager *m) {
     m_modelManager = m;
     initializeDefaultModel();
 }
 
+void FittingWidget::setScheduler(FitScheduler *scheduler) {
+    m_scheduler = scheduler;
+}
+
 void FittingWidget::updateBasicParameters() {
     // 预留接口
 }
@@ -179,6 +284,9 @@ QJsonObject FittingWidget::getJsonState() const
     obsData["derivative"] = derivArr;
     root["observedData"] = obsData;
 
+    // 参数不确定性 (协方差与自助区间)
+    if(!m_uncertainty.isEmpty()) root["uncertainty"] = m_uncertainty.toJson();
+
     return root;
 }
 
@@ -239,6 +347,8 @@ void FittingWidget::loadFittingState(const QJsonObject& root)
         setObservedData(t, p, d);
     }
 
+    m_uncertainty = root.contains("uncertainty") ? FitUncertainty::Result::fromJson(root["uncertainty"].toObject()) : FitUncertainty::Result();
+
     updateModelCurve();
 
     // [新增] 恢复图表视图范围 (必须在更新曲线后设置，否则会被自动缩放覆盖)
@@ -332,7 +442,46 @@ void FittingWidget::on_btnExportReport_clicked()
     }
     html += "</table>";
 
-    html += "<h2>5. 拟合曲线图</h2>";
+    int section = 5;
+    if(!m_uncertainty.isEmpty()) {
+        const FitUncertainty::Result& u = m_uncertainty;
+        html += QString("<h2>%1. 参数不确定性</h2>").arg(section++);
+        html += QString("<p>线性化区间由收敛点 J<sup>T</sup>J 的逆与残差方差给出 (自由度 %1, 条件数 %2, 对数参数在 log10 坐标下计算); ")
+                    .arg(u.dof).arg(u.conditionNumber, 0, 'e', 2);
+        html += QString("自助区间为 %1 次残差自助重拟合参数的 2.5% / 97.5% 分位数。</p>").arg(u.bootstrapCompleted);
+        html += "<table>";
+        html += "<tr><th>参数名称</th><th>符号</th><th>分析时的值</th><th>标准误差</th><th>95% 区间 (线性化)</th><th>95% 区间 (自助)</th></tr>";
+        QStringList symbols;
+        for(const auto& p : u.parameters) {
+            QString displayName = p.name, dummy, symbol, uniSym, unit;
+            getParamDisplayInfo(p.name, dummy, symbol, uniSym, unit);
+            for(const auto& fp : m_parameters) if(fp.name == p.name) displayName = fp.displayName;
+            symbols << uniSym;
+            QString se = std::isnan(p.standardError) ? QString("-") : QString::number(p.standardError, 'g', 3) + (p.logScale ? " (log10)" : "");
+            QString lin = std::isnan(p.standardError) ? QString("-") : QString("%1 ~ %2").arg(p.lower, 0, 'g', 4).arg(p.upper, 0, 'g', 4);
+            QString boot = std::isnan(p.bootstrapLower) ? QString("-") : QString("%1 ~ %2").arg(p.bootstrapLower, 0, 'g', 4).arg(p.bootstrapUpper, 0, 'g', 4);
+            html += "<tr><td>" + displayName + "</td><td>" + uniSym + "</td><td>" + QString::number(p.value, 'g', 6) + "</td><td>" + se + "</td><td>" + lin + "</td><td>" + boot + "</td></tr>";
+        }
+        html += "</table>";
+        if(u.correlation.size() == symbols.size() && !symbols.isEmpty()) {
+            html += "<p><strong>相关系数矩阵:</strong></p><table><tr><th></th>";
+            for(const QString& s : symbols) html += "<th>" + s + "</th>";
+            html += "</tr>";
+            for(int i=0; i<symbols.size(); ++i) {
+                html += "<tr><th>" + symbols[i] + "</th>";
+                for(int j=0; j<u.correlation[i].size(); ++j) {
+                    double c = u.correlation[i][j];
+                    // |ρ| > 0.9 的参数对难以独立确定, 加粗标出
+                    QString cell = std::isnan(c) ? QString("-") : QString::number(c, 'f', 3);
+                    html += (i != j && std::abs(c) > 0.9) ? "<td><strong>" + cell + "</strong></td>" : "<td>" + cell + "</td>";
+                }
+                html += "</tr>";
+            }
+            html += "</table>";
+        }
+    }
+
+    html += QString("<h2>%1. 拟合曲线图</h2>").arg(section);
     QString imgBase64 = getPlotImageBase64();
     if(!imgBase64.isEmpty()) {
         html += "<div style='text-align:center;'><img src='data:image/png;base64," + imgBase64 + "' width='600' /></div>";
@@ -391,44 +540,35 @@ void FittingWidget::on_btn_modelSelect_clicked() {
 
         if (found) {
             // [修改] 切换模型时保留原有的参数值
-
-            // 1. 先确保 m_parameters 中存储的是当前界面上最新的值
-            updateParamsFromTable();
-
-            // 2. 将旧参数值暂存到 Map 中
-            QMap<QString, double> oldValues;
-            for(const auto& p : m_parameters) {
-                oldValues.insert(p.name, p.value);
-            }
-
-            // 3. 切换模型类型
-            m_currentModelType = newType;
+            setModelType(newType);
             ui->btn_modelSelect->setText("当前: " + name);
-
-            // 4. 重置参数列表（这会加载新模型的参数结构和默认值）
-            on_btnResetParams_clicked();
-
-            // 5. 遍历新参数列表，如果旧参数中有同名参数，则恢复旧值
-            bool restoredAny = false;
-            for(int i = 0; i < m_parameters.size(); ++i) {
-                if(oldValues.contains(m_parameters[i].name)) {
-                    m_parameters[i].value = oldValues[m_parameters[i].name];
-                    // 这里只恢复了 value
-                    restoredAny = true;
-                }
-            }
-
-            // 6. 如果有参数被恢复，需要刷新表格和曲线
-            if(restoredAny) {
-                loadParamsToTable(); // 刷新表格显示
-                updateModelCurve();  // 刷新曲线
-            }
         } else {
             QMessageBox::warning(this, "提示", "所选组合暂无对应的 ModelWidget 实现接口。\nCode: " + code);
         }
     }
 }
 
+void FittingWidget::setModelType(ModelManager::ModelType type, bool keepFitSettings) {
+    // 先确保 m_parameters 中存储的是当前界面上最新的值, 暂存后按新模型的参数结构重置
+    updateParamsFromTable();
+    QMap<QString, FitParameter> oldParams;
+    bool anyFit = false;
+    for(const auto& p : m_parameters) { oldParams.insert(p.name, p); anyFit = anyFit || p.isFit; }
+
+    m_currentModelType = type;
+    ui->btn_modelSelect->setText("当前: " + ModelManager::getModelTypeName(type));
+    on_btnResetParams_clicked();
+
+    for(auto& p : m_parameters) {
+        auto it = oldParams.constFind(p.name);
+        if(it == oldParams.constEnd()) { if(keepFitSettings && anyFit) p.isFit = true; continue; }
+        p.value = it->value;
+        if(keepFitSettings) { p.isFit = it->isFit; p.min = it->min; p.max = it->max; }
+    }
+    loadParamsToTable();
+    updateModelCurve();
+}
+
 void FittingWidget::setupPlot() {
     m_plot->setInteractions(QCP::iRangeDrag | QCP::iRangeZoom);
     m_plot->setBackground(Qt::white); m_plot->axisRect()->setBackground(Qt::white);
@@ -537,39 +677,9 @@ void FittingWidget::getParamDisplayInfo(const QString& key, QString& outName, QS
 }
 
 QStringList FittingWidget::getParamOrder(ModelManager::ModelType type) {
+    // 参数及顺序由模型的参数表给出 (基础参数 + 模型参数; 封闭/定压边界有 reD, 变井储有 cD, S)
     QStringList order;
-    // 基础参数 (所有模型通用)
-    order << "phi" << "h" << "mu" << "B" << "Ct" << "q" << "nf";
-
-    // 模型 1 (Infinite, Changing): 变井储，有 cD, S
-    if (type == ModelManager::Model_1) {
-        order << "kf" << "km" << "L" << "Lf" << "rmD" << "omega1" << "omega2" << "lambda1" << "gamaD" << "cD" << "S";
-    }
-    // 模型 2 (Infinite, Constant): 恒定井储，无 cD, S
-    else if (type == ModelManager::Model_2) {
-        order << "kf" << "km" << "L" << "Lf" << "rmD" << "omega1" << "omega2" << "lambda1" << "gamaD";
-    }
-    // 模型 3 (Closed, Changing): 封闭边界+变井储，有 cD, S, reD
-    else if (type == ModelManager::Model_3) {
-        order << "kf" << "km" << "L" << "Lf" << "rmD" << "omega1" << "omega2" << "lambda1" << "gamaD" << "reD" << "cD" << "S";
-    }
-    // 模型 4 (Closed, Constant): 封闭边界+恒定井储，有 reD, 无 cD, S
-    else if (type == ModelManager::Model_4) {
-        order << "kf" << "km" << "L" << "Lf" << "rmD" << "omega1" << "omega2" << "lambda1" << "gamaD" << "reD";
-    }
-    // 模型 5 (ConstPressure, Changing): 定压边界+变井储，有 cD, S, reD
-    else if (type == ModelManager::Model_5) {
-        order << "kf" << "km" << "L" << "Lf" << "rmD" << "omega1" << "omega2" << "lambda1" << "gamaD" << "reD" << "cD" << "S";
-    }
-    // 模型 6 (ConstPressure, Constant): 定压边界+恒定井储，有 reD, 无 cD, S
-    else if (type == ModelManager::Model_6) {
-        order << "kf" << "km" << "L" << "Lf" << "rmD" << "omega1" << "omega2" << "lambda1" << "gamaD" << "reD";
-    }
-    else {
-        // 默认 fallback
-        order << "kf" << "km" << "L" << "Lf" << "rmD" << "omega1" << "omega2" << "lambda1" << "cD" << "S";
-    }
-
+    for (CompositeParameters::Id id : CompositeModel::parameterSchema(type)) order << CompositeParameters::keyOf(id);
     return order;
 }
 
@@ -725,23 +835,134 @@ void FittingWidget::on_btnLoadData_clicked() {
     setObservedData(t, p, d);
 }
 
-void FittingWidget::on_btnRunFit_clicked() {
-    if(m_isFitting) return;
-    if(m_obsTime.isEmpty()) { QMessageBox::warning(this,"错误","请先加载观测数据。"); return; }
+void FittingWidget::on_btnRunFit_clicked() { startFit(); }
+
+bool FittingWidget::startFit(bool quiet, int group) {
+    if(m_isFitting || !m_modelManager) return false;
+    if(m_obsTime.isEmpty()) { if(!quiet) QMessageBox::warning(this,"错误","请先加载观测数据。"); return false; }
     updateParamsFromTable();
-    m_isFitting = true; m_stopRequested = false; ui->btnRunFit->setEnabled(false);
+    m_isFitting = true; ui->btnRunFit->setEnabled(false);
+    m_cancelToken.reset();
+    qint64 limitMs = qint64(ui->spinTimeLimit->value()) * 1000;
+    m_fitCandidates.clear(); ui->btnCandidates->setEnabled(false);
+    m_fitReport.clear();
+    m_uncertainty = FitUncertainty::Result();
 
     ModelManager::ModelType modelType = m_currentModelType;
     QList<FitParameter> paramsCopy = m_parameters;
     double w = ui->spinWeight->value();
-    (void)QtConcurrent::run([this, modelType, paramsCopy, w](){ runOptimizationTask(modelType, paramsCopy, w); });
+    FitSettings settings;
+    settings.mode = ui->comboFitMode->currentIndex();
+    settings.searchSize = ui->spinSearchSize->value();
+    settings.multiResolution = ui->checkMultiResolution->isChecked();
+    settings.pointsPerDecade = ui->spinDensity->value();
+    settings.quasiNewton = ui->checkQuasiNewton->isChecked();
+    settings.jacobianRefresh = ui->spinJacobianRefresh->value();
+    settings.uncertainty = ui->checkUncertainty->isChecked();
+    settings.bootstrapCount = ui->spinBootstrap->value();
+    m_quietFinish = quiet;
+    m_lastFitMse = std::numeric_limits<double>::quiet_NaN();
+
+    if(!m_fitModel || m_fitModel->type() != modelType) m_fitModel.reset(new CompositeModel(modelType));
+    m_fitModel->setEvaluationOptions(m_modelManager->getEvaluationOptions(modelType));
+
+    // 时限从任务开始运行时计起, 不含在调度队列中等待的时间
+    auto task = [this, modelType, paramsCopy, w, settings, limitMs](){
+        if(limitMs > 0) m_cancelToken.setDeadline(limitMs);
+        runOptimizationTask(modelType, paramsCopy, w, settings);
+    };
+    if(m_scheduler) {
+        // 页内并行度按调度器的预算划分; 拟合中的全部并行求值都在 m_jacobianPool 中 (见 fitOptions.pool),
+        // 不使用全局线程池, 多页同时拟合时总线程数不超过核数
+        m_jacobianPool.setMaxThreadCount(m_scheduler->threadsPerJob());
+        m_fitFuture = m_scheduler->submit(this, ModelManager::getModelTypeName(modelType), task, &m_cancelToken, group, &m_jobId);
+    } else {
+        m_jacobianPool.setMaxThreadCount(QThread::idealThreadCount());
+        m_fitFuture = QtConcurrent::run(task);
+    }
+    return true;
+}
+
+void FittingWidget::runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight, const FitSettings& settings) {
+    if(settings.mode == FitLocal) runLevenbergMarquardtOptimization(modelType, fitParams, weight, settings);
+    else runGlobalOptimization(modelType, fitParams, weight, settings);
+}
+
+void FittingWidget::on_comboFitMode_currentIndexChanged(int index) {
+    // 多起点时为起点数 (含表中当前值), 差分进化时为进化代数; 局部拟合不使用
+    ui->label_SearchSize->setText(index == FitDifferentialEvolution ? "进化代数:" : "起点数:");
+    ui->spinSearchSize->setEnabled(index != FitLocal);
+    // 分级拟合只用于局部拟合
+    ui->checkMultiResolution->setEnabled(index == FitLocal);
+    ui->spinDensity->setEnabled(index == FitLocal);
 }
 
-void FittingWidget::runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight) {
-    runLevenbergMarquardtOptimization(modelType, fitParams, weight);
+void FittingWidget::on_btnCandidates_clicked() {
+    using P = CompositeParameters;
+    if(m_isFitting || m_fitCandidates.isEmpty()) return;
+    if(m_candidatesModelType != m_currentModelType) { QMessageBox::warning(this, "提示", "候选解属于之前选择的模型，请重新拟合。"); return; }
+    FittingCandidatesDialog dlg(m_fitCandidates, m_candidatesFitIds, this);
+    if(dlg.exec() != QDialog::Accepted) return;
+    int k = dlg.selectedIndex();
+    if(k < 0 || k >= m_fitCandidates.size()) return;
+    const FitCandidate& c = m_fitCandidates[k];
+    updateParamsFromTable();
+    for(auto& p : m_parameters) {
+        P::Id id = P::idOf(p.name);
+        if(m_candidatesFitIds.contains(id)) p.value = c.params[id];
+    }
+    loadParamsToTable();
+    updateModelCurve();
+    ui->label_Error->setText(QString("误差(MSE): %1").arg(c.mse, 0, 'e', 3));
 }
 
-void FittingWidget::on_btnStop_clicked() { m_stopRequested=true; }
+void FittingWidget::on_btnStop_clicked() { m_cancelToken.cancel(); }
+
+void FittingWidget::on_btnAtlasSeed_clicked() {
+    using P = CompositeParameters;
+    if(m_isFitting) return;
+    if(m_obsTime.isEmpty()) { QMessageBox::warning(this,"错误","请先加载观测数据。"); return; }
+    std::shared_ptr<const TypeCurveAtlas> atlas = TypeCurveAtlas::shared(m_currentModelType);
+    if(!atlas) {
+        QMessageBox::information(this, "图版初值", QString("未找到当前模型的图版文件:\n%1\n\n可用 welltest_cli --build-atlas <目录> [参数文件] 生成, 再放到程序目录 atlas/ 下。").arg(TypeCurveAtlas::defaultFileName(m_currentModelType)));
+        return;
+    }
+    updateParamsFromTable();
+    QVector<int> fitIndices;
+    QVector<P::Id> fitIds;
+    P current;
+    if(!resolveFitParameters(m_parameters, fitIndices, fitIds, current)) { QMessageBox::information(this, "图版初值", "没有被拟合的参数。"); return; }
+    if(!atlas->covers(current)) { QMessageBox::information(this, "图版初值", "图版的 kf/km、Lf/L 与裂缝条数与当前参数不一致, 请用 welltest_cli --build-atlas <目录> [参数文件] 以当前参数重新生成图版。"); return; }
+
+    QElapsedTimer timer; timer.start();
+    QVector<TypeCurveAtlas::Match> matches = atlas->bestMatches(m_obsTime, m_obsPressure, m_obsDerivative, ui->spinWeight->value(), current, fitIds, 1);
+    if(matches.isEmpty()) { QMessageBox::information(this, "图版初值", "观测时间大部分超出图版的 tD 范围, 未找到匹配。"); return; }
+    // 只改被拟合的参数, 并截断到参数区间
+    const P& best = matches.first().params;
+    // 图版匹配把 kf、km 乘以同一倍数 (保持图版的 M12): 先把倍数限制在两者区间的交集内再应用,
+    // 避免只有一个参数被截断而改变 kf/km 比值; 交集为空时无法保持比值, 只能各自截断
+    int kfIndex = fitIds.indexOf(P::Kf), kmIndex = fitIds.indexOf(P::Km);
+    bool shiftK = kfIndex >= 0 && kmIndex >= 0 && current[P::Kf] > 0.0 && current[P::Km] > 0.0;
+    double factor = 1.0;
+    if(shiftK) {
+        const FitParameter& kf = m_parameters[fitIndices[kfIndex]];
+        const FitParameter& km = m_parameters[fitIndices[kmIndex]];
+        double lo = qMax(kf.min / current[P::Kf], km.min / current[P::Km]);
+        double hi = qMin(kf.max / current[P::Kf], km.max / current[P::Km]);
+        factor = best[P::Kf] / current[P::Kf];
+        if(lo <= hi) factor = qBound(lo, factor, hi);
+        else shiftK = false;
+    }
+    for(int k=0; k<fitIndices.size(); ++k) {
+        FitParameter& fp = m_parameters[fitIndices[k]];
+        double value = best[fitIds[k]];
+        if(shiftK && (fitIds[k] == P::Kf || fitIds[k] == P::Km)) value = current[fitIds[k]] * factor;
+        fp.value = qBound(fp.min, value, fp.max);
+    }
+    qDebug() << "图版初值: 节点" << atlas->nodeCount() << ", MSE" << matches.first().mse << "," << timer.elapsed() << "ms";
+    loadParamsToTable();
+    updateModelCurve();
+}
 void FittingWidget::on_btnImportModel_clicked() { updateModelCurve(); }
 
 void FittingWidget::on_btnExportData_clicked() {
@@ -811,33 +1032,144 @@ void FittingWidget::updateModelCurve() {
     if(targetT.isEmpty()) { for(double e = -4; e <= 4; e += 0.1) targetT.append(pow(10, e)); }
     ModelCurveData res = m_modelManager->calculateTheoreticalCurve(type, currentParams, targetT);
     onIterationUpdate(0, currentParams, std::get<0>(res), std::get<1>(res), std::get<2>(res));
+    flushIterationUpdate();
 }
 
-void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight) {
-    if(m_modelManager) m_modelManager->setHighPrecision(false);
+void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitSettings& settings) {
+    using P = CompositeParameters;
+    m_fitModel->resetCacheStatistics();
+    // 迭代过程使用低精度反演; 以选项传入而不是切换模型的全局状态, 界面上的并发计算不受影响
+    // 按时间点并行反演 (残差与解析雅可比) 使用本页的线程池, 受调度器的线程预算约束
+    ModelEvaluationOptions fitOptions = m_fitModel->evaluationOptions();
+    fitOptions.highPrecision = false;
+    fitOptions.pool = &m_jacobianPool;
+    fitOptions.cancel = &m_cancelToken;
     QVector<int> fitIndices;
-    for(int i=0; i<params.size(); ++i) if(params[i].isFit) fitIndices.append(i);
-    int nParams = fitIndices.size();
-    if(nParams == 0) { QMetaObject::invokeMethod(this, "onFitFinished"); return; }
+    QVector<P::Id> fitIds;
+    P start;
+    if(!resolveFitParameters(params, fitIndices, fitIds, start)) { QMetaObject::invokeMethod(this, "onFitFinished"); return; }
+
+    // 分级: 首级每十倍 pointsPerDecade 个点, 之后每级 x4, 子集超过全部数据一半时直接进入全分辨率精修
+    FitObservations full{m_obsTime, m_obsPressure, m_obsDerivative};
+    QList<FitObservations> stages;
+    if(settings.multiResolution) {
+        for(int density = qMax(1, settings.pointsPerDecade); ; density *= 4) {
+            QVector<int> idx = DataDecimation::logUniformIndices(full.t, density);
+            if(idx.isEmpty() || idx.size() * 2 > full.t.size()) break;
+            stages.append(FitObservations{DataDecimation::take(full.t, idx), DataDecimation::take(full.p, idx), DataDecimation::take(full.d, idx)});
+        }
+    }
+    stages.append(full);
+
+    FitCandidate fit;
+    fit.params = start;
+    for(int s=0; s<stages.size(); ++s) {
+        if(s > 0 && m_cancelToken.isCancelled()) break;
+        QElapsedTimer timer; timer.start();
+        int evalBefore = m_modelEvaluations;
+        FitCandidate stageFit = levenbergMarquardt(params, fitIndices, fitIds, fit.params, stages[s], weight, fitOptions, settings, true);
+        // 本级的首次求值即被取消时没有有效结果, 保留上一级
+        if(s > 0 && std::isnan(stageFit.mse)) break;
+        fit = stageFit;
+        QString name = (s + 1 == stages.size()) ? QString("全分辨率") : QString("第 %1 级").arg(s + 1);
+        QString line = QString("%1: %2 点, %3 次迭代, %4 次模型求值 (雅可比 %5 次全量 / %6 次 Broyden), %7 ms, SSE = %8")
+                .arg(name).arg(stages[s].t.size()).arg(fit.iterations).arg(m_modelEvaluations - evalBefore)
+                .arg(fit.jacobianEvaluations).arg(fit.broydenUpdates)
+                .arg(timer.elapsed()).arg(fit.sse, 0, 'e', 3);
+        m_fitReport.append(line);
+        qDebug() << "分级拟合" << line;
+    }
+    if(m_cancelToken.deadlineExpired()) m_fitReport.append("已到达时限, 返回当前最优结果。");
+    if(settings.uncertainty && !m_cancelToken.isCancelled() && !std::isnan(fit.mse)) {
+        QElapsedTimer timer; timer.start();
+        FitUncertainty::Result uncertainty = analyzeUncertainty(params, fitIndices, fitIds, fit, full, weight, fitOptions, settings);
+        m_fitReport.append(QString("不确定性分析: 自助重拟合 %1 / %2 次, 条件数 %3, %4 ms")
+                .arg(uncertainty.bootstrapCompleted).arg(uncertainty.bootstrapRequested)
+                .arg(uncertainty.conditionNumber, 0, 'e', 2).arg(timer.elapsed()));
+        for(const FitUncertainty::ParameterInterval& p : uncertainty.parameters) {
+            QString line = QString("  %1 = %2, 95% 区间 [%3, %4]").arg(p.name).arg(p.value, 0, 'g', 5).arg(p.lower, 0, 'g', 4).arg(p.upper, 0, 'g', 4);
+            if(uncertainty.bootstrapCompleted > 0) line += QString(", 自助 [%1, %2]").arg(p.bootstrapLower, 0, 'g', 4).arg(p.bootstrapUpper, 0, 'g', 4);
+            m_fitReport.append(line);
+        }
+        // 排队到主线程写入, 在 onFitFinished 之前执行 (getJsonState 在主线程读取)
+        QMetaObject::invokeMethod(this, [this, uncertainty]() { m_uncertainty = uncertainty; }, Qt::QueuedConnection);
+    }
+    {
+        LaplaceCacheStats st = m_fitModel->cacheStatistics();
+        qDebug() << "Laplace 缓存统计: pf 命中" << st.pfHits << "/ 未命中" << st.pfMisses
+                 << ", 前置因子命中" << st.prefactorHits << "/ 未命中" << st.prefactorMisses
+                 << ", 积分核求值" << m_fitModel->quadratureEvaluations();
+    }
+    // 显示最后一次残差求值的曲线, 高精度曲线在后台以少量预览点补算
+    emit sigIterationUpdated(fit.mse, fit.params.toMap(), std::get<0>(fit.curve), std::get<1>(fit.curve), std::get<2>(fit.curve));
+    P finalParams = fit.params;
+    QMetaObject::invokeMethod(this, [this, modelType, finalParams]() { requestPreview(modelType, finalParams, true); }, Qt::QueuedConnection);
+    m_lastFitMse = fit.mse;
+    QMetaObject::invokeMethod(this, "onFitFinished");
+}
+
+bool FittingWidget::resolveFitParameters(const QList<FitParameter>& params, QVector<int>& fitIndices, QVector<CompositeParameters::Id>& fitIds, CompositeParameters& start) {
+    using P = CompositeParameters;
+    // 参数键名在拟合开始时解析一次, 迭代中按下标读写 (试探步与雅可比各列只复制定长数组)
+    fitIndices.clear(); fitIds.clear();
+    for(int i=0; i<params.size(); ++i) {
+        P::Id id = P::idOf(params[i].name);
+        if(params[i].isFit && id != P::Invalid) { fitIndices.append(i); fitIds.append(id); }
+    }
+    QMap<QString, double> initialMap;
+    for(const auto& p : params) initialMap.insert(p.name, p.value);
+    start = P::fromMap(initialMap);
+    start.syncDerived();
+    return !fitIds.isEmpty();
+}
+
+FitCandidate FittingWidget::levenbergMarquardt(const QList<FitParameter>& params, const QVector<int>& fitIndices, const QVector<CompositeParameters::Id>& fitIds, const CompositeParameters& start, const FitObservations& obs, double weight, const ModelEvaluationOptions& fitOptions, const FitSettings& settings, bool report) {
+    using P = CompositeParameters;
+    int nParams = fitIds.size();
     double lambda = 0.01; int maxIter = 50; double currentSSE = 1e15;
-    QMap<QString, double> currentParamMap;
-    for(const auto& p : params) currentParamMap.insert(p.name, p.value);
-    if(currentParamMap.contains("L") && currentParamMap.contains("Lf") && currentParamMap["L"] > 1e-9)
-        currentParamMap["LfD"] = currentParamMap["Lf"] / currentParamMap["L"];
-    QVector<double> residuals = calculateResiduals(currentParamMap, modelType, weight);
+    P current = start;
+    current.syncDerived();
+    // 残差求值同时保留观测时间点上的曲线, 迭代显示直接复用, 不再额外反演
+    ModelCurveData currentCurve;
+    QVector<double> residuals = calculateResiduals(current, obs, weight, fitOptions, &currentCurve);
     currentSSE = calculateSumSquaredError(residuals);
-    ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
-    for(int iter = 0; iter < maxIter; ++iter) {
-        if(m_stopRequested) break;
+    if(report) emit sigIterationUpdated(currentSSE/residuals.size(), current.toMap(), std::get<0>(currentCurve), std::get<1>(currentCurve), std::get<2>(currentCurve));
+    // 拟牛顿模式: 雅可比在接受的步上做 Broyden 秩一更新, 每 jacobianRefresh 次迭代或进展停滞时才全量重算;
+    // 试探步加测地加速修正 (沿速度方向的二阶方向导数由一次额外的残差求值差分得到)
+    const bool quasiNewton = settings.quasiNewton;
+    const int refreshInterval = qMax(1, settings.jacobianRefresh);
+    QVector<QVector<double>> J;
+    bool jacobianFresh = false;
+    bool forceRefresh = true;
+    int sinceRefresh = 0;
+    int jacobianEvaluations = 0, broydenUpdates = 0;
+    // 参数化: 对数参数以 log10 为坐标 (与雅可比各列一致)
+    auto isLogParam = [&](const P& p, int i) { P::Id id = fitIds[i]; return p[id] > 1e-12 && id != P::S && id != P::Nf; };
+    auto applyStep = [&](const QVector<double>& delta) {
+        P trial = current;
+        for(int i=0; i<nParams; ++i) {
+            int pIdx = fitIndices[i]; P::Id id = fitIds[i]; double oldVal = current[id];
+            double newVal; if(isLogParam(current, i)) { double logVal = log10(oldVal) + delta[i]; newVal = pow(10.0, logVal); } else { newVal = oldVal + delta[i]; }
+            newVal = qMax(params[pIdx].min, qMin(newVal, params[pIdx].max));
+            trial[id] = newVal;
+        }
+        trial.syncDerived();
+        return trial;
+    };
+    int iter = 0;
+    for(; iter < maxIter; ++iter) {
+        if(m_cancelToken.isCancelled()) break;
 
         // [新增] 检查 MSE 是否小于阈值 (3e-3)，如果是则提前停止
-        if (!residuals.isEmpty() && (currentSSE / residuals.size()) < 3e-3) {
+        if (!residuals.isEmpty() && (currentSSE / residuals.size()) < settings.mseTolerance) {
             break;
         }
 
-        emit sigProgress(iter * 100 / maxIter);
-        QVector<QVector<double>> J = computeJacobian(currentParamMap, residuals, fitIndices, modelType, params, weight);
+        if(report) emit sigProgress(iter * 100 / maxIter);
+        if(!quasiNewton || forceRefresh || sinceRefresh >= refreshInterval || J.size() != residuals.size()) {
+            J = computeJacobian(current, residuals, obs, fitIds, weight, fitOptions);
+            ++jacobianEvaluations; sinceRefresh = 0; jacobianFresh = true; forceRefresh = false;
+        }
         int nRes = residuals.size();
         QVector<QVector<double>> H(nParams, QVector<double>(nParams, 0.0));
         QVector<double> g(nParams, 0.0);
@@ -849,75 +1181,373 @@ void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType mo
         }
         for(int i=0; i<nParams; ++i) for(int j=i+1; j<nParams; ++j) H[i][j] = H[j][i];
         bool stepAccepted = false;
+        double previousSSE = currentSSE;
         for(int tryIter=0; tryIter<5; ++tryIter) {
             QVector<QVector<double>> H_lm = H;
             for(int i=0; i<nParams; ++i) H_lm[i][i] += lambda * (1.0 + std::abs(H[i][i]));
             QVector<double> negG(nParams); for(int i=0;i<nParams;++i) negG[i] = -g[i];
             QVector<double> delta = solveLinearSystem(H_lm, negG);
-            QMap<QString, double> trialMap = currentParamMap;
-            for(int i=0; i<nParams; ++i) {
-                int pIdx = fitIndices[i]; QString pName = params[pIdx].name; double oldVal = currentParamMap[pName];
-                bool isLog = (oldVal > 1e-12 && pName != "S" && pName != "nf");
-                double newVal; if(isLog) { double logVal = log10(oldVal) + delta[i]; newVal = pow(10.0, logVal); } else { newVal = oldVal + delta[i]; }
-                newVal = qMax(params[pIdx].min, qMin(newVal, params[pIdx].max));
-                trialMap[pName] = newVal;
+            if(quasiNewton) {
+                // 测地加速: r_vv ≈ 2/h [(r(x+hv) - r(x))/h - Jv], a = -(H+λD)^-1 J^T r_vv;
+                // |a|/|v| 过大 (2|a|/|v| > 0.75) 时二阶项不可信, 只用速度
+                const double h = 0.1;
+                QVector<double> hv(nParams); for(int i=0; i<nParams; ++i) hv[i] = h * delta[i];
+                QVector<double> rh = calculateResiduals(applyStep(hv), obs, weight, fitOptions);
+                if(rh.size() == nRes) {
+                    QVector<double> jtrvv(nParams, 0.0);
+                    for(int k=0; k<nRes; ++k) {
+                        double jv = 0.0; for(int i=0; i<nParams; ++i) jv += J[k][i] * delta[i];
+                        double rvv = 2.0 / h * ((rh[k] - residuals[k]) / h - jv);
+                        for(int i=0; i<nParams; ++i) jtrvv[i] -= J[k][i] * rvv;
+                    }
+                    QVector<double> accel = solveLinearSystem(H_lm, jtrvv);
+                    double na = 0.0, nv = 0.0;
+                    for(int i=0; i<nParams; ++i) { na += accel[i] * accel[i]; nv += delta[i] * delta[i]; }
+                    if(nv > 0.0 && 2.0 * std::sqrt(na / nv) <= 0.75) {
+                        for(int i=0; i<nParams; ++i) delta[i] += 0.5 * accel[i];
+                    }
+                }
             }
-            if(trialMap.contains("L") && trialMap.contains("Lf") && trialMap["L"] > 1e-9) trialMap["LfD"] = trialMap["Lf"] / trialMap["L"];
-            QVector<double> newRes = calculateResiduals(trialMap, modelType, weight);
+            P trial = applyStep(delta);
+            ModelCurveData trialCurve;
+            QVector<double> newRes = calculateResiduals(trial, obs, weight, fitOptions, &trialCurve);
             double newSSE = calculateSumSquaredError(newRes);
             if(newSSE < currentSSE) {
-                currentSSE = newSSE; currentParamMap = trialMap; residuals = newRes; lambda /= 10.0; stepAccepted = true;
-                ModelCurveData iterCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-                emit sigIterationUpdated(currentSSE/nRes, currentParamMap, std::get<0>(iterCurve), std::get<1>(iterCurve), std::get<2>(iterCurve));
+                if(quasiNewton && newRes.size() == nRes) {
+                    // Broyden: J += (Δr - J Δx) Δx^T / (Δx^T Δx), Δx 取截断到边界后的实际步长
+                    QVector<double> dx(nParams);
+                    double dxx = 0.0;
+                    for(int i=0; i<nParams; ++i) {
+                        P::Id id = fitIds[i];
+                        dx[i] = isLogParam(current, i) ? log10(trial[id]) - log10(current[id]) : trial[id] - current[id];
+                        dxx += dx[i] * dx[i];
+                    }
+                    if(dxx > 0.0) {
+                        for(int k=0; k<nRes; ++k) {
+                            double jdx = 0.0; for(int i=0; i<nParams; ++i) jdx += J[k][i] * dx[i];
+                            double c = (newRes[k] - residuals[k] - jdx) / dxx;
+                            for(int i=0; i<nParams; ++i) J[k][i] += c * dx[i];
+                        }
+                        ++broydenUpdates;
+                    }
+                }
+                currentSSE = newSSE; current = trial; residuals = newRes; currentCurve = trialCurve; lambda /= 10.0; stepAccepted = true;
+                if(report) emit sigIterationUpdated(currentSSE/nRes, current.toMap(), std::get<0>(currentCurve), std::get<1>(currentCurve), std::get<2>(currentCurve));
                 break;
             } else { lambda *= 10.0; }
         }
+        if(quasiNewton) {
+            ++sinceRefresh;
+            // 更新后的雅可比给不出下降或下降很小: 下一次迭代全量重算, 而不是直接结束
+            bool stalled = !stepAccepted || (previousSSE - currentSSE) < 1e-4 * previousSSE;
+            if(stalled && !jacobianFresh) { forceRefresh = true; continue; }
+            jacobianFresh = false;
+        }
         if(!stepAccepted && lambda > 1e10) break;
     }
-    if(m_modelManager) m_modelManager->setHighPrecision(true);
-    if(currentParamMap.contains("L") && currentParamMap.contains("Lf") && currentParamMap["L"] > 1e-9)
-        currentParamMap["LfD"] = currentParamMap["Lf"] / currentParamMap["L"];
-    ModelCurveData finalCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(finalCurve), std::get<1>(finalCurve), std::get<2>(finalCurve));
+    FitCandidate result;
+    result.params = current;
+    result.mse = residuals.isEmpty() ? std::numeric_limits<double>::quiet_NaN() : currentSSE / residuals.size();
+    result.sse = currentSSE;
+    result.curve = currentCurve;
+    result.iterations = iter;
+    result.jacobianEvaluations = jacobianEvaluations;
+    result.broydenUpdates = broydenUpdates;
+    return result;
+}
+
+FitUncertainty::Result FittingWidget::analyzeUncertainty(const QList<FitParameter>& params, const QVector<int>& fitIndices, const QVector<CompositeParameters::Id>& fitIds, const FitCandidate& fit, const FitObservations& obs, double weight, const ModelEvaluationOptions& fitOptions, const FitSettings& settings) {
+    using P = CompositeParameters;
+    int nParams = fitIds.size();
+    // 协方差取收敛点的全量雅可比 (拟牛顿模式的 Broyden 近似不用于统计)
+    ModelCurveData curve;
+    QVector<double> residuals = calculateResiduals(fit.params, obs, weight, fitOptions, &curve);
+    QVector<QVector<double>> J = computeJacobian(fit.params, residuals, obs, fitIds, weight, fitOptions);
+    FitUncertainty::Covariance cov = FitUncertainty::covarianceFromJacobian(J, residuals);
+
+    // 残差自助: 合成观测 = 拟合曲线 x exp(有放回抽取的对数残差), 压力与导数各自抽样;
+    // 每次重拟合从收敛点暖启动, 各次之间在 m_jacobianPool 中并行, 次内串行
+    const QVector<double>& pCal = std::get<1>(curve); const QVector<double>& dCal = std::get<2>(curve);
+    QVector<int> pValid, dValid;
+    QVector<double> pLogRes, dLogRes;
+    for(int i=0; i<obs.p.size() && i<pCal.size(); ++i) {
+        if(obs.p[i] > 1e-10 && pCal[i] > 1e-10) { pValid.append(i); pLogRes.append(log(obs.p[i]) - log(pCal[i])); }
+    }
+    for(int i=0; i<obs.d.size() && i<dCal.size(); ++i) {
+        if(obs.d[i] > 1e-10 && dCal[i] > 1e-10) { dValid.append(i); dLogRes.append(log(obs.d[i]) - log(dCal[i])); }
+    }
+    FitSettings refit = settings;
+    refit.mseTolerance = 0.0;
+    ModelEvaluationOptions refitOptions = fitOptions;
+    refitOptions.parallel = false;
+    int count = qMax(0, settings.bootstrapCount);
+    QVector<QVector<double>> samples(count);
+    std::atomic<int> done(0);
+    auto replicate = [&](int k) {
+        if(m_cancelToken.isCancelled()) return;
+        FitObservations boot = obs;
+        QVector<int> pi = FitUncertainty::resampleIndices(pLogRes.size(), 7919u * (k + 1));
+        for(int j=0; j<pValid.size(); ++j) boot.p[pValid[j]] = pCal[pValid[j]] * exp(pLogRes[pi[j]]);
+        QVector<int> di = FitUncertainty::resampleIndices(dLogRes.size(), 104729u * (k + 1));
+        for(int j=0; j<dValid.size(); ++j) boot.d[dValid[j]] = dCal[dValid[j]] * exp(dLogRes[di[j]]);
+        FitCandidate c = levenbergMarquardt(params, fitIndices, fitIds, fit.params, boot, weight, refitOptions, refit, false);
+        // 中途取消的重拟合未收敛, 不计入样本
+        if(m_cancelToken.isCancelled() || std::isnan(c.mse)) return;
+        QVector<double> values(nParams);
+        for(int i=0; i<nParams; ++i) values[i] = c.params[fitIds[i]];
+        samples[k] = values;
+        emit sigProgress(++done * 100 / count);
+    };
+    QVector<int> replicateIndices(count);
+    std::iota(replicateIndices.begin(), replicateIndices.end(), 0);
+    QtConcurrent::blockingMap(&m_jacobianPool, replicateIndices, replicate);
+
+    QVector<QVector<double>> completed;
+    for(const QVector<double>& s : samples) if(!s.isEmpty()) completed.append(s);
+    QStringList names;
+    QVector<double> values;
+    QVector<bool> logScale;
+    for(int i=0; i<nParams; ++i) {
+        P::Id id = fitIds[i];
+        names << P::keyOf(id);
+        values << fit.params[id];
+        // 与雅可比各列的参数化一致
+        logScale << (fit.params[id] > 1e-12 && id != P::S && id != P::Nf);
+    }
+    return FitUncertainty::summarize(names, values, logScale, cov, completed, count);
+}
+
+void FittingWidget::runGlobalOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitSettings& settings) {
+    using P = CompositeParameters;
+    m_fitModel->resetCacheStatistics();
+    ModelEvaluationOptions fitOptions = m_fitModel->evaluationOptions();
+    fitOptions.highPrecision = false;
+    // 候选之间在 m_jacobianPool 中并行, 候选内部 (反演时间点与差分各列) 串行, 避免线程池嵌套
+    fitOptions.parallel = false;
+    fitOptions.cancel = &m_cancelToken;
+    QVector<int> fitIndices;
+    QVector<P::Id> fitIds;
+    P start;
+    if(!resolveFitParameters(params, fitIndices, fitIds, start)) { QMetaObject::invokeMethod(this, "onFitFinished"); return; }
+    FitObservations full{m_obsTime, m_obsPressure, m_obsDerivative};
+    int evalBefore = m_modelEvaluations;
+
+    // 搜索空间为被拟合参数的 [min, max], 映射到单位超立方
+    int dim = fitIds.size();
+    QVector<double> lo(dim), hi(dim);
+    for(int j=0; j<dim; ++j) { lo[j] = params[fitIndices[j]].min; hi[j] = params[fitIndices[j]].max; }
+    auto toParams = [&](const QVector<double>& u) {
+        P p = start;
+        for(int j=0; j<dim; ++j) p[fitIds[j]] = fromUnit(fitIds[j], lo[j], hi[j], u[j]);
+        p.syncDerived();
+        return p;
+    };
+    auto toCube = [&](const P& p) {
+        QVector<double> u(dim);
+        for(int j=0; j<dim; ++j) u[j] = toUnit(fitIds[j], lo[j], hi[j], p[fitIds[j]]);
+        return u;
+    };
+
+    // 当前最优: 任一候选优于它时刷新界面 (信号为排队连接, 可在工作线程中发出)
+    QMutex bestMutex;
+    double bestMse = std::numeric_limits<double>::infinity();
+    auto offerBest = [&](const P& p, double mse, const ModelCurveData& curve) {
+        QMutexLocker locker(&bestMutex);
+        if(!(mse < bestMse)) return;
+        bestMse = mse;
+        emit sigIterationUpdated(mse, p.toMap(), std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+        // 只有函数值的候选 (差分进化个体) 没有曲线, 改为后台预览
+        if(std::get<0>(curve).isEmpty()) QMetaObject::invokeMethod(this, [this, modelType, p]() { requestPreview(modelType, p, false); }, Qt::QueuedConnection);
+    };
+    auto polish = [&](const P& from, const QString& origin) {
+        FitCandidate c = levenbergMarquardt(params, fitIndices, fitIds, from, full, weight, fitOptions, settings, false);
+        c.origin = origin;
+        offerBest(c.params, c.mse, c.curve);
+        return c;
+    };
+
+    QVector<FitCandidate> found;
+    if(settings.mode == FitMultiStart) {
+        // 第一个起点为表中当前值, 其余取拉丁超立方 (每个参数区间的各分层恰好覆盖一次)
+        QVector<P> seeds;
+        seeds.append(start);
+        for(const QVector<double>& u : GlobalSearch::latinHypercube(qMax(1, settings.searchSize - 1), dim, 20240601u)) seeds.append(toParams(u));
+        found.resize(seeds.size());
+        std::atomic<int> done(0);
+        auto runSeed = [&](int k) {
+            found[k].mse = std::numeric_limits<double>::quiet_NaN();
+            if(m_cancelToken.isCancelled()) return;
+            found[k] = polish(seeds[k], k == 0 ? QString("当前参数") : QString("起点 %1").arg(k));
+            emit sigProgress(++done * 100 / seeds.size());
+        };
+        QVector<int> seedIndices(seeds.size());
+        std::iota(seedIndices.begin(), seedIndices.end(), 0);
+        QtConcurrent::blockingMap(&m_jacobianPool, seedIndices, runSeed);
+    } else {
+        // 差分进化: 目标为 MSE, 每一代整批并行求值; 结束后取若干不同的极小值各做一次 LM 精修
+        GlobalSearch::DEOptions de;
+        de.generations = settings.searchSize;
+        GlobalSearch::BatchObjective objective = [&](const QVector<QVector<double>>& points) {
+            QVector<double> values(points.size(), std::numeric_limits<double>::quiet_NaN());
+            auto evaluate = [&](int k) {
+                if(m_cancelToken.isCancelled()) return;
+                QVector<double> r = calculateResiduals(toParams(points[k]), full, weight, fitOptions);
+                if(!r.isEmpty()) values[k] = calculateSumSquaredError(r) / r.size();
+            };
+            QVector<int> pointIndices(points.size());
+            std::iota(pointIndices.begin(), pointIndices.end(), 0);
+            QtConcurrent::blockingMap(&m_jacobianPool, pointIndices, evaluate);
+            return values;
+        };
+        GlobalSearch::ProgressCallback progress = [&](int generation, const GlobalSearch::Candidate& best) {
+            emit sigProgress(generation * 90 / qMax(1, de.generations));
+            if(!std::isnan(best.value)) offerBest(toParams(best.x), best.value, ModelCurveData());
+            return !m_cancelToken.isCancelled();
+        };
+        QVector<GlobalSearch::Candidate> population = GlobalSearch::differentialEvolution(dim, objective, de, progress);
+        QVector<GlobalSearch::Candidate> minima = GlobalSearch::distinctMinima(population, kCandidateCount, 0.05);
+        found.resize(minima.size());
+        auto refine = [&](int k) {
+            QString origin = QString("差分进化 #%1").arg(k + 1);
+            if(m_cancelToken.isCancelled()) {
+                // 已停止或到达时限: 保留未精修的种群个体
+                found[k].params = toParams(minima[k].x); found[k].mse = minima[k].value; found[k].origin = origin + " (未精修)";
+                return;
+            }
+            found[k] = polish(toParams(minima[k].x), origin);
+        };
+        QVector<int> minimaIndices(minima.size());
+        std::iota(minimaIndices.begin(), minimaIndices.end(), 0);
+        QtConcurrent::blockingMap(&m_jacobianPool, minimaIndices, refine);
+        emit sigProgress(100);
+    }
+
+    // LM 收敛到同一极小值的候选合并, 按 MSE 保留前 kCandidateCount 个
+    QVector<GlobalSearch::Candidate> points;
+    for(int k=0; k<found.size(); ++k) {
+        GlobalSearch::Candidate c;
+        c.x = toCube(found[k].params); c.value = found[k].mse; c.index = k;
+        points.append(c);
+    }
+    QList<FitCandidate> distinct;
+    for(const GlobalSearch::Candidate& c : GlobalSearch::distinctMinima(points, kCandidateCount)) distinct.append(found[c.index]);
+
+    {
+        LaplaceCacheStats st = m_fitModel->cacheStatistics();
+        qDebug() << "全局搜索: 候选" << found.size() << ", 不同极小值" << distinct.size()
+                 << ", 模型求值" << (m_modelEvaluations - evalBefore)
+                 << ", pf 命中" << st.pfHits << "/ 未命中" << st.pfMisses
+                 << ", 积分核求值" << m_fitModel->quadratureEvaluations();
+    }
+    if(!distinct.isEmpty()) {
+        const FitCandidate& best = distinct.first();
+        emit sigIterationUpdated(best.mse, best.params.toMap(), std::get<0>(best.curve), std::get<1>(best.curve), std::get<2>(best.curve));
+        P bestParams = best.params;
+        QMetaObject::invokeMethod(this, [this, modelType, bestParams]() { requestPreview(modelType, bestParams, true); }, Qt::QueuedConnection);
+    }
+    // 在 onFitFinished (排队调用, 主线程) 之前写入, 按钮在拟合期间禁用
+    m_fitCandidates = distinct;
+    m_candidatesModelType = modelType;
+    m_candidatesFitIds = fitIds;
+    if(!distinct.isEmpty()) m_lastFitMse = distinct.first().mse;
     QMetaObject::invokeMethod(this, "onFitFinished");
 }
 
-QVector<double> FittingWidget::calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight) {
-    if(!m_modelManager || m_obsTime.isEmpty()) return QVector<double>();
-    ModelCurveData res = m_modelManager->calculateTheoreticalCurve(modelType, params, m_obsTime);
+QVector<double> FittingWidget::calculateResiduals(const CompositeParameters& params, const FitObservations& obs, double weight, const ModelEvaluationOptions& options, ModelCurveData* curve) {
+    if(!m_fitModel || obs.t.isEmpty()) return QVector<double>();
+    ++m_modelEvaluations;
+    ModelCurveData res = m_fitModel->calculateTheoreticalCurve(params, obs.t, options);
     const QVector<double>& pCal = std::get<1>(res); const QVector<double>& dpCal = std::get<2>(res);
     QVector<double> r; double wp = weight; double wd = 1.0 - weight;
-    int count = qMin(m_obsPressure.size(), pCal.size());
+    int count = qMin(obs.p.size(), pCal.size());
     for(int i=0; i<count; ++i) {
-        if(m_obsPressure[i] > 1e-10 && pCal[i] > 1e-10) r.append( (log(m_obsPressure[i]) - log(pCal[i])) * wp ); else r.append(0.0);
+        if(obs.p[i] > 1e-10 && pCal[i] > 1e-10) r.append( (log(obs.p[i]) - log(pCal[i])) * wp ); else r.append(0.0);
     }
-    int dCount = qMin(m_obsDerivative.size(), dpCal.size()); dCount = qMin(dCount, count);
+    int dCount = qMin(obs.d.size(), dpCal.size()); dCount = qMin(dCount, count);
     for(int i=0; i<dCount; ++i) {
-        if(m_obsDerivative[i] > 1e-10 && dpCal[i] > 1e-10) r.append( (log(m_obsDerivative[i]) - log(dpCal[i])) * wd ); else r.append(0.0);
+        if(obs.d[i] > 1e-10 && dpCal[i] > 1e-10) r.append( (log(obs.d[i]) - log(dpCal[i])) * wd ); else r.append(0.0);
     }
+    if(curve) *curve = res;
     return r;
 }
 
-QVector<QVector<double>> FittingWidget::computeJacobian(const QMap<QString, double>& params, const QVector<double>& baseResiduals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight) {
-    int nRes = baseResiduals.size(); int nParams = fitIndices.size();
+void FittingWidget::setAnalyticJacobian(bool enabled) { m_analyticJacobian = enabled; }
+
+QVector<QVector<double>> FittingWidget::computeJacobian(const CompositeParameters& params, const QVector<double>& baseResiduals, const FitObservations& obs, const QVector<CompositeParameters::Id>& fitIds, double weight, const ModelEvaluationOptions& options) {
+    using P = CompositeParameters;
+    int nRes = baseResiduals.size(); int nParams = fitIds.size();
     QVector<QVector<double>> J(nRes, QVector<double>(nParams));
-    for(int j = 0; j < nParams; ++j) {
-        int idx = fitIndices[j]; QString pName = currentFitParams[idx].name;
-        double val = params.value(pName); bool isLog = (val > 1e-12 && pName != "S" && pName != "nf");
-        double h; QMap<QString, double> pPlus = params; QMap<QString, double> pMinus = params;
-        if(isLog) { h = 0.01; double valLog = log10(val); pPlus[pName] = pow(10.0, valLog + h); pMinus[pName] = pow(10.0, valLog - h); }
-        else { h = 1e-4; pPlus[pName] = val + h; pMinus[pName] = val - h; }
-        auto updateDeps = [](QMap<QString,double>& map) { if(map.contains("L") && map.contains("Lf") && map["L"] > 1e-9) map["LfD"] = map["Lf"] / map["L"]; };
-        if(pName == "L" || pName == "Lf") { updateDeps(pPlus); updateDeps(pMinus); }
-        QVector<double> rPlus = calculateResiduals(pPlus, modelType, weight);
-        QVector<double> rMinus = calculateResiduals(pMinus, modelType, weight);
+    if(m_analyticJacobian && computeJacobianAnalytic(params, obs, nRes, fitIds, weight, options, J)) return J;
+
+    // 差分: 各列 (±h 扰动) 相互独立, 在有界线程池中并行求值。
+    // 列内关闭按时间点并行, 避免线程池嵌套; 每列结果写入各自的缓冲区, 与串行结果逐位一致
+    ModelEvaluationOptions colOptions = options;
+    colOptions.parallel = false;
+    QVector<QVector<double>> columns(nParams);
+    QVector<double>* colData = columns.data();
+    auto computeColumn = [&](int j) {
+        P::Id id = fitIds[j];
+        double val = params[id]; bool isLog = (val > 1e-12 && id != P::S && id != P::Nf);
+        double h; P pPlus = params; P pMinus = params;
+        if(isLog) { h = 0.01; double valLog = log10(val); pPlus[id] = pow(10.0, valLog + h); pMinus[id] = pow(10.0, valLog - h); }
+        else { h = 1e-4; pPlus[id] = val + h; pMinus[id] = val - h; }
+        if(id == P::L || id == P::Lf) { pPlus.syncDerived(); pMinus.syncDerived(); }
+        QVector<double> rPlus = calculateResiduals(pPlus, obs, weight, colOptions);
+        QVector<double> rMinus = calculateResiduals(pMinus, obs, weight, colOptions);
         if(rPlus.size() == nRes && rMinus.size() == nRes) {
-            for(int i=0; i<nRes; ++i) J[i][j] = (rPlus[i] - rMinus[i]) / (2.0 * h);
+            QVector<double> col(nRes);
+            for(int i=0; i<nRes; ++i) col[i] = (rPlus[i] - rMinus[i]) / (2.0 * h);
+            colData[j] = col;
         }
+    };
+    if(options.parallel) {
+        QVector<int> colIndices(nParams);
+        std::iota(colIndices.begin(), colIndices.end(), 0);
+        QtConcurrent::blockingMap(&m_jacobianPool, colIndices, computeColumn);
+    } else {
+        for(int j = 0; j < nParams; ++j) computeColumn(j);
+    }
+
+    for(int j = 0; j < nParams; ++j) {
+        if(columns[j].size() != nRes) continue;
+        for(int i=0; i<nRes; ++i) J[i][j] = columns[j][i];
     }
     return J;
 }
 
+// 残差 r = (ln obs - ln cal) * w  =>  dr/dθ = -w * (dcal/dθ) / cal
+// 与差分版本保持相同的参数化: 对数参数的列为 d/d(log10 θ) = θ ln10 d/dθ
+bool FittingWidget::computeJacobianAnalytic(const CompositeParameters& params, const FitObservations& obs, int nRes, const QVector<CompositeParameters::Id>& fitIds, double weight, const ModelEvaluationOptions& options, QVector<QVector<double>>& J) {
+    using P = CompositeParameters;
+    if(!m_fitModel || obs.t.isEmpty()) return false;
+    int nParams = fitIds.size();
+    ++m_modelEvaluations;
+    ModelSensitivityData sens = m_fitModel->calculateTheoreticalCurveSensitivity(params, fitIds, obs.t, options);
+    if(!sens.valid) return false;
+
+    const QVector<double>& pCal = sens.pressure; const QVector<double>& dpCal = sens.derivative;
+    double wp = weight; double wd = 1.0 - weight;
+    int count = qMin(obs.p.size(), pCal.size());
+    int dCount = qMin(obs.d.size(), dpCal.size()); dCount = qMin(dCount, count);
+    if(count + dCount != nRes) return false;
+
+    QVector<double> colScale(nParams);
+    for(int j=0; j<nParams; ++j) {
+        P::Id id = fitIds[j]; double val = params[id];
+        bool isLog = (val > 1e-12 && id != P::S && id != P::Nf);
+        colScale[j] = isLog ? val * std::log(10.0) : 1.0;
+    }
+    for(int i=0; i<count; ++i) {
+        bool active = (obs.p[i] > 1e-10 && pCal[i] > 1e-10);
+        for(int j=0; j<nParams; ++j) J[i][j] = active ? -wp * sens.dPressure[j][i] / pCal[i] * colScale[j] : 0.0;
+    }
+    for(int i=0; i<dCount; ++i) {
+        bool active = (obs.d[i] > 1e-10 && dpCal[i] > 1e-10);
+        for(int j=0; j<nParams; ++j) J[count + i][j] = active ? -wd * sens.dDerivative[j][i] / dpCal[i] * colScale[j] : 0.0;
+    }
+    return true;
+}
+
 QVector<double> FittingWidget::solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b) {
     int n = b.size(); if (n == 0) return QVector<double>();
     Eigen::MatrixXd matA(n, n); Eigen::VectorXd vecB(n);
@@ -933,20 +1563,88 @@ double FittingWidget::calculateSumSquaredError(const QVector<double>& residuals)
 
 void FittingWidget::onIterationUpdate(double err, const QMap<QString,double>& p,
                                       const QVector<double>& t, const QVector<double>& p_curve, const QVector<double>& d_curve) {
-    ui->label_Error->setText(QString("误差(MSE): %1").arg(err, 0, 'e', 3));
+    m_pendingIteration.valid = true;
+    m_pendingIteration.error = err;
+    m_pendingIteration.params = p;
+    // 没有曲线的更新 (曲线由预览补算) 不覆盖尚未显示的曲线
+    if(!t.isEmpty()) { m_pendingIteration.t = t; m_pendingIteration.p = p_curve; m_pendingIteration.d = d_curve; }
+    if(!m_uiTimer.isActive()) m_uiTimer.start();
+}
+
+void FittingWidget::flushIterationUpdate() {
+    m_uiTimer.stop();
+    if(!m_pendingIteration.valid) return;
+    PendingIteration u = m_pendingIteration;
+    m_pendingIteration = PendingIteration();
+
+    ui->label_Error->setText(QString("误差(MSE): %1").arg(u.error, 0, 'e', 3));
     ui->tableParams->blockSignals(true);
     for(int i=0; i<ui->tableParams->rowCount(); ++i) {
         QString key = ui->tableParams->item(i, 0)->data(Qt::UserRole).toString();
-        if(p.contains(key)) {
-            double val = p[key];
+        if(u.params.contains(key)) {
+            double val = u.params[key];
             ui->tableParams->item(i, 1)->setText(QString::number(val, 'g', 5));
         }
     }
     ui->tableParams->blockSignals(false);
-    plotCurves(t, p_curve, d_curve, true);
+    if(u.t.isEmpty()) return;
+    // 全分辨率观测时间上的曲线点数很多, 显示时按对数均匀抽稀
+    if(u.t.size() > kDisplayPointLimit) {
+        QVector<int> idx = DataDecimation::logUniformIndices(u.t, kDisplayPointsPerDecade);
+        u.t = DataDecimation::take(u.t, idx); u.p = DataDecimation::take(u.p, idx); u.d = DataDecimation::take(u.d, idx);
+    }
+    plotCurves(u.t, u.p, u.d, true);
 }
 
-void FittingWidget::onFitFinished() { m_isFitting = false; ui->btnRunFit->setEnabled(true); QMessageBox::information(this, "完成", "拟合完成。"); }
+void FittingWidget::requestPreview(ModelManager::ModelType modelType, const CompositeParameters& params, bool highPrecision) {
+    if(!m_modelManager) return;
+    m_previewModelType = modelType; m_previewParams = params; m_previewHighPrecision = highPrecision;
+    if(m_previewWatcher.isRunning()) { m_previewPending = true; return; }
+    m_previewPending = false;
+
+    double tMin = 1e-4, tMax = 1e4;
+    bool first = true;
+    for(double v : m_obsTime) {
+        if(v <= 0) continue;
+        if(first) { tMin = tMax = v; first = false; }
+        tMin = qMin(tMin, v); tMax = qMax(tMax, v);
+    }
+    if(tMax <= tMin) tMax = tMin * 10.0;
+    QVector<double> t(kPreviewPoints);
+    for(int i=0; i<kPreviewPoints; ++i) t[i] = tMin * pow(tMax / tMin, double(i) / (kPreviewPoints - 1));
+
+    ModelEvaluationOptions options = m_modelManager->getEvaluationOptions(modelType);
+    options.highPrecision = highPrecision;
+    // 调度中的拟合占用着分配的线程预算, 此时预览按时间点串行, 不再占满全局线程池
+    if(m_isFitting && m_scheduler) options.parallel = false;
+    ModelManager* manager = m_modelManager;
+    m_previewWatcher.setFuture(QtConcurrent::run([manager, modelType, params, t, options]() {
+        return manager->calculateTheoreticalCurve(modelType, params, t, options);
+    }));
+}
+
+void FittingWidget::onPreviewFinished() {
+    ModelCurveData c = m_previewWatcher.result();
+    plotCurves(std::get<0>(c), std::get<1>(c), std::get<2>(c), true);
+    if(m_previewPending) requestPreview(m_previewModelType, m_previewParams, m_previewHighPrecision);
+}
+
+void FittingWidget::onFitFinished() {
+    flushIterationUpdate();
+    m_isFitting = false; ui->btnRunFit->setEnabled(true);
+    ui->btnCandidates->setEnabled(!m_fitCandidates.isEmpty());
+    if(m_scheduler && m_jobId > 0) {
+        // 到达时限视为正常结束 (返回当前最优结果), 停止按钮或调度器取消记为已取消
+        bool stopped = m_cancelToken.isCancelled() && !m_cancelToken.deadlineExpired();
+        m_scheduler->finishJob(m_jobId, m_lastFitMse, stopped);
+        m_jobId = 0;
+    }
+    if(m_quietFinish) return;
+    // 全局搜索结束后直接列出候选解供选择
+    if(!m_fitCandidates.isEmpty()) { on_btnCandidates_clicked(); return; }
+    if(!m_fitReport.isEmpty()) { QMessageBox::information(this, "完成", "拟合完成。\n\n" + m_fitReport.join("\n")); return; }
+    QMessageBox::information(this, "完成", "拟合完成。");
+}
 
 void FittingWidget::plotCurves(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d, bool isModel) {
     QVector<double> vt, vp, vd;
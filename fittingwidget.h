@@ -5,14 +5,34 @@
 #include <QMap>
 #include <QVector>
 #include <QFutureWatcher>
+#include <QThreadPool>
 #include <QTableWidget>
 #include <QJsonObject>
+#include <QTimer>
+#include <atomic>
+#include <memory>
 #include "modelmanager.h"
+#include "cancellationtoken.h"
+#include "fituncertainty.h"
+#include "typecurveatlas.h"
 #include "mousezoom.h"
 #include "chartsetting1.h"
 
+// 一次局部拟合 (或全局搜索中的一个候选极小值) 的结果
+struct FitCandidate {
+    CompositeParameters params;
+    double mse = 0.0;
+    double sse = 0.0;
+    int iterations = 0;
+    int jacobianEvaluations = 0;   // 全量雅可比计算次数
+    int broydenUpdates = 0;        // Broyden 秩一更新次数
+    ModelCurveData curve;   // 残差求值时算出的观测时间点上的曲线 (用于显示, 不再重算)
+    QString origin;     // 来源, 如 "起点 3"、"差分进化 #2"
+};
+
 // 数据加载对话框 (保持原有逻辑不变)
 class QComboBox;
+class FitScheduler;
 class FittingDataLoadDialog : public QDialog {
     Q_OBJECT
 public:
@@ -28,6 +48,16 @@ private:
     void validateSelection();
 };
 
+// 全局搜索得到的若干不同极小值, 由用户选择其一应用到参数表
+class FittingCandidatesDialog : public QDialog {
+    Q_OBJECT
+public:
+    FittingCandidatesDialog(const QList<FitCandidate>& candidates, const QVector<CompositeParameters::Id>& fitIds, QWidget *parent = nullptr);
+    int selectedIndex() const;
+private:
+    QTableWidget* m_table;
+};
+
 namespace Ui { class FittingWidget; }
 
 struct FitParameter {
@@ -41,6 +71,26 @@ struct FitParameter {
     double max;
 };
 
+// 参与拟合的观测数据 (全部数据或分级拟合中的抽稀子集); d 可短于 t
+struct FitObservations {
+    QVector<double> t;
+    QVector<double> p;
+    QVector<double> d;
+};
+
+// 拟合设置, 点击开始时从界面读取
+struct FitSettings {
+    int mode = 0;                 // FittingWidget::FitMode
+    int searchSize = 16;          // 多起点的起点数 / 差分进化的代数
+    bool multiResolution = true;  // 局部拟合: 粗到细分级
+    int pointsPerDecade = 10;     // 首级每十倍时间的点数, 之后每级 x4
+    bool quasiNewton = false;     // Broyden 雅可比更新 + 测地加速
+    int jacobianRefresh = 5;      // 拟牛顿模式下全量重算雅可比的迭代间隔
+    bool uncertainty = false;     // 局部拟合收敛后做不确定性分析
+    int bootstrapCount = 50;      // 残差自助重拟合次数 (0 为只算协方差)
+    double mseTolerance = 3e-3;   // MSE 低于此值时提前结束 (自助重拟合取 0, 否则暖启动后立即结束)
+};
+
 class FittingWidget : public QWidget
 {
     Q_OBJECT
@@ -50,6 +100,8 @@ public:
     ~FittingWidget();
 
     void setModelManager(ModelManager* m);
+    // 拟合任务提交到 FittingPage 的调度器 (未设置时单独在全局线程池中运行)
+    void setScheduler(FitScheduler* scheduler);
     // 设置观测数据
     void setObservedData(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d);
 
@@ -62,6 +114,20 @@ public:
     // 获取当前拟合状态的 JSON 对象（用于保存）
     QJsonObject getJsonState() const;
 
+    // 雅可比计算方式: true 为前向自动微分 (一次求值得到全部列, 默认), false 为中心差分
+    void setAnalyticJacobian(bool enabled);
+
+    // 切换模型, 同名参数保留原值; keepFitSettings 为 true 时同时保留拟合勾选与上下限,
+    // 新模型独有的参数 (cD、S、reD 等) 在原来有被拟合参数时一并拟合 (用于多模型对比)
+    void setModelType(ModelManager::ModelType type, bool keepFitSettings = false);
+    ModelManager::ModelType modelType() const { return m_currentModelType; }
+    bool hasObservedData() const { return !m_obsTime.isEmpty(); }
+    bool isFitting() const { return m_isFitting; }
+
+    // 按界面设置开始拟合; quiet 为 true 时结束后不弹出结果与候选解对话框 (批量提交),
+    // group 为调度器中的批次编号。已在拟合或没有观测数据时返回 false
+    bool startFit(bool quiet = false, int group = 0);
+
 signals:
     void fittingCompleted(ModelManager::ModelType modelType, const QMap<QString, double>& parameters);
     void sigIterationUpdated(double error, QMap<QString, double> currentParams, QVector<double> t, QVector<double> p, QVector<double> d);
@@ -74,6 +140,8 @@ private slots:
     void on_btnLoadData_clicked();
     void on_btnRunFit_clicked();
     void on_btnStop_clicked();
+    // 图版初值: 在预计算图版的网格节点上匹配观测曲线, 结果写入被拟合参数
+    void on_btnAtlasSeed_clicked();
     void on_btnImportModel_clicked();
     void on_btnExportData_clicked();
     void on_btnExportChart_clicked();
@@ -81,6 +149,8 @@ private slots:
     void on_btnResetView_clicked();
     void on_btnChartSettings_clicked();
     void on_btn_modelSelect_clicked();
+    void on_btnCandidates_clicked();
+    void on_comboFitMode_currentIndexChanged(int index);
 
     // 点击保存按钮，只触发信号
     void on_btnSaveFit_clicked();
@@ -89,10 +159,20 @@ private slots:
 
     void onIterationUpdate(double err, const QMap<QString,double>& p, const QVector<double>& t, const QVector<double>& p_curve, const QVector<double>& d_curve);
     void onFitFinished();
+    // 节流后的界面刷新: 把最近一次迭代结果写入表格与曲线
+    void flushIterationUpdate();
+    void onPreviewFinished();
 
 private:
     Ui::FittingWidget *ui;
     ModelManager* m_modelManager;
+    FitScheduler* m_scheduler;
+    int m_jobId;            // 调度器中当前拟合任务的编号, 0 为无
+    bool m_quietFinish;
+    double m_lastFitMse;    // 最近一次拟合的最优 MSE, 在 onFitFinished 之前由工作线程写入
+    // 拟合专用的模型对象: 缓存与统计只属于本页, 与其他分析页及模型界面互不干扰;
+    // 模型类型不变时沿用 (保留已缓存的 pf(z)), 只在拟合开始前 (主线程) 替换
+    std::unique_ptr<CompositeModel> m_fitModel;
     MouseZoom* m_plot;
     QCPTextElement* m_plotTitle;
     ModelManager::ModelType m_currentModelType;
@@ -103,9 +183,46 @@ private:
     QVector<double> m_obsPressure;
     QVector<double> m_obsDerivative;
 
+    // 拟合方式 (与 comboFitMode 的条目顺序一致)
+    enum FitMode { FitLocal = 0, FitMultiStart, FitDifferentialEvolution };
+    // 最近一次全局搜索得到的不同极小值 (按 MSE 升序) 及其模型与被拟合参数
+    QList<FitCandidate> m_fitCandidates;
+    // 最近一次局部拟合的参数不确定性 (随项目保存, 写入报告); 新的拟合开始时清空
+    FitUncertainty::Result m_uncertainty;
+    ModelManager::ModelType m_candidatesModelType;
+    QVector<CompositeParameters::Id> m_candidatesFitIds;
+    // 模型求值次数 (残差与自动微分各计一次), 供各级拟合报告使用
+    std::atomic<int> m_modelEvaluations;
+    // 最近一次局部拟合各级的点数、耗时与 SSE, 拟合结束时显示
+    QStringList m_fitReport;
+
     bool m_isFitting;
-    bool m_stopRequested;
+    // 停止按钮与可选时限共用的取消标记, 随求值选项传入模型 (反演按时间点检查)
+    CancellationToken m_cancelToken;
+    bool m_analyticJacobian;
+    // 拟合任务内部的线程池: 雅可比各列、全局搜索候选与按时间点反演都在此并行
+    // (线程数 = CPU 核数, 由调度器调度时为其分配的每任务预算)
+    QThreadPool m_jacobianPool;
     QFutureWatcher<void> m_watcher;
+    QFuture<void> m_fitFuture;
+
+    // 迭代结果先暂存, 由定时器按最高帧率刷新 (绘图开销与拟合解耦)
+    struct PendingIteration {
+        bool valid = false;
+        double error = 0.0;
+        QMap<QString, double> params;
+        QVector<double> t, p, d;    // 为空表示本次没有新曲线
+    };
+    PendingIteration m_pendingIteration;
+    QTimer m_uiTimer;
+
+    // 预览曲线: 固定的少量对数时间点, 后台计算; 计算中再有请求时只保留最新的一组参数
+    QFutureWatcher<ModelCurveData> m_previewWatcher;
+    bool m_previewPending;
+    ModelManager::ModelType m_previewModelType;
+    CompositeParameters m_previewParams;
+    bool m_previewHighPrecision;
+    void requestPreview(ModelManager::ModelType modelType, const CompositeParameters& params, bool highPrecision);
 
     void setupPlot();
     void initializeDefaultModel();
@@ -113,11 +230,27 @@ private:
     void updateParamsFromTable();
     void updateModelCurve();
 
-    void runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight);
-    void runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight);
+    void runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight, const FitSettings& settings);
+    // 局部拟合; 分级时先在对数均匀抽稀的子集上收敛, 逐级加密 (每级点数 x4), 最后以全部数据精修
+    void runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitSettings& settings);
+    // 全局搜索: 多起点 LM (拉丁超立方起点) 或差分进化 + LM 精修; 候选在线程池中并行求值
+    void runGlobalOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitSettings& settings);
+
+    // 解析被拟合参数 (表中行号与参数下标) 及初始参数组; 没有被拟合参数时返回 false
+    bool resolveFitParameters(const QList<FitParameter>& params, QVector<int>& fitIndices, QVector<CompositeParameters::Id>& fitIds, CompositeParameters& start);
+    // 从 start 出发的 LM 迭代; report 为 true 时发出进度与每步曲线 (单次拟合), 全局搜索中为 false
+    FitCandidate levenbergMarquardt(const QList<FitParameter>& params, const QVector<int>& fitIndices, const QVector<CompositeParameters::Id>& fitIds, const CompositeParameters& start, const FitObservations& obs, double weight, const ModelEvaluationOptions& fitOptions, const FitSettings& settings, bool report);
+    // 收敛点的协方差 / 相关矩阵 (全量雅可比) 与残差自助区间 (从收敛点暖启动的重拟合, 在线程池中并行)
+    FitUncertainty::Result analyzeUncertainty(const QList<FitParameter>& params, const QVector<int>& fitIndices, const QVector<CompositeParameters::Id>& fitIds, const FitCandidate& fit, const FitObservations& obs, double weight, const ModelEvaluationOptions& fitOptions, const FitSettings& settings);
 
-    QVector<double> calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight);
-    QVector<QVector<double>> computeJacobian(const QMap<QString, double>& params, const QVector<double>& residuals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight);
+    // 拟合过程中的模型求值均显式传入 options (低精度反演), 不修改模型的默认选项
+    // 参数以下标数组 CompositeParameters 传递, fitIds 为被拟合参数在其中的下标 (拟合开始时解析)
+    // curve 非空时保留本次求值得到的观测时间点曲线, 供迭代显示复用
+    QVector<double> calculateResiduals(const CompositeParameters& params, const FitObservations& obs, double weight, const ModelEvaluationOptions& options, ModelCurveData* curve = nullptr);
+    // options.parallel 为 false 时差分各列串行 (调用方已在线程池中并行, 如全局搜索的各候选)
+    QVector<QVector<double>> computeJacobian(const CompositeParameters& params, const QVector<double>& residuals, const FitObservations& obs, const QVector<CompositeParameters::Id>& fitIds, double weight, const ModelEvaluationOptions& options);
+    // 自动微分雅可比, 模型不支持时返回 false (由 computeJacobian 退回差分)
+    bool computeJacobianAnalytic(const CompositeParameters& params, const FitObservations& obs, int nRes, const QVector<CompositeParameters::Id>& fitIds, double weight, const ModelEvaluationOptions& options, QVector<QVector<double>>& J);
     QVector<double> solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b);
     double calculateSumSquaredError(const QVector<double>& residuals);
 
@@ -0,0 +1,191 @@
+#include "fituncertainty.h"
+
+#include <QJsonArray>
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace FitUncertainty {
+
+namespace {
+
+const double kZ95 = 1.959964;
+
+// JSON 不能表示 NaN / Inf, 写为 null
+QJsonValue jsonNumber(double x)
+{
+    return std::isfinite(x) ? QJsonValue(x) : QJsonValue();
+}
+
+QJsonArray toArray(const QVector<double>& v)
+{
+    QJsonArray a;
+    for (double x : v) a.append(jsonNumber(x));
+    return a;
+}
+
+double valueOf(const QJsonValue& v)
+{
+    return v.isDouble() ? v.toDouble() : std::numeric_limits<double>::quiet_NaN();
+}
+
+} // namespace
+
+Covariance covarianceFromJacobian(const QVector<QVector<double>>& J, const QVector<double>& residuals)
+{
+    Covariance c;
+    int m = J.size();
+    int n = m > 0 ? J[0].size() : 0;
+    if (n == 0 || m <= n || residuals.size() != m) return c;
+
+    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(n, n);
+    double sse = 0.0;
+    for (int k = 0; k < m; ++k) {
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j <= i; ++j) A(i, j) += J[k][i] * J[k][j];
+        sse += residuals[k] * residuals[k];
+    }
+    A = A.selfadjointView<Eigen::Lower>();
+
+    // 特征分解求逆: 接近零的特征值 (不可辨识的参数组合) 按伪逆处理, 不让协方差溢出
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(A);
+    if (eig.info() != Eigen::Success) return c;
+    const Eigen::VectorXd& ev = eig.eigenvalues();
+    double maxEv = ev.maxCoeff();
+    if (!(maxEv > 0.0)) return c;
+    Eigen::VectorXd inv(n);
+    for (int i = 0; i < n; ++i) inv(i) = ev(i) > maxEv * 1e-12 ? 1.0 / ev(i) : 0.0;
+    double minEv = ev.minCoeff();
+    c.conditionNumber = minEv > 0.0 ? maxEv / minEv : std::numeric_limits<double>::infinity();
+
+    c.dof = m - n;
+    c.sigma2 = sse / c.dof;
+    Eigen::MatrixXd cov = c.sigma2 * eig.eigenvectors() * inv.asDiagonal() * eig.eigenvectors().transpose();
+
+    c.covariance = QVector<QVector<double>>(n, QVector<double>(n));
+    c.correlation = QVector<QVector<double>>(n, QVector<double>(n));
+    c.standardErrors.resize(n);
+    for (int i = 0; i < n; ++i) c.standardErrors[i] = std::sqrt(std::max(0.0, cov(i, i)));
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            c.covariance[i][j] = cov(i, j);
+            double d = c.standardErrors[i] * c.standardErrors[j];
+            c.correlation[i][j] = d > 0.0 ? cov(i, j) / d : (i == j ? 1.0 : 0.0);
+        }
+    }
+    c.valid = true;
+    return c;
+}
+
+QVector<int> resampleIndices(int n, quint32 seed)
+{
+    QVector<int> idx(std::max(0, n));
+    if (n <= 0) return idx;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    for (int i = 0; i < n; ++i) idx[i] = pick(rng);
+    return idx;
+}
+
+double percentile(QVector<double> values, double q)
+{
+    values.erase(std::remove_if(values.begin(), values.end(), [](double v) { return !std::isfinite(v); }), values.end());
+    if (values.isEmpty()) return std::numeric_limits<double>::quiet_NaN();
+    std::sort(values.begin(), values.end());
+    double pos = std::clamp(q, 0.0, 1.0) * (values.size() - 1);
+    int lo = (int)std::floor(pos);
+    int hi = std::min(lo + 1, (int)values.size() - 1);
+    return values[lo] + (pos - lo) * (values[hi] - values[lo]);
+}
+
+Result summarize(const QStringList& names, const QVector<double>& values, const QVector<bool>& logScale,
+                 const Covariance& cov, const QVector<QVector<double>>& bootstrapSamples, int bootstrapRequested)
+{
+    Result r;
+    r.dof = cov.dof;
+    r.sigma2 = cov.sigma2;
+    r.conditionNumber = cov.conditionNumber;
+    r.correlation = cov.correlation;
+    r.bootstrapRequested = bootstrapRequested;
+    r.bootstrapCompleted = bootstrapSamples.size();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (int i = 0; i < names.size() && i < values.size(); ++i) {
+        ParameterInterval p;
+        p.name = names[i];
+        p.value = values[i];
+        p.logScale = i < logScale.size() && logScale[i];
+        p.standardError = (cov.valid && i < cov.standardErrors.size()) ? cov.standardErrors[i] : nan;
+        double half = kZ95 * p.standardError;
+        if (p.logScale) { p.lower = p.value * std::pow(10.0, -half); p.upper = p.value * std::pow(10.0, half); }
+        else { p.lower = p.value - half; p.upper = p.value + half; }
+
+        QVector<double> samples;
+        samples.reserve(bootstrapSamples.size());
+        for (const QVector<double>& s : bootstrapSamples) if (i < s.size()) samples.append(s[i]);
+        p.bootstrapLower = percentile(samples, 0.025);
+        p.bootstrapUpper = percentile(samples, 0.975);
+        r.parameters.append(p);
+    }
+    return r;
+}
+
+QJsonObject Result::toJson() const
+{
+    QJsonObject obj;
+    QJsonArray params;
+    for (const ParameterInterval& p : parameters) {
+        QJsonObject o;
+        o["name"] = p.name;
+        o["value"] = p.value;
+        o["logScale"] = p.logScale;
+        o["standardError"] = jsonNumber(p.standardError);
+        o["lower"] = jsonNumber(p.lower);
+        o["upper"] = jsonNumber(p.upper);
+        o["bootstrapLower"] = jsonNumber(p.bootstrapLower);
+        o["bootstrapUpper"] = jsonNumber(p.bootstrapUpper);
+        params.append(o);
+    }
+    obj["parameters"] = params;
+    QJsonArray corr;
+    for (const QVector<double>& row : correlation) corr.append(toArray(row));
+    obj["correlation"] = corr;
+    obj["dof"] = dof;
+    obj["sigma2"] = sigma2;
+    obj["conditionNumber"] = jsonNumber(conditionNumber);
+    obj["bootstrapRequested"] = bootstrapRequested;
+    obj["bootstrapCompleted"] = bootstrapCompleted;
+    return obj;
+}
+
+Result Result::fromJson(const QJsonObject& obj)
+{
+    Result r;
+    for (const QJsonValue& v : obj["parameters"].toArray()) {
+        QJsonObject o = v.toObject();
+        ParameterInterval p;
+        p.name = o["name"].toString();
+        p.value = o["value"].toDouble();
+        p.logScale = o["logScale"].toBool();
+        p.standardError = valueOf(o["standardError"]);
+        p.lower = valueOf(o["lower"]);
+        p.upper = valueOf(o["upper"]);
+        p.bootstrapLower = valueOf(o["bootstrapLower"]);
+        p.bootstrapUpper = valueOf(o["bootstrapUpper"]);
+        r.parameters.append(p);
+    }
+    for (const QJsonValue& row : obj["correlation"].toArray()) {
+        QVector<double> values;
+        for (const QJsonValue& v : row.toArray()) values.append(valueOf(v));
+        r.correlation.append(values);
+    }
+    r.dof = obj["dof"].toInt();
+    r.sigma2 = obj["sigma2"].toDouble();
+    r.conditionNumber = valueOf(obj["conditionNumber"]);
+    r.bootstrapRequested = obj["bootstrapRequested"].toInt();
+    r.bootstrapCompleted = obj["bootstrapCompleted"].toInt();
+    return r;
+}
+
+} // namespace FitUncertainty
@@ -0,0 +1,69 @@
+#ifndef FITUNCERTAINTY_H
+#define FITUNCERTAINTY_H
+
+#include <QVector>
+#include <QStringList>
+#include <QJsonObject>
+
+/**
+ * @brief 拟合参数的不确定性: 线性化协方差与残差自助 (bootstrap) 区间
+ *
+ * 与模型无关: 协方差由收敛点的雅可比与残差给出, 自助区间由调用方重拟合得到的参数样本给出。
+ * 坐标与拟合一致 (对数参数为 log10, 其余为线性), 区间换算回参数本身的单位。
+ */
+namespace FitUncertainty {
+
+struct Covariance {
+    bool valid = false;
+    int dof = 0;                          // 自由度 m - n
+    double sigma2 = 0.0;                  // 残差方差 SSE / (m - n)
+    double conditionNumber = 0.0;         // J^T J 的条件数, 过大说明参数之间难以区分
+    QVector<QVector<double>> covariance;  // sigma2 * (J^T J)^-1 (奇异时取伪逆)
+    QVector<QVector<double>> correlation;
+    QVector<double> standardErrors;
+};
+
+// J 为 m x n (残差对拟合坐标的导数), residuals 为收敛点残差
+Covariance covarianceFromJacobian(const QVector<QVector<double>>& J, const QVector<double>& residuals);
+
+// 有放回抽样 n 个下标 (固定种子, 结果可复现)
+QVector<int> resampleIndices(int n, quint32 seed);
+
+// 分位数 (0..1, 排序后线性插值); 空序列返回 NaN
+double percentile(QVector<double> values, double q);
+
+struct ParameterInterval {
+    QString name;
+    double value = 0.0;
+    bool logScale = false;       // 标准误差与区间在 log10 坐标下计算
+    double standardError = 0.0;  // 拟合坐标下
+    double lower = 0.0;          // 线性化 95% 区间 (参数单位)
+    double upper = 0.0;
+    double bootstrapLower = 0.0; // 自助 2.5% / 97.5% 分位数 (参数单位), 无样本时为 NaN
+    double bootstrapUpper = 0.0;
+};
+
+struct Result {
+    QVector<ParameterInterval> parameters;
+    QVector<QVector<double>> correlation;
+    int dof = 0;
+    double sigma2 = 0.0;
+    double conditionNumber = 0.0;
+    int bootstrapRequested = 0;
+    int bootstrapCompleted = 0;
+
+    bool isEmpty() const { return parameters.isEmpty(); }
+    QJsonObject toJson() const;
+    static Result fromJson(const QJsonObject& obj);
+};
+
+/**
+ * @brief 汇总: 线性化区间取 ±1.96 倍标准误差 (自由度较大时的正态近似),
+ *        bootstrapSamples[k] 为第 k 次重拟合的参数值 (参数单位, 与 names 同序)
+ */
+Result summarize(const QStringList& names, const QVector<double>& values, const QVector<bool>& logScale,
+                 const Covariance& cov, const QVector<QVector<double>>& bootstrapSamples, int bootstrapRequested);
+
+} // namespace FitUncertainty
+
+#endif // FITUNCERTAINTY_H
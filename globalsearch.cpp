@@ -0,0 +1,115 @@
+#include "globalsearch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace GlobalSearch {
+
+namespace {
+
+bool byValue(const Candidate& a, const Candidate& b)
+{
+    // NaN 排在最后
+    if (std::isnan(a.value)) return false;
+    if (std::isnan(b.value)) return true;
+    return a.value < b.value;
+}
+
+} // namespace
+
+QVector<QVector<double>> latinHypercube(int n, int dim, quint32 seed)
+{
+    QVector<QVector<double>> pts(n, QVector<double>(dim, 0.0));
+    if (n <= 0 || dim <= 0) return pts;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uni(0.0, 1.0);
+    std::vector<int> perm(n);
+    for (int d = 0; d < dim; ++d) {
+        for (int i = 0; i < n; ++i) perm[i] = i;
+        std::shuffle(perm.begin(), perm.end(), rng);
+        for (int i = 0; i < n; ++i) pts[i][d] = (perm[i] + uni(rng)) / n;
+    }
+    return pts;
+}
+
+QVector<Candidate> differentialEvolution(int dim, const BatchObjective& f, const DEOptions& options,
+                                         const ProgressCallback& progress)
+{
+    int np = options.population > 0 ? options.population : std::max(12, 8 * dim);
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<double> uni(0.0, 1.0);
+    std::uniform_int_distribution<int> pick(0, np - 1);
+    std::uniform_int_distribution<int> pickDim(0, std::max(0, dim - 1));
+
+    QVector<Candidate> pop(np);
+    QVector<QVector<double>> init = latinHypercube(np, dim, options.seed);
+    QVector<double> values = f(init);
+    for (int i = 0; i < np; ++i) {
+        pop[i].x = init[i];
+        pop[i].value = (i < values.size()) ? values[i] : NAN;
+        pop[i].index = i;
+    }
+
+    auto bestOf = [&]() { return *std::min_element(pop.begin(), pop.end(), byValue); };
+    if (progress && !progress(0, bestOf())) {
+        std::sort(pop.begin(), pop.end(), byValue);
+        return pop;
+    }
+
+    for (int g = 1; g <= options.generations; ++g) {
+        // 一代的全部试探向量先生成, 再整批求值 (批内可并行)
+        QVector<QVector<double>> trials(np, QVector<double>(dim));
+        for (int i = 0; i < np; ++i) {
+            int a, b, c;
+            do { a = pick(rng); } while (a == i);
+            do { b = pick(rng); } while (b == i || b == a);
+            do { c = pick(rng); } while (c == i || c == a || c == b);
+            int jRand = pickDim(rng);
+            for (int d = 0; d < dim; ++d) {
+                double v = pop[i].x[d];
+                if (d == jRand || uni(rng) < options.CR) {
+                    v = pop[a].x[d] + options.F * (pop[b].x[d] - pop[c].x[d]);
+                    // 越界时在父代与边界之间随机取点 (保持分布, 避免堆积在边界上)
+                    if (v < 0.0) v = pop[i].x[d] * uni(rng);
+                    else if (v > 1.0) v = pop[i].x[d] + (1.0 - pop[i].x[d]) * uni(rng);
+                }
+                trials[i][d] = v;
+            }
+        }
+        QVector<double> tv = f(trials);
+        for (int i = 0; i < np; ++i) {
+            double v = (i < tv.size()) ? tv[i] : NAN;
+            if (!std::isnan(v) && (std::isnan(pop[i].value) || v <= pop[i].value)) {
+                pop[i].x = trials[i];
+                pop[i].value = v;
+            }
+        }
+        if (progress && !progress(g, bestOf())) break;
+    }
+
+    std::sort(pop.begin(), pop.end(), byValue);
+    return pop;
+}
+
+QVector<Candidate> distinctMinima(QVector<Candidate> candidates, int n, double tol)
+{
+    std::sort(candidates.begin(), candidates.end(), byValue);
+    QVector<Candidate> out;
+    for (const Candidate& c : candidates) {
+        if ((int)out.size() >= n) break;
+        if (std::isnan(c.value)) continue;
+        bool duplicate = false;
+        for (const Candidate& o : out) {
+            bool close = true;
+            for (int d = 0; d < c.x.size() && d < o.x.size() && close; ++d) {
+                if (std::abs(c.x[d] - o.x[d]) >= tol) close = false;
+            }
+            if (close) { duplicate = true; break; }
+        }
+        if (!duplicate) out.append(c);
+    }
+    return out;
+}
+
+} // namespace GlobalSearch
@@ -0,0 +1,47 @@
+#ifndef GLOBALSEARCH_H
+#define GLOBALSEARCH_H
+
+#include <QVector>
+#include <functional>
+
+/**
+ * @brief 全局搜索工具: 拉丁超立方采样、差分进化、不同极小值筛选
+ *
+ * 与模型无关, 全部在单位超立方 [0,1]^dim 上工作, 由调用方把坐标映射到参数区间
+ * (对数或线性)。目标函数按批调用, 调用方可在批内并行求值。
+ */
+namespace GlobalSearch {
+
+struct Candidate {
+    QVector<double> x;   // 单位超立方坐标
+    double value = 0.0;  // 目标函数值 (越小越好)
+    int index = -1;      // 调用方的编号 (differentialEvolution 中为种群下标)
+};
+
+// 批量目标函数: 一次给出若干点, 返回对应的函数值
+using BatchObjective = std::function<QVector<double>(const QVector<QVector<double>>& points)>;
+// 每代结束时的回调 (当前最优); 返回 false 时提前停止
+using ProgressCallback = std::function<bool(int generation, const Candidate& best)>;
+
+// 拉丁超立方采样: n 个点, 每一维的 n 个分层各恰好落一个点
+QVector<QVector<double>> latinHypercube(int n, int dim, quint32 seed);
+
+struct DEOptions {
+    int population = 0;     // <= 0 时取 max(12, 8*dim)
+    int generations = 60;
+    double F = 0.7;         // 差分缩放
+    double CR = 0.9;        // 交叉概率
+    quint32 seed = 12345;
+};
+
+// 差分进化 (DE/rand/1/bin), 初始种群取拉丁超立方; 返回最终种群 (按函数值升序)
+QVector<Candidate> differentialEvolution(int dim, const BatchObjective& f, const DEOptions& options,
+                                         const ProgressCallback& progress = ProgressCallback());
+
+// 按函数值升序选出至多 n 个互不相同的极小值:
+// 单位坐标各分量之差都小于 tol 的候选视为同一极小值, 只保留较优者
+QVector<Candidate> distinctMinima(QVector<Candidate> candidates, int n, double tol = 0.02);
+
+} // namespace GlobalSearch
+
+#endif // GLOBALSEARCH_H
@@ -0,0 +1,75 @@
+#ifndef LAPLACECACHE_H
+#define LAPLACECACHE_H
+
+#include <QCache>
+#include <QVector>
+#include <QMutex>
+#include <QMutexLocker>
+#include <atomic>
+
+// 缓存命中统计 (pf 值缓存 + Bessel 前置因子缓存)
+struct LaplaceCacheStats {
+    quint64 pfHits = 0;
+    quint64 pfMisses = 0;
+    quint64 prefactorHits = 0;
+    quint64 prefactorMisses = 0;
+};
+
+/**
+ * @brief 拉普拉斯空间求值的有界缓存
+ *
+ * 以 (z, 参数向量) 的精确值作为键, 缓存 flaplace_composite 的 pf(z)
+ * 以及 PWD_composite 中与裂缝几何无关的 Bessel 前置因子。
+ * Stehfest 横坐标 z = m*ln2/tD 在同一参数组下大量重复, LM 拟合中
+ * 雅可比逐个扰动参数时其余项也保持不变, 因此命中率很高。
+ *
+ * 线程安全: 查找/插入由互斥锁保护, 可被并行反演的工作线程同时调用。
+ */
+template <typename Value>
+class LaplaceCache
+{
+public:
+    explicit LaplaceCache(int maxEntries = 20000) : m_hits(0), m_misses(0) {
+        m_cache.setMaxCost(maxEntries);
+    }
+
+    // 查找缓存, 命中返回 true 并写入 value
+    bool lookup(const QVector<double>& key, Value& value) {
+        QMutexLocker locker(&m_mutex);
+        const Value* v = m_cache.object(key);
+        if (v) {
+            value = *v;
+            ++m_hits;
+            return true;
+        }
+        ++m_misses;
+        return false;
+    }
+
+    void insert(const QVector<double>& key, const Value& value) {
+        QMutexLocker locker(&m_mutex);
+        m_cache.insert(key, new Value(value), 1);
+    }
+
+    void clear() {
+        QMutexLocker locker(&m_mutex);
+        m_cache.clear();
+    }
+
+    void setMaxEntries(int maxEntries) {
+        QMutexLocker locker(&m_mutex);
+        m_cache.setMaxCost(maxEntries);
+    }
+
+    quint64 hits() const { return m_hits.load(); }
+    quint64 misses() const { return m_misses.load(); }
+    void resetCounters() { m_hits = 0; m_misses = 0; }
+
+private:
+    QMutex m_mutex;
+    QCache<QVector<double>, Value> m_cache;
+    std::atomic<quint64> m_hits;
+    std::atomic<quint64> m_misses;
+};
+
+#endif // LAPLACECACHE_H
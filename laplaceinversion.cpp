@@ -0,0 +1,189 @@
+#include "laplaceinversion.h"
+#include "stehfest.h"
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+namespace LaplaceInversion {
+
+namespace {
+
+using cd = std::complex<double>;
+const double kPi = 3.14159265358979323846;
+
+// F 返回 NaN/Inf 时按 0 处理 (与原 Stehfest 循环一致)
+inline double finiteOr0(double v) { return std::isfinite(v) ? v : 0.0; }
+inline cd finiteOr0(cd v) { return (std::isfinite(v.real()) && std::isfinite(v.imag())) ? v : cd(0.0, 0.0); }
+
+} // namespace
+
+int defaultOrder(LaplaceInversionMethod method)
+{
+    switch (method) {
+    case LaplaceInversionMethod::Talbot: return 16;
+    case LaplaceInversionMethod::DeHoog: return 8;
+    case LaplaceInversionMethod::Euler:  return 11;
+    default:                             return 8;
+    }
+}
+
+int normalizeOrder(LaplaceInversionMethod method, int order)
+{
+    switch (method) {
+    case LaplaceInversionMethod::Talbot: return std::clamp(order, 4, 32);
+    case LaplaceInversionMethod::DeHoog: return std::clamp(order, 2, 16);
+    case LaplaceInversionMethod::Euler:  return std::clamp(order, 4, 20);
+    default:                             return Stehfest::normalizeN(order);
+    }
+}
+
+int evaluationsPerPoint(LaplaceInversionMethod method, int order)
+{
+    int n = normalizeOrder(method, order);
+    switch (method) {
+    case LaplaceInversionMethod::Talbot: return n;
+    case LaplaceInversionMethod::DeHoog:
+    case LaplaceInversionMethod::Euler:  return 2 * n + 1;
+    default:                             return n;
+    }
+}
+
+QString methodName(LaplaceInversionMethod method)
+{
+    switch (method) {
+    case LaplaceInversionMethod::Talbot: return "Talbot";
+    case LaplaceInversionMethod::DeHoog: return "de Hoog";
+    case LaplaceInversionMethod::Euler:  return "Euler";
+    default:                             return "Stehfest";
+    }
+}
+
+double stehfest(const RealFunction& F, double t, int N)
+{
+    N = Stehfest::normalizeN(N);
+    const double* V = Stehfest::coefficients(N);
+    double ln2t = std::log(2.0) / t;
+    // 交替求和以 long double 累加, 减小高阶 N 的相消误差
+    long double sum = 0.0L;
+    for (int m = 1; m <= N; ++m) sum += (long double)V[m] * finiteOr0(F(m * ln2t));
+    return (double)sum * ln2t;
+}
+
+// 固定 Talbot: s(θ) = r*θ*(cotθ + i), r = 2M/(5t), θ_k = kπ/M
+// f(t) ≈ r/M * [ F(r)e^{rt}/2 + Σ_{k=1}^{M-1} Re( e^{t s_k} F(s_k) (1 + iσ_k) ) ],
+// σ_k = θ_k + (θ_k cotθ_k - 1) cotθ_k
+double talbot(const ComplexFunction& F, double t, int M)
+{
+    M = normalizeOrder(LaplaceInversionMethod::Talbot, M);
+    double r = 2.0 * M / (5.0 * t);
+    double sum = 0.5 * finiteOr0(F(cd(r, 0.0))).real() * std::exp(r * t);
+    for (int k = 1; k < M; ++k) {
+        double theta = k * kPi / M;
+        double cot = std::cos(theta) / std::sin(theta);
+        cd s(r * theta * cot, r * theta);
+        double sigma = theta + (theta * cot - 1.0) * cot;
+        sum += (std::exp(t * s) * finiteOr0(F(s)) * cd(1.0, sigma)).real();
+    }
+    return r / M * sum;
+}
+
+// Euler: β_k = A/2 + iπk (A = M ln10 * 2/3), f(t) ≈ 10^{M/3}/t * Σ_{k=0}^{2M} η_k Re F(β_k/t)
+// η_k = (-1)^k ξ_k, ξ_0 = 1/2, ξ_k = 1 (1<=k<=M), ξ_{2M} = 2^{-M},
+// ξ_{2M-j} = ξ_{2M-j+1} + 2^{-M} C(M, j) (0<j<M)
+double euler(const ComplexFunction& F, double t, int M)
+{
+    M = normalizeOrder(LaplaceInversionMethod::Euler, M);
+    std::vector<double> xi(2 * M + 1, 1.0);
+    xi[0] = 0.5;
+    double p2 = std::pow(2.0, -M);
+    xi[2 * M] = p2;
+    double binom = 1.0; // C(M, j)
+    for (int j = 1; j < M; ++j) {
+        binom = binom * (M - j + 1) / j;
+        xi[2 * M - j] = xi[2 * M - j + 1] + p2 * binom;
+    }
+
+    double a = M * std::log(10.0) / 3.0;
+    double sum = 0.0;
+    for (int k = 0; k <= 2 * M; ++k) {
+        cd beta(a, kPi * k);
+        double eta = (k % 2 == 0) ? xi[k] : -xi[k];
+        sum += eta * finiteOr0(F(beta / t)).real();
+    }
+    return std::pow(10.0, M / 3.0) / t * sum;
+}
+
+// de Hoog: 周期 2T (T = 2t) 的 Fourier 级数, 以商差算法构造连分式后取对角 Padé 近似
+// 结构参照 de Hoog, Knight & Stokes (1982); γ 由目标误差 tol 确定: γ = -ln(tol)/(2T)
+double deHoog(const ComplexFunction& F, double t, int M)
+{
+    M = normalizeOrder(LaplaceInversionMethod::DeHoog, M);
+    const int np = 2 * M + 1;
+    const double T = 2.0 * t;
+    const double tol = 1e-10;
+    const double gamma = -std::log(tol) / (2.0 * T);
+
+    std::vector<cd> fp(np);
+    for (int k = 0; k < np; ++k) fp[k] = finiteOr0(F(cd(gamma, kPi * k / T)));
+
+    // QD 表: e[i][r], q[i][r]
+    std::vector<std::vector<cd>> e(np, std::vector<cd>(M + 1, cd(0.0, 0.0)));
+    std::vector<std::vector<cd>> q(2 * M, std::vector<cd>(M, cd(0.0, 0.0)));
+    if (std::abs(fp[0]) < 1e-300) return 0.0;
+    q[0][0] = fp[1] / (fp[0] * 0.5);
+    for (int i = 1; i < 2 * M; ++i) {
+        if (std::abs(fp[i]) < 1e-300) return 0.0;
+        q[i][0] = fp[i + 1] / fp[i];
+    }
+    // 菱形法则填充
+    for (int r = 1; r <= M; ++r) {
+        int mr = 2 * (M - r) + 1;
+        for (int i = 0; i < mr; ++i) e[i][r] = q[i + 1][r - 1] - q[i][r - 1] + e[i + 1][r - 1];
+        if (r < M) {
+            for (int i = 0; i < mr - 1; ++i) {
+                if (std::abs(e[i][r]) < 1e-300) return 0.0;
+                q[i][r] = q[i + 1][r - 1] * e[i + 1][r] / e[i][r];
+            }
+        }
+    }
+
+    // 连分式系数
+    std::vector<cd> d(np);
+    d[0] = fp[0] * 0.5;
+    for (int r = 1; r <= M; ++r) {
+        d[2 * r - 1] = -q[0][r - 1];
+        d[2 * r] = -e[0][r];
+    }
+
+    // Padé 递推 A/B
+    std::vector<cd> A(np + 1), B(np + 1);
+    A[0] = cd(0.0, 0.0);
+    A[1] = d[0];
+    B[0] = B[1] = cd(1.0, 0.0);
+    cd z = std::exp(cd(0.0, kPi * t / T));
+    for (int i = 1; i < 2 * M; ++i) {
+        A[i + 1] = A[i] + d[i] * A[i - 1] * z;
+        B[i + 1] = B[i] + d[i] * B[i - 1] * z;
+    }
+    // 改进余项
+    cd brem = (1.0 + (d[2 * M - 1] - d[2 * M]) * z) * 0.5;
+    cd rem = brem * (std::sqrt(1.0 + d[2 * M] * z / (brem * brem)) - 1.0);
+    A[np] = A[2 * M] + rem * A[2 * M - 1];
+    B[np] = B[2 * M] + rem * B[2 * M - 1];
+
+    return std::exp(gamma * t) / T * (A[np] / B[np]).real();
+}
+
+double invert(LaplaceInversionMethod method, int order, double t,
+              const RealFunction& realF, const ComplexFunction& complexF)
+{
+    switch (method) {
+    case LaplaceInversionMethod::Talbot: return talbot(complexF, t, order);
+    case LaplaceInversionMethod::DeHoog: return deHoog(complexF, t, order);
+    case LaplaceInversionMethod::Euler:  return euler(complexF, t, order);
+    default:                             return stehfest(realF, t, order);
+    }
+}
+
+} // namespace LaplaceInversion
@@ -0,0 +1,56 @@
+#ifndef LAPLACEINVERSION_H
+#define LAPLACEINVERSION_H
+
+#include <complex>
+#include <functional>
+#include <QString>
+
+/**
+ * @brief 拉普拉斯数值反演算法
+ *
+ *   Stehfest - 实轴求值, 节点数 N (偶数, <= Stehfest::MaxN), 对振荡/阶跃型解精度有限;
+ *   Talbot   - 固定 Talbot 围道 (Abate-Valkó), M 个复数节点, 指数收敛;
+ *   DeHoog   - 梯形公式 + 商差 (QD) 连分式加速 (de Hoog, Knight & Stokes), 2M+1 个节点;
+ *   Euler    - Bromwich 积分梯形离散 + 二项式 Euler 求和 (Abate-Whitt), 2M+1 个节点。
+ *
+ * 复平面方法要求 F(s) 可在 Re(s) > 0 的复数 s 上求值。双精度下各方法有效位数受
+ * 节点处的指数放大 exp(Re(s)*t) 限制, 阶数不宜过高, 由 normalizeOrder 截断。
+ */
+enum class LaplaceInversionMethod {
+    Stehfest = 0,
+    Talbot,
+    DeHoog,
+    Euler
+};
+
+namespace LaplaceInversion {
+
+using RealFunction = std::function<double(double)>;
+using ComplexFunction = std::function<std::complex<double>(std::complex<double>)>;
+
+// 是否需要复数 F(s)
+inline bool needsComplex(LaplaceInversionMethod method) { return method != LaplaceInversionMethod::Stehfest; }
+
+// 默认阶数与合法范围截断
+int defaultOrder(LaplaceInversionMethod method);
+int normalizeOrder(LaplaceInversionMethod method, int order);
+
+// 每个时间点需要的 F(s) 求值次数
+int evaluationsPerPoint(LaplaceInversionMethod method, int order);
+
+// 显示名称
+QString methodName(LaplaceInversionMethod method);
+
+// 各算法 f(t) 的单点反演 (t > 0)
+double stehfest(const RealFunction& F, double t, int N);
+double talbot(const ComplexFunction& F, double t, int M);
+double deHoog(const ComplexFunction& F, double t, int M);
+double euler(const ComplexFunction& F, double t, int M);
+
+// 统一入口: 按 method 选择 F 的实数或复数版本
+double invert(LaplaceInversionMethod method, int order, double t,
+              const RealFunction& realF, const ComplexFunction& complexF);
+
+} // namespace LaplaceInversion
+
+#endif // LAPLACEINVERSION_H
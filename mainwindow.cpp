@@ -13,7 +13,6 @@
 #include <QDateTime>
 #include <QMessageBox>
 #include <QDebug>
-#include <QStandardItemModel>
 #include <QTimer>
 #include <QSpacerItem>
 #include <QStackedWidget>
@@ -124,6 +123,7 @@ void MainWindow::init()
     ui->verticalLayoutHandle->addWidget(m_DataEditorWidget);
     connect(m_DataEditorWidget, &DataEditorWidget::fileChanged, this, &MainWindow::onFileLoaded);
     connect(m_DataEditorWidget, &DataEditorWidget::dataChanged, this, &MainWindow::onDataEditorDataChanged);
+    connect(m_DataEditorWidget, &DataEditorWidget::loadingFinished, this, &MainWindow::onDataLoadingFinished);
 
     // 3.3 模型管理器
     m_ModelManager = new ModelManager(this);
@@ -210,11 +210,23 @@ void MainWindow::onFileLoaded(const QString& filePath, const QString& fileType)
         item++;
     }
 
+    m_hasValidData = true;
     if (m_DataEditorWidget && sender() != m_DataEditorWidget) {
+        // 文本文件在后台解析, 加载结束 (loadingFinished) 后再传给绘图页
+        m_plotAfterLoad = true;
         m_DataEditorWidget->loadData(filePath, fileType);
+    } else {
+        onDataReadyForPlotting();
+    }
+}
+
+void MainWindow::onDataLoadingFinished(bool success)
+{
+    if (!m_plotAfterLoad) return;
+    m_plotAfterLoad = false;
+    if (success) {
+        onDataReadyForPlotting();
     }
-    m_hasValidData = true;
-    QTimer::singleShot(1000, this, &MainWindow::onDataReadyForPlotting);
 }
 
 void MainWindow::onPlotAnalysisCompleted(const QString &analysisType, const QMap<QString, double> &results)
@@ -250,28 +262,28 @@ void MainWindow::transferDataToFitting()
 {
     if (!m_FittingPage || !m_DataEditorWidget) return;
 
-    QStandardItemModel* model = m_DataEditorWidget->getDataModel();
-    if (!model || model->rowCount() == 0) {
+    DataTableModel* model = m_DataEditorWidget->getDataModel();
+    if (!model || model->rowCount() == 0 || model->columnCount() < 2) {
         return;
     }
 
+    // 第 0 / 1 列按数值直接读取, 空白或非数值单元格为 NaN, 下面的比较自然跳过
+    const QVector<double> tCol = model->columnValues(0);
+    const QVector<double> pCol = model->columnValues(1);
+
     QVector<double> tVec, pVec, dVec;
     double p_initial = 0.0;
 
-    for(int r=0; r<model->rowCount(); ++r) {
-        QModelIndex idx = model->index(r, 1);
-        if(idx.isValid()) {
-            double p = idx.data().toDouble();
-            if (std::abs(p) > 1e-6) {
-                p_initial = p;
-                break;
-            }
+    for(int r=0; r<pCol.size(); ++r) {
+        if (std::abs(pCol[r]) > 1e-6) {
+            p_initial = pCol[r];
+            break;
         }
     }
 
-    for(int r=0; r<model->rowCount(); ++r) {
-        double t = model->index(r, 0).data().toDouble();
-        double p_raw = model->index(r, 1).data().toDouble();
+    for(int r=0; r<tCol.size(); ++r) {
+        double t = tCol[r];
+        double p_raw = std::isnan(pCol[r]) ? 0.0 : pCol[r];
         if (t > 0) {
             tVec.append(t);
             pVec.append(std::abs(p_raw - p_initial));
@@ -313,7 +325,7 @@ void MainWindow::onAutoSaveIntervalChanged(int interval) { Q_UNUSED(interval); }
 void MainWindow::onBackupSettingsChanged(bool enabled) { Q_UNUSED(enabled); }
 void MainWindow::onPerformanceSettingsChanged() {}
 
-QStandardItemModel* MainWindow::getDataEditorModel() const
+DataTableModel* MainWindow::getDataEditorModel() const
 {
     if (!m_DataEditorWidget) return nullptr;
     return m_DataEditorWidget->getDataModel();
@@ -334,7 +346,7 @@ bool MainWindow::hasDataLoaded()
 void MainWindow::transferDataFromEditorToPlotting()
 {
     if (!m_DataEditorWidget || !m_PlottingWidget) return;
-    QStandardItemModel* model = m_DataEditorWidget->getDataModel();
+    DataTableModel* model = m_DataEditorWidget->getDataModel();
     if (model && model->rowCount() > 0 && model->columnCount() > 0) {
         QString fileName = m_DataEditorWidget->getCurrentFileName();
         m_PlottingWidget->setTableDataFromModel(model, fileName);
@@ -4,12 +4,12 @@
 #include <QMainWindow>
 #include <QMap>
 #include <QTimer>
-#include <QStandardItemModel>
 #include "modelmanager.h"
 
 class NavBtn;
 class WT_ProjectWidget; // [修改] 使用 WT_ProjectWidget
 class DataEditorWidget;
+class DataTableModel;
 class PlottingWidget;
 class FittingPage;
 class SettingsWidget;
@@ -40,6 +40,7 @@ private slots:
     void onFileLoaded(const QString& filePath, const QString& fileType);
     void onPlotAnalysisCompleted(const QString &analysisType, const QMap<QString, double> &results);
     void onDataReadyForPlotting();
+    void onDataLoadingFinished(bool success);
     void onTransferDataToPlotting();
     void onDataEditorDataChanged();
     void onSystemSettingsChanged();
@@ -63,6 +64,7 @@ private:
     QMap<QString,NavBtn*> m_NavBtnMap;
     QTimer m_timer;
     bool m_hasValidData = false;
+    bool m_plotAfterLoad = false;   // 由 onFileLoaded 发起的加载结束后传给绘图页
 
     // 是否已加载项目（新建或打开）
     bool m_isProjectLoaded = false;
@@ -71,7 +73,7 @@ private:
     void updateNavigationState();
     void transferDataToFitting();
 
-    QStandardItemModel* getDataEditorModel() const;
+    DataTableModel* getDataEditorModel() const;
     QString getCurrentFileName() const;
     bool hasDataLoaded();
     WellTestData createDemoWellTestData();
@@ -0,0 +1,211 @@
+#include "mappedtextfile.h"
+
+#include <QThread>
+#include <QtConcurrent>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// 小于该大小的文件单线程建立行索引
+const qint64 kParallelIndexBytes = 16 * 1024 * 1024;
+
+bool isBlank(const char* begin, const char* end)
+{
+    for (const char* p = begin; p < end; ++p) {
+        if (*p != ' ' && *p != '\t' && *p != '\r' && *p != '\f' && *p != '\v') return false;
+    }
+    return true;
+}
+
+} // namespace
+
+MappedTextFile::MappedTextFile()
+    : m_data(nullptr),
+      m_dataStart(0),
+      m_size(0),
+      m_lineMode(KeepEmptyLines),
+      m_localEncoding(false)
+{
+}
+
+MappedTextFile::~MappedTextFile()
+{
+    close();
+}
+
+bool MappedTextFile::open(const QString& filePath, LineMode mode, QString* errorMessage)
+{
+    close();
+    m_lineMode = mode;
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        if (errorMessage) *errorMessage = QString("无法打开文件: %1").arg(m_file.errorString());
+        return false;
+    }
+    m_size = m_file.size();
+    if (m_size == 0) {
+        // 空文件无法映射, 视为零行
+        m_data = "";
+        return true;
+    }
+    uchar* mapped = m_file.map(0, m_size);
+    if (mapped) {
+        m_data = reinterpret_cast<const char*>(mapped);
+    } else {
+        // 网络盘等不支持映射时整个读入
+        m_buffer = m_file.readAll();
+        if (m_buffer.size() != m_size) {
+            if (errorMessage) *errorMessage = QString("无法读取文件: %1").arg(m_file.errorString());
+            close();
+            return false;
+        }
+        m_file.close();
+        m_data = m_buffer.constData();
+    }
+
+    // 跳过 UTF-8 BOM
+    if (m_size >= 3 && std::memcmp(m_data, "\xEF\xBB\xBF", 3) == 0) m_dataStart = 3;
+    buildIndex(mode);
+    return true;
+}
+
+void MappedTextFile::buildIndex(LineMode mode)
+{
+    const char* end = m_data + m_size;
+    // 扫描 [from, to) 内开始的行: 行可以跨过 to, 由起点所在的块负责
+    auto scan = [this, mode, end](const char* from, const char* to, QVector<qint64>& starts) {
+        starts.reserve(int(qMin<qint64>((to - from) / 16 + 1, std::numeric_limits<int>::max() / 2)));
+        const char* p = from;
+        while (p < to) {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', size_t(end - p)));
+            const char* lineEnd = nl ? nl : end;
+            if (mode == KeepEmptyLines || !isBlank(p, lineEnd)) starts.append(p - m_data);
+            p = nl ? nl + 1 : end;
+        }
+    };
+
+    const char* begin = m_data + m_dataStart;
+    const int threads = QThread::idealThreadCount();
+    if (m_size < kParallelIndexBytes || threads <= 1) {
+        scan(begin, end, m_lineStarts);
+        m_lineStarts.squeeze();
+        return;
+    }
+
+    // 按字节等分, 块起点移到块内第一个行首 (前一字节为换行符); 没有行首的块为空
+    struct Chunk { const char* from; const char* to; QVector<qint64> starts; };
+    const qint64 chunkBytes = (end - begin) / threads + 1;
+    QVector<Chunk> chunks;
+    for (const char* from = begin; from < end; from += qMin<qint64>(chunkBytes, end - from)) {
+        chunks.append(Chunk{from, from + qMin<qint64>(chunkBytes, end - from), QVector<qint64>()});
+    }
+    QtConcurrent::blockingMap(chunks, [&scan, begin](Chunk& chunk) {
+        const char* from = chunk.from;
+        if (from > begin && from[-1] != '\n') {
+            const char* nl = static_cast<const char*>(std::memchr(from, '\n', size_t(chunk.to - from)));
+            if (!nl) return;
+            from = nl + 1;
+        }
+        scan(from, chunk.to, chunk.starts);
+    });
+
+    int total = 0;
+    for (const Chunk& chunk : chunks) total += chunk.starts.size();
+    m_lineStarts.reserve(total);
+    for (const Chunk& chunk : chunks) m_lineStarts += chunk.starts;
+}
+
+void MappedTextFile::close()
+{
+    if (m_file.isOpen()) {
+        if (m_size > 0 && m_data && m_buffer.isNull()) m_file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(m_data)));
+        m_file.close();
+    }
+    m_buffer.clear();
+    m_data = nullptr;
+    m_dataStart = 0;
+    m_size = 0;
+    m_lineStarts.clear();
+}
+
+QByteArray MappedTextFile::head(int bytes) const
+{
+    if (!m_data) return QByteArray();
+    return QByteArray::fromRawData(m_data + m_dataStart, int(qMin<qint64>(bytes, m_size - m_dataStart)));
+}
+
+QByteArray MappedTextFile::line(int i) const
+{
+    if (i < 0 || i >= m_lineStarts.size()) return QByteArray();
+    const char* begin = m_data + m_lineStarts[i];
+    const char* end = m_data + m_size;
+    const char* nl = static_cast<const char*>(std::memchr(begin, '\n', size_t(end - begin)));
+    if (nl) end = nl;
+    if (end > begin && end[-1] == '\r') --end;
+    return QByteArray::fromRawData(begin, int(end - begin));
+}
+
+QString MappedTextFile::decode(const QByteArray& bytes) const
+{
+    return m_localEncoding ? QString::fromLocal8Bit(bytes) : QString::fromUtf8(bytes);
+}
+
+QList<QByteArray> MappedTextFile::splitLine(const QByteArray& line, const QByteArray& separator)
+{
+    QList<QByteArray> result;
+    QByteArray current;
+    bool inQuotes = false;
+    const int sepLen = separator.size();
+
+    for (int i = 0; i < line.size(); ++i) {
+        char ch = line.at(i);
+        if (ch == '"') {
+            inQuotes = !inQuotes;
+        } else if (!inQuotes && sepLen > 0 && line.size() - i >= sepLen
+                   && std::memcmp(line.constData() + i, separator.constData(), size_t(sepLen)) == 0) {
+            result.append(current.trimmed());
+            current.clear();
+            i += sepLen - 1;
+        } else {
+            current.append(ch);
+        }
+    }
+
+    result.append(current.trimmed());
+    return result;
+}
+
+QByteArray MappedTextFile::field(const QByteArray& line, const QByteArray& separator, int index)
+{
+    if (index < 0) return QByteArray();
+    const int sepLen = separator.size();
+    int current = 0;
+    bool inQuotes = false;
+    bool quoted = false;
+    int start = 0;
+
+    for (int i = 0; i <= line.size(); ++i) {
+        bool atEnd = i == line.size();
+        if (!atEnd && line.at(i) == '"') {
+            inQuotes = !inQuotes;
+            quoted = true;
+            continue;
+        }
+        bool atSeparator = !atEnd && !inQuotes && sepLen > 0 && line.size() - i >= sepLen
+                           && std::memcmp(line.constData() + i, separator.constData(), size_t(sepLen)) == 0;
+        if (!atEnd && !atSeparator) continue;
+
+        if (current == index) {
+            QByteArray f = line.mid(start, i - start);
+            if (quoted) f.replace('"', QByteArray());
+            return f.trimmed();
+        }
+        if (atEnd) break;
+        ++current;
+        i += sepLen - 1;
+        start = i + 1;
+        quoted = false;
+    }
+    return QByteArray();
+}
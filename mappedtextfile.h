@@ -0,0 +1,74 @@
+#ifndef MAPPEDTEXTFILE_H
+#define MAPPEDTEXTFILE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief 内存映射的文本文件与行起点索引
+ *
+ * open() 映射整个文件并建立每行的起始偏移 (每行 8 字节), 之后按行号随机访问;
+ * 较大的文件按字节切块并行扫描换行符, 各块从块内第一个行首开始, 结果按块序拼接。
+ * line() 直接指向映射内存, 不复制也不解码。大文件模式下数据表只为可见单元格取行解析,
+ * 数值列解析一次后存为 double 列, 全文不再以 QString 形式驻留内存。
+ * 对象不可复制, 由 QSharedPointer 在数据表模型之间共享; 映射在析构或 close() 时解除。
+ * 文件系统不支持映射时整个读入内存, 接口不变。
+ * 打开后只读, line() 等 const 接口可在多个线程同时调用。
+ */
+class MappedTextFile
+{
+    Q_DISABLE_COPY(MappedTextFile)
+
+public:
+    enum LineMode { KeepEmptyLines = 0, SkipEmptyLines };
+
+    MappedTextFile();
+    ~MappedTextFile();
+
+    // 映射文件并建立行索引; SkipEmptyLines 时只含空白字符的行不编号
+    bool open(const QString& filePath, LineMode mode, QString* errorMessage = nullptr);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    QString fileName() const { return m_file.fileName(); }
+    qint64 size() const { return m_size; }
+    int lineCount() const { return m_lineStarts.size(); }
+
+    // 第 i 行 (不含行尾 \r\n), 指向映射内存, 文件关闭前有效
+    QByteArray line(int i) const;
+    QString lineText(int i) const { return decode(line(i)); }
+
+    // 字节解码: 默认 UTF-8, setLocalEncoding(true) 时按系统编码 (GBK 文件)
+    void setLocalEncoding(bool local) { m_localEncoding = local; }
+    bool localEncoding() const { return m_localEncoding; }
+    LineMode lineMode() const { return m_lineMode; }
+    QString decode(const QByteArray& bytes) const;
+
+    // 文件开头最多 bytes 字节 (不含 BOM), 供编码 / 分隔符检测
+    QByteArray head(int bytes) const;
+
+    // 行索引占用的内存 (字节)
+    qint64 indexMemory() const { return qint64(m_lineStarts.capacity()) * sizeof(qint64); }
+
+    // 按分隔符拆分一行: 双引号内的分隔符不拆分, 引号去掉, 字段去首尾空白 (与 DataEditorWidget::splitCSVLine 一致)
+    static QList<QByteArray> splitLine(const QByteArray& line, const QByteArray& separator);
+    // 只取第 index 个字段, 不存在时返回空
+    static QByteArray field(const QByteArray& line, const QByteArray& separator, int index);
+
+private:
+    void buildIndex(LineMode mode);
+
+    QFile m_file;
+    QByteArray m_buffer;    // 无法映射时读入的全文
+    const char* m_data;
+    qint64 m_dataStart;     // 跳过 BOM 后的起点
+    qint64 m_size;
+    LineMode m_lineMode;
+    QVector<qint64> m_lineStarts;
+    bool m_localEncoding;
+};
+
+#endif // MAPPEDTEXTFILE_H
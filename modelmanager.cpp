@@ -11,7 +11,7 @@
 #include <cmath>
 
 ModelManager::ModelManager(QWidget* parent)
-    : QObject(parent), m_mainWidget(nullptr), m_btnSelectModel(nullptr), m_modelStack(nullptr)
+    : QObject(parent), m_mainWidget(nullptr), m_btnSelectModel(nullptr), m_comboInversion(nullptr), m_modelStack(nullptr)
     , m_currentModelType(Model_1)
 {
 }
@@ -79,8 +79,22 @@ void ModelManager::setupModelSelection()
 
     connect(m_btnSelectModel, &QPushButton::clicked, this, &ModelManager::onSelectModelClicked);
 
+    // 拉普拉斯反演算法, 对全部模型生效 (拟合页面复制模型的求值选项, 随之切换)
+    QLabel* inversionLabel = new QLabel("反演算法:", selectionGroup);
+    m_comboInversion = new QComboBox(selectionGroup);
+    m_comboInversion->setMinimumHeight(30);
+    for (LaplaceInversionMethod method : { LaplaceInversionMethod::Stehfest, LaplaceInversionMethod::Talbot,
+                                           LaplaceInversionMethod::DeHoog, LaplaceInversionMethod::Euler }) {
+        m_comboInversion->addItem(LaplaceInversion::methodName(method), int(method));
+    }
+    m_comboInversion->setToolTip("Stehfest: 实轴求值, 速度最快\n"
+                                 "Talbot / de Hoog / Euler: 复平面反演, 精度更高, 适用于振荡或阶跃型解");
+    connect(m_comboInversion, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ModelManager::onInversionMethodChanged);
+
     selectionLayout->addWidget(infoLabel);
     selectionLayout->addWidget(m_btnSelectModel);
+    selectionLayout->addWidget(inversionLabel);
+    selectionLayout->addWidget(m_comboInversion);
 
     QVBoxLayout* mainLayout = qobject_cast<QVBoxLayout*>(m_mainWidget->layout());
     if (mainLayout) {
@@ -142,6 +156,12 @@ QString ModelManager::getModelTypeName(ModelType type)
     }
 }
 
+void ModelManager::onInversionMethodChanged(int index)
+{
+    if (!m_comboInversion || index < 0) return;
+    setInversionMethod(LaplaceInversionMethod(m_comboInversion->itemData(index).toInt()));
+}
+
 void ModelManager::onWidgetCalculationCompleted(const QString &t, const QMap<QString, double> &r) {
     emit calculationCompleted(t, r);
 }
@@ -152,6 +172,54 @@ void ModelManager::setHighPrecision(bool high) {
     }
 }
 
+void ModelManager::setInversionMethod(LaplaceInversionMethod method, int order) {
+    for(ModelWidget01_06* w : m_modelWidgets) {
+        w->setInversionMethod(method, order);
+    }
+}
+
+void ModelManager::setParallelEvaluation(bool enabled) {
+    for(ModelWidget01_06* w : m_modelWidgets) {
+        w->setParallelEvaluation(enabled);
+    }
+}
+
+void ModelManager::setEvaluationCacheEnabled(bool enabled) {
+    for(ModelWidget01_06* w : m_modelWidgets) {
+        w->setEvaluationCacheEnabled(enabled);
+    }
+}
+
+void ModelManager::clearEvaluationCache() {
+    for(ModelWidget01_06* w : m_modelWidgets) {
+        w->clearEvaluationCache();
+    }
+}
+
+LaplaceCacheStats ModelManager::getCacheStatistics() const {
+    LaplaceCacheStats total;
+    for(ModelWidget01_06* w : m_modelWidgets) {
+        LaplaceCacheStats st = w->cacheStatistics();
+        total.pfHits += st.pfHits;
+        total.pfMisses += st.pfMisses;
+        total.prefactorHits += st.prefactorHits;
+        total.prefactorMisses += st.prefactorMisses;
+    }
+    return total;
+}
+
+void ModelManager::resetCacheStatistics() {
+    for(ModelWidget01_06* w : m_modelWidgets) {
+        w->resetCacheStatistics();
+    }
+}
+
+quint64 ModelManager::getQuadratureEvaluations() const {
+    quint64 total = 0;
+    for(ModelWidget01_06* w : m_modelWidgets) total += w->quadratureEvaluations();
+    return total;
+}
+
 void ModelManager::updateAllModelsBasicParameters()
 {
     for(ModelWidget01_06* w : m_modelWidgets) {
@@ -212,14 +280,44 @@ ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const QMa
     return ModelCurveData();
 }
 
-QVector<double> ModelManager::generateLogTimeSteps(int count, double startExp, double endExp) {
-    QVector<double> t;
-    t.reserve(count);
-    for (int i = 0; i < count; ++i) {
-        double exponent = startExp + (endExp - startExp) * i / (count - 1);
-        t.append(pow(10.0, exponent));
+ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const CompositeParameters& params, const QVector<double>& providedTime, const ModelEvaluationOptions& options)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_modelWidgets.size()) {
+        return m_modelWidgets.at(index)->model()->calculateTheoreticalCurve(params, providedTime, options);
+    }
+    return ModelCurveData();
+}
+
+ModelEvaluationOptions ModelManager::getEvaluationOptions(ModelType type) const
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_modelWidgets.size()) {
+        return m_modelWidgets.at(index)->model()->evaluationOptions();
+    }
+    return ModelEvaluationOptions();
+}
+
+ModelSensitivityData ModelManager::calculateTheoreticalCurveSensitivity(ModelType type, const QMap<QString, double>& params, const QStringList& paramNames, const QVector<double>& providedTime)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_modelWidgets.size()) {
+        return m_modelWidgets[index]->calculateTheoreticalCurveSensitivity(params, paramNames, providedTime);
+    }
+    return ModelSensitivityData();
+}
+
+ModelSensitivityData ModelManager::calculateTheoreticalCurveSensitivity(ModelType type, const CompositeParameters& params, const QVector<CompositeParameters::Id>& paramIds, const QVector<double>& providedTime, const ModelEvaluationOptions& options)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_modelWidgets.size()) {
+        return m_modelWidgets.at(index)->model()->calculateTheoreticalCurveSensitivity(params, paramIds, providedTime, options);
     }
-    return t;
+    return ModelSensitivityData();
+}
+
+QVector<double> ModelManager::generateLogTimeSteps(int count, double startExp, double endExp) {
+    return CompositeModel::logTimeSteps(count, startExp, endExp);
 }
 
 void ModelManager::setObservedData(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d)
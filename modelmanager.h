@@ -6,6 +6,7 @@
 #include <QVector>
 #include <QStackedWidget>
 #include <QPushButton>
+#include <QComboBox>
 
 // 引入合并后的 ModelWidget 头文件
 #include "modelwidget01-06.h"
@@ -39,12 +40,39 @@ public:
     // 计算理论曲线接口 (供 FittingWidget 使用)
     ModelCurveData calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
 
+    // 以指定求值选项计算 (不修改模型的默认选项, 可在多个工作线程中并发调用)
+    // 参数为已解析的下标数组, 拟合迭代中不再经过 QMap
+    ModelCurveData calculateTheoreticalCurve(ModelType type, const CompositeParameters& params, const QVector<double>& providedTime,
+                                             const ModelEvaluationOptions& options);
+
+    // 模型当前的默认求值选项
+    ModelEvaluationOptions getEvaluationOptions(ModelType type) const;
+
+    // 理论曲线及参数灵敏度 (前向自动微分, 供 LM 解析雅可比使用)
+    ModelSensitivityData calculateTheoreticalCurveSensitivity(ModelType type, const QMap<QString, double>& params, const QStringList& paramNames,
+                                                              const QVector<double>& providedTime = QVector<double>());
+    ModelSensitivityData calculateTheoreticalCurveSensitivity(ModelType type, const CompositeParameters& params, const QVector<CompositeParameters::Id>& paramIds,
+                                                              const QVector<double>& providedTime, const ModelEvaluationOptions& options);
+
     // 获取默认参数 (供 FittingWidget 使用)
     QMap<QString, double> getDefaultParameters(ModelType type);
 
     // 设置所有模型的高精度模式
     void setHighPrecision(bool high);
 
+    // 设置所有模型的拉普拉斯反演算法 (Stehfest / Talbot / de Hoog / Euler)
+    void setInversionMethod(LaplaceInversionMethod method, int order = 0);
+
+    // 设置所有模型是否按时间点并行反演
+    void setParallelEvaluation(bool enabled);
+
+    // 拉普拉斯空间求值缓存: 开关、清空与命中统计 (汇总所有模型)
+    void setEvaluationCacheEnabled(bool enabled);
+    void clearEvaluationCache();
+    LaplaceCacheStats getCacheStatistics() const;
+    void resetCacheStatistics();
+    quint64 getQuadratureEvaluations() const;
+
     // 刷新所有模型的基础参数
     void updateAllModelsBasicParameters();
 
@@ -64,6 +92,7 @@ signals:
 
 private slots:
     void onSelectModelClicked();
+    void onInversionMethodChanged(int index);
     void onWidgetCalculationCompleted(const QString& t, const QMap<QString, double>& r);
 
 private:
@@ -74,6 +103,7 @@ private:
 private:
     QWidget* m_mainWidget;
     QPushButton* m_btnSelectModel;
+    QComboBox* m_comboInversion;
     QStackedWidget* m_modelStack;
 
     // 使用列表统一管理所有模型实例
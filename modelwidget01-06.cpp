@@ -9,6 +9,7 @@
  * 6. Model 6: 压裂水平井复合页岩油 - 定压边界 + 恒定井储 (对应 MATLAB: mAB=-K0/I0, CD/S=0)
  *
  * 核心算法基于提供的 MATLAB 文件: Composite_shale_oil_reservoir_fitfun.m
+ * 计算部分位于 CompositeModel (compositemodel.cpp), 本文件只负责界面与绘图。
  */
 
 #include "modelwidget01-06.h"
@@ -17,9 +18,6 @@
 #include "pressurederivativecalculator.h"
 #include "modelparameter.h"
 
-#include <Eigen/Dense>
-#include <boost/math/special_functions/bessel.hpp>
-
 #include <cmath>
 #include <algorithm>
 #include <QDebug>
@@ -28,6 +26,7 @@
 #include <QTextStream>
 #include <QDateTime>
 #include <QCoreApplication>
+#include <QThreadPool>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -37,7 +36,8 @@ ModelWidget01_06::ModelWidget01_06(ModelType type, QWidget *parent)
     : QWidget(parent)
     , ui(new Ui::ModelWidget01_06)
     , m_type(type)
-    , m_highPrecision(true)
+    , m_model(type)
+    , m_sweepArrived(0)
 {
     ui->setupUi(this);
     m_colorList = { Qt::red, Qt::blue, QColor(0,180,0), Qt::magenta, QColor(255,140,0), Qt::cyan };
@@ -48,7 +48,14 @@ ModelWidget01_06::ModelWidget01_06(ModelType type, QWidget *parent)
     onResetParameters();
 }
 
-ModelWidget01_06::~ModelWidget01_06() { delete ui; }
+ModelWidget01_06::~ModelWidget01_06()
+{
+    // 工作线程引用 m_model, 须等待正在计算的工况结束
+    m_sweepWatcher.cancel();
+    m_sweepCancel.cancel();
+    m_sweepWatcher.waitForFinished();
+    delete ui;
+}
 
 QString ModelWidget01_06::getModelName() const {
     switch(m_type) {
@@ -142,9 +149,30 @@ void ModelWidget01_06::setupConnections() {
     connect(ui->LEdit, &QLineEdit::editingFinished, this, &ModelWidget01_06::onDependentParamsChanged);
     connect(ui->LfEdit, &QLineEdit::editingFinished, this, &ModelWidget01_06::onDependentParamsChanged);
     connect(ui->checkShowPoints, &QCheckBox::toggled, this, &ModelWidget01_06::onShowPointsToggled);
+    connect(&m_sweepWatcher, &QFutureWatcher<SweepResult>::resultReadyAt, this, &ModelWidget01_06::onSweepResultReady);
+    connect(&m_sweepWatcher, &QFutureWatcher<SweepResult>::finished, this, &ModelWidget01_06::onSweepFinished);
+}
+
+void ModelWidget01_06::setHighPrecision(bool high) { m_model.setHighPrecision(high); }
+void ModelWidget01_06::setParallelEvaluation(bool enabled) { m_model.setParallelEvaluation(enabled); }
+void ModelWidget01_06::setInversionMethod(LaplaceInversionMethod method, int order) { m_model.setInversionMethod(method, order); }
+LaplaceInversionMethod ModelWidget01_06::inversionMethod() const { return m_model.inversionMethod(); }
+void ModelWidget01_06::setEvaluationCacheEnabled(bool enabled) { m_model.setEvaluationCacheEnabled(enabled); }
+void ModelWidget01_06::clearEvaluationCache() { m_model.clearEvaluationCache(); }
+LaplaceCacheStats ModelWidget01_06::cacheStatistics() const { return m_model.cacheStatistics(); }
+void ModelWidget01_06::resetCacheStatistics() { m_model.resetCacheStatistics(); }
+quint64 ModelWidget01_06::quadratureEvaluations() const { return m_model.quadratureEvaluations(); }
+const CompositeModel* ModelWidget01_06::model() const { return &m_model; }
+
+ModelCurveData ModelWidget01_06::calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime)
+{
+    return m_model.calculateTheoreticalCurve(params, providedTime);
 }
 
-void ModelWidget01_06::setHighPrecision(bool high) { m_highPrecision = high; }
+ModelSensitivityData ModelWidget01_06::calculateTheoreticalCurveSensitivity(const QMap<QString, double>& params, const QStringList& paramNames, const QVector<double>& providedTime)
+{
+    return m_model.calculateTheoreticalCurveSensitivity(params, paramNames, providedTime);
+}
 
 QVector<double> ModelWidget01_06::parseInput(const QString& text) {
     QVector<double> values;
@@ -226,16 +254,32 @@ void ModelWidget01_06::onShowPointsToggled(bool checked) {
 }
 
 void ModelWidget01_06::onCalculateClicked() {
-    ui->calculateButton->setEnabled(false);
-    ui->calculateButton->setText("计算中...");
-    QCoreApplication::processEvents();
+    // 计算进行中再次点击为取消: 尚未开始的工况不再计算, 已开始的在下一个时间点停止
+    if (m_sweepWatcher.isRunning()) {
+        m_sweepWatcher.cancel();
+        m_sweepCancel.cancel();
+        ui->calculateButton->setEnabled(false);
+        ui->calculateButton->setText("正在取消...");
+        return;
+    }
     runCalculation();
+}
+
+void ModelWidget01_06::setCalculationRunning(bool running) {
     ui->calculateButton->setEnabled(true);
-    ui->calculateButton->setText("开始计算");
+    ui->calculateButton->setText(running ? "取消计算" : "开始计算");
+    ui->resetButton->setEnabled(!running);
+}
+
+QColor ModelWidget01_06::curveColor(int index) const {
+    if (index < m_colorList.size()) return m_colorList[index];
+    // 预设颜色用完后按色相环取色 (黄金角间隔, 相邻曲线区分明显)
+    return QColor::fromHsv((index * 137) % 360, 220, 200);
 }
 
 void ModelWidget01_06::runCalculation() {
     m_plot->clearGraphs();
+    m_previewGraphs.clear();
 
     QMap<QString, QVector<double>> rawParams;
     rawParams["phi"] = parseInput(ui->phiEdit->text());
@@ -268,24 +312,23 @@ void ModelWidget01_06::runCalculation() {
         rawParams["S"] = {0.0};
     }
 
-    // 敏感性分析检测
-    QString sensitivityKey = "";
-    QVector<double> sensitivityValues;
-    for(auto it = rawParams.begin(); it != rawParams.end(); ++it) {
-        if(it.key() == "t") continue;
-        if(it.value().size() > 1) {
-            sensitivityKey = it.key();
-            sensitivityValues = it.value();
-            break;
+    // 敏感性分析检测: 每个多值参数为一个扫描维度, 多个维度取笛卡尔积 (按参数表顺序)
+    QVector<SweepAxis> axes;
+    for (CompositeParameters::Id id : CompositeModel::parameterSchema(m_type)) {
+        const QVector<double> values = rawParams.value(CompositeParameters::keyOf(id));
+        if (values.size() > 1) {
+            SweepAxis axis;
+            axis.id = id;
+            axis.values = values;
+            axes.append(axis);
         }
     }
-    bool isSensitivity = !sensitivityKey.isEmpty();
 
     QMap<QString, double> baseParams;
     for(auto it = rawParams.begin(); it != rawParams.end(); ++it) {
         baseParams[it.key()] = it.value().isEmpty() ? 0.0 : it.value().first();
     }
-    baseParams["N"] = m_highPrecision ? 8.0 : 4.0;
+    baseParams["N"] = m_model.highPrecision() ? 8.0 : 4.0;
     if(baseParams["L"] > 1e-9) baseParams["LfD"] = baseParams["Lf"] / baseParams["L"];
     else baseParams["LfD"] = 0;
 
@@ -296,46 +339,113 @@ void ModelWidget01_06::runCalculation() {
     if(maxTime < 1e-3) maxTime = 1000.0;
     QVector<double> t = ModelManager::generateLogTimeSteps(nPoints, -3.0, log10(maxTime));
 
-    int iterations = isSensitivity ? sensitivityValues.size() : 1;
-    iterations = qMin(iterations, (int)m_colorList.size());
+    int total = ParameterSweep::caseCount(axes);
+    if (total > 100) {
+        if (QMessageBox::question(this, "网格扫描", QString("共 %1 个工况, 计算与绘图可能较慢, 是否继续?").arg(total))
+            != QMessageBox::Yes) return;
+    }
 
-    QString resultTextHeader = QString("计算完成 (%1)\n").arg(getModelName());
-    if(isSensitivity) resultTextHeader += QString("敏感性参数: %1\n").arg(sensitivityKey);
+    m_sweepAxes = axes;
+    m_sweepCases = ParameterSweep::buildCases(CompositeParameters::fromMap(baseParams), axes);
+    m_sweepCurves = QVector<ModelCurveData>(m_sweepCases.size());
+    m_sweepBaseParams = baseParams;
+    m_sweepArrived = 0;
+    res_tD.clear(); res_pD.clear(); res_dpD.clear();
+
+    QString header = QString("计算中 (%1)...\n").arg(getModelName());
+    if (!axes.isEmpty()) header += QString("扫描工况: %1 个\n").arg(total);
+    ui->resultTextEdit->setText(header);
+
+    setCalculationRunning(true);
+    ModelEvaluationOptions sweepOptions = m_model.evaluationOptions();
+    m_sweepCancel.reset();
+    sweepOptions.cancel = &m_sweepCancel;
+    m_sweepWatcher.setFuture(ParameterSweep::run(&m_model, m_sweepCases, t, sweepOptions, QThreadPool::globalInstance()));
+    showAtlasPreview(t);
+}
 
-    for(int i = 0; i < iterations; ++i) {
-        QMap<QString, double> currentParams = baseParams;
-        double val = 0;
-        if (isSensitivity) {
-            val = sensitivityValues[i];
-            currentParams[sensitivityKey] = val;
-            if (sensitivityKey == "L" || sensitivityKey == "Lf") {
-                if(currentParams["L"] > 1e-9) currentParams["LfD"] = currentParams["Lf"] / currentParams["L"];
-            }
+void ModelWidget01_06::showAtlasPreview(const QVector<double>& t) {
+    std::shared_ptr<const TypeCurveAtlas> atlas = TypeCurveAtlas::shared(m_type);
+    if (!atlas) return;
+    bool isSensitivity = !m_sweepAxes.isEmpty();
+    for (const SweepCase& c : m_sweepCases) {
+        // 图版固定的 kf/km、Lf/L、裂缝条数与工况不一致时不预览
+        if (!atlas->covers(c.params)) continue;
+        ModelCurveData curve = atlas->curve(c.params, t);
+        QColor color = isSensitivity ? curveColor(c.index) : QColor(Qt::gray);
+        QList<QCPGraph*> graphs;
+        for (const QVector<double>* y : { &std::get<1>(curve), &std::get<2>(curve) }) {
+            QCPGraph* g = m_plot->addGraph();
+            g->setData(std::get<0>(curve), *y);
+            g->setPen(QPen(color, 1, Qt::DotLine));
+            g->removeFromLegend();
+            graphs << g;
         }
+        m_previewGraphs.insert(c.index, graphs);
+    }
+    if (!m_previewGraphs.isEmpty()) onFitToData();
+}
 
-        ModelCurveData res = calculateTheoreticalCurve(currentParams, t);
-        res_tD = std::get<0>(res);
-        res_pD = std::get<1>(res);
-        res_dpD = std::get<2>(res);
+void ModelWidget01_06::removeAtlasPreview(int caseIndex) {
+    for (QCPGraph* g : m_previewGraphs.take(caseIndex)) m_plot->removeGraph(g);
+}
 
-        QColor curveColor = isSensitivity ? m_colorList[i] : Qt::red;
-        QString legendName;
-        if (isSensitivity) legendName = QString("%1 = %2").arg(sensitivityKey).arg(val);
-        else legendName = "理论曲线";
+void ModelWidget01_06::onSweepResultReady(int resultIndex) {
+    SweepResult r = m_sweepWatcher.resultAt(resultIndex);
+    if (r.index < 0 || r.index >= m_sweepCurves.size()) return;
+    m_sweepCurves[r.index] = r.curve;
+    removeAtlasPreview(r.index);
+
+    bool isSensitivity = !m_sweepAxes.isEmpty();
+    QString legendName = isSensitivity ? ParameterSweep::caseLabel(m_sweepAxes, m_sweepCases[r.index]) : "理论曲线";
+    plotCurve(r.curve, legendName, isSensitivity ? curveColor(r.index) : Qt::red, isSensitivity);
+    if (m_sweepArrived++ == 0) onFitToData();
+    else m_plot->replot();
+}
 
-        plotCurve(res, legendName, curveColor, isSensitivity);
+void ModelWidget01_06::onSweepFinished() {
+    setCalculationRunning(false);
+    // 取消后未算完的工况不保留预览
+    for (int index : m_previewGraphs.keys()) removeAtlasPreview(index);
+    bool cancelled = m_sweepWatcher.isCanceled();
+    bool isSensitivity = !m_sweepAxes.isEmpty();
+
+    // 第一条完成的曲线作为导出 / 文本输出的当前结果
+    for (const ModelCurveData& c : m_sweepCurves) {
+        if (std::get<0>(c).isEmpty()) continue;
+        res_tD = std::get<0>(c);
+        res_pD = std::get<1>(c);
+        res_dpD = std::get<2>(c);
+        break;
     }
 
-    QString resultText = resultTextHeader;
-    resultText += "t(h)\t\tDp(MPa)\t\tdDp(MPa)\n";
-    for(int i=0; i<res_pD.size(); ++i) {
-        resultText += QString("%1\t%2\t%3\n").arg(res_tD[i],0,'e',4).arg(res_pD[i],0,'e',4).arg(res_dpD[i],0,'e',4);
+    QString resultText = QString("%1 (%2)\n").arg(cancelled ? "计算已取消" : "计算完成").arg(getModelName());
+    if (isSensitivity) {
+        // 扫描结果表: 每个工况一行, 列为各扫描参数取值与末时刻压力 / 导数
+        QStringList names;
+        for (const SweepAxis& a : m_sweepAxes) names << CompositeParameters::keyOf(a.id);
+        resultText += QString("敏感性参数: %1, 完成 %2 / %3 个工况\n").arg(names.join(" × ")).arg(m_sweepArrived).arg(m_sweepCases.size());
+        resultText += "序号\t" + names.join("\t") + "\tDp_end(MPa)\tdDp_end(MPa)\n";
+        for (int k = 0; k < m_sweepCases.size(); ++k) {
+            QString row = QString::number(k + 1);
+            for (double v : m_sweepCases[k].axisValues) row += "\t" + QString::number(v, 'g', 6);
+            const QVector<double>& p = std::get<1>(m_sweepCurves[k]);
+            const QVector<double>& d = std::get<2>(m_sweepCurves[k]);
+            if (p.isEmpty()) row += "\t(未计算)\t";
+            else row += QString("\t%1\t%2").arg(p.last(), 0, 'e', 4).arg(d.isEmpty() ? 0.0 : d.last(), 0, 'e', 4);
+            resultText += row + "\n";
+        }
+    } else {
+        resultText += "t(h)\t\tDp(MPa)\t\tdDp(MPa)\n";
+        for(int i=0; i<res_pD.size(); ++i) {
+            resultText += QString("%1\t%2\t%3\n").arg(res_tD[i],0,'e',4).arg(res_pD[i],0,'e',4).arg(res_dpD[i],0,'e',4);
+        }
     }
     ui->resultTextEdit->setText(resultText);
 
     onFitToData();
     onShowPointsToggled(ui->checkShowPoints->isChecked());
-    emit calculationCompleted(getModelName(), baseParams);
+    if (!cancelled) emit calculationCompleted(getModelName(), m_sweepBaseParams);
 }
 
 void ModelWidget01_06::plotCurve(const ModelCurveData& data, const QString& name, QColor color, bool isSensitivity) {
@@ -371,10 +481,30 @@ void ModelWidget01_06::onExportData() {
     QFile f(path);
     if (f.open(QIODevice::WriteOnly | QIODevice::Text)) {
         QTextStream out(&f);
-        out << "t,Dp,dDp\n";
-        for (int i = 0; i < res_tD.size(); ++i) {
-            double dp = (i < res_dpD.size()) ? res_dpD[i] : 0.0;
-            out << res_tD[i] << "," << res_pD[i] << "," << dp << "\n";
+        if (!m_sweepAxes.isEmpty()) {
+            // 扫描结果: 各工况共用时间列, 每个工况两列 (Dp, dDp), 表头为工况标签
+            out << "t";
+            for (const SweepCase& c : m_sweepCases) {
+                QString label = ParameterSweep::caseLabel(m_sweepAxes, c).replace(",", ";");
+                out << ",Dp[" << label << "],dDp[" << label << "]";
+            }
+            out << "\n";
+            for (int i = 0; i < res_tD.size(); ++i) {
+                out << res_tD[i];
+                for (const ModelCurveData& c : m_sweepCurves) {
+                    const QVector<double>& p = std::get<1>(c);
+                    const QVector<double>& d = std::get<2>(c);
+                    if (i < p.size()) out << "," << p[i] << "," << (i < d.size() ? d[i] : 0.0);
+                    else out << ",,";
+                }
+                out << "\n";
+            }
+        } else {
+            out << "t,Dp,dDp\n";
+            for (int i = 0; i < res_tD.size(); ++i) {
+                double dp = (i < res_dpD.size()) ? res_dpD[i] : 0.0;
+                out << res_tD[i] << "," << res_pD[i] << "," << dp << "\n";
+            }
         }
         f.close();
         QMessageBox::information(this, "导出成功", "数据文件已保存");
@@ -394,252 +524,3 @@ void ModelWidget01_06::onExportImage() {
     if (success) QMessageBox::information(this, "完成", "图表已成功导出。");
     else QMessageBox::critical(this, "错误", "导出图表失败。");
 }
-
-ModelCurveData ModelWidget01_06::calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime)
-{
-    QVector<double> tPoints = providedTime;
-    if (tPoints.isEmpty()) {
-        tPoints = ModelManager::generateLogTimeSteps(100, -3.0, 3.0);
-    }
-
-    double phi = params.value("phi", 0.05);
-    double mu = params.value("mu", 0.5);
-    double B = params.value("B", 1.05);
-    double Ct = params.value("Ct", 5e-4);
-    double q = params.value("q", 5.0);
-    double h = params.value("h", 20.0);
-    double kf = params.value("kf", 1e-3);
-    double L = params.value("L", 1000.0);
-
-    QVector<double> tD_vec;
-    tD_vec.reserve(tPoints.size());
-    for(double t : tPoints) {
-        double val = 14.4 * kf * t / (phi * mu * Ct * pow(L, 2));
-        tD_vec.append(val);
-    }
-
-    QVector<double> PD_vec, Deriv_vec;
-    auto func = std::bind(&ModelWidget01_06::flaplace_composite, this, std::placeholders::_1, std::placeholders::_2);
-    calculatePDandDeriv(tD_vec, params, func, PD_vec, Deriv_vec);
-
-    double factor = 1.842e-3 * q * mu * B / (kf * h);
-    QVector<double> finalP(tPoints.size()), finalDP(tPoints.size());
-
-    for(int i=0; i<tPoints.size(); ++i) {
-        finalP[i] = factor * PD_vec[i];
-        finalDP[i] = factor * Deriv_vec[i];
-    }
-
-    return std::make_tuple(tPoints, finalP, finalDP);
-}
-
-void ModelWidget01_06::calculatePDandDeriv(const QVector<double>& tD, const QMap<QString, double>& params,
-                                           std::function<double(double, const QMap<QString, double>&)> laplaceFunc,
-                                           QVector<double>& outPD, QVector<double>& outDeriv)
-{
-    int numPoints = tD.size();
-    outPD.resize(numPoints);
-    outDeriv.resize(numPoints);
-
-    int N_param = (int)params.value("N", 4);
-    int N = m_highPrecision ? N_param : 4;
-    if (N % 2 != 0) N = 4;
-    double ln2 = log(2.0);
-
-    // 获取压敏系数 (MATLAB: gamaD)
-    double gamaD = params.value("gamaD", 0.0);
-
-    for (int k = 0; k < numPoints; ++k) {
-        double t = tD[k];
-        if (t <= 1e-12) { outPD[k] = 0; continue; }
-        double pd_val = 0.0;
-        for (int m = 1; m <= N; ++m) {
-            double z = m * ln2 / t;
-            double pf = laplaceFunc(z, params);
-            if (std::isnan(pf) || std::isinf(pf)) pf = 0.0;
-            pd_val += stefestCoefficient(m, N) * pf;
-        }
-        outPD[k] = pd_val * ln2 / t;
-
-        // 摄动法考虑压敏效应 (对应 MATLAB: -1/gamaD * log(1-gamaD*PD))
-        if (std::abs(gamaD) > 1e-9) {
-            double arg = 1.0 - gamaD * outPD[k];
-            if (arg > 1e-12) {
-                outPD[k] = -1.0 / gamaD * std::log(arg);
-            }
-        }
-    }
-    if (numPoints > 2) outDeriv = PressureDerivativeCalculator::calculateBourdetDerivative(tD, outPD, 0.1);
-    else outDeriv.fill(0.0);
-}
-
-double ModelWidget01_06::flaplace_composite(double z, const QMap<QString, double>& p) {
-    double kf = p.value("kf");
-    double km = p.value("km");
-    double LfD = p.value("LfD");
-    double rmD = p.value("rmD");
-    double reD = p.value("reD", 0.0); // 默认0表示无限大(如果未设置)
-    double omga1 = p.value("omega1");
-    double omga2 = p.value("omega2");
-    double remda1 = p.value("lambda1");
-    int nf = (int)p.value("nf", 4); if(nf < 1) nf = 1;
-    double M12 = kf / km;
-    QVector<double> xwD;
-    if (nf == 1) { xwD.append(0.0); } else {
-        double start = -0.9; double end = 0.9; double step = (end - start) / (nf - 1);
-        for(int i=0; i<nf; ++i) xwD.append(start + i * step);
-    }
-    double temp = omga2;
-    double fs1 = omga1 + remda1 * temp / (remda1 + z * temp);
-    double fs2 = M12 * temp;
-
-    // 调用通用 PWD 计算内核，内部包含边界判断逻辑
-    double pf = PWD_composite(z, fs1, fs2, M12, LfD, rmD, reD, nf, xwD, m_type);
-
-    // 考虑井筒储存和表皮 (对应 MATLAB: (z*pf+S)/(z+CD*z^2*(z*pf+S)))
-    // 仅对变井储模型 (1, 3, 5) 启用
-    bool hasStorage = (m_type == Model_1 || m_type == Model_3 || m_type == Model_5);
-    if (hasStorage) {
-        double CD = p.value("cD", 0.0);
-        double S = p.value("S", 0.0);
-        if (CD > 1e-12 || std::abs(S) > 1e-12) {
-            pf = (z * pf + S) / (z + CD * z * z * (z * pf + S));
-        }
-    }
-
-    return pf;
-}
-
-double ModelWidget01_06::PWD_composite(double z, double fs1, double fs2, double M12, double LfD, double rmD, double reD, int nf, const QVector<double>& xwD, ModelType type) {
-    using namespace boost::math;
-    QVector<double> ywD(nf, 0.0);
-    double gama1 = sqrt(z * fs1);
-    double gama2 = sqrt(z * fs2);
-    double arg_g2_rm = gama2 * rmD;
-    double arg_g1_rm = gama1 * rmD;
-
-    // 使用缩放贝塞尔函数以避免数值溢出
-    double k0_g2 = cyl_bessel_k(0, arg_g2_rm);
-    double k1_g2 = cyl_bessel_k(1, arg_g2_rm);
-    double k0_g1 = cyl_bessel_k(0, arg_g1_rm);
-    double k1_g1 = cyl_bessel_k(1, arg_g1_rm);
-
-    // --- 边界条件因子计算 mAB ---
-    // MATLAB 对应关系:
-    // Infinite: mAB = 0
-    // Closed:   mAB = K1(re)/I1(re)
-    // ConstP:   mAB = -K0(re)/I0(re)
-
-    double term_mAB_i0 = 0.0;
-    double term_mAB_i1 = 0.0;
-
-    bool isInfinite = (type == Model_1 || type == Model_2);
-    bool isClosed = (type == Model_3 || type == Model_4);
-    bool isConstP = (type == Model_5 || type == Model_6);
-
-    if (!isInfinite) {
-        double arg_re = gama2 * reD;
-        double i1_re_s = scaled_besseli(1, arg_re);
-        double i0_re_s = scaled_besseli(0, arg_re);
-        double k1_re = cyl_bessel_k(1, arg_re);
-        double k0_re = cyl_bessel_k(0, arg_re);
-        double i0_g2_s = scaled_besseli(0, arg_g2_rm);
-        double i1_g2_s = scaled_besseli(1, arg_g2_rm);
-
-        if (isClosed) {
-            // 封闭边界: ratio based on K1/I1
-            if (i1_re_s > 1e-100) {
-                // 计算 mAB * I0(g2*rmD) 和 mAB * I1(g2*rmD)
-                // 引入 exp(arg_g2_rm - arg_re) 来处理指数项的缩放
-                term_mAB_i0 = (k1_re / i1_re_s) * i0_g2_s * std::exp(arg_g2_rm - arg_re);
-                term_mAB_i1 = (k1_re / i1_re_s) * i1_g2_s * std::exp(arg_g2_rm - arg_re);
-            }
-        } else if (isConstP) {
-            // 定压边界: ratio based on -K0/I0
-            if (i0_re_s > 1e-100) {
-                term_mAB_i0 = -(k0_re / i0_re_s) * i0_g2_s * std::exp(arg_g2_rm - arg_re);
-                term_mAB_i1 = -(k0_re / i0_re_s) * i1_g2_s * std::exp(arg_g2_rm - arg_re);
-            }
-        }
-    }
-
-    // MATLAB: Acup = M12*gama1*K1(g1)*(mAB*I0(g2)+K0(g2)) + gama2*K0(g1)*(mAB*I1(g2)-K1(g2))
-    double term1 = term_mAB_i0 + k0_g2; // (mAB*I0 + K0)
-    double term2 = term_mAB_i1 - k1_g2; // (mAB*I1 - K1)
-
-    double Acup = M12 * gama1 * k1_g1 * term1 + gama2 * k0_g1 * term2;
-
-    double i1_g1_s = scaled_besseli(1, arg_g1_rm);
-    double i0_g1_s = scaled_besseli(0, arg_g1_rm);
-
-    // MATLAB: Acdown = M12*gama1*I1(g1)*(...) - gama2*I0(g1)*(...)
-    // 我们这里计算 scaled 版本 Acdown * exp(-arg_g1_rm)
-    double Acdown_scaled = M12 * gama1 * i1_g1_s * term1 - gama2 * i0_g1_s * term2;
-
-    if (std::abs(Acdown_scaled) < 1e-100) Acdown_scaled = 1e-100;
-
-    // Ac = Acup / Acdown
-    // Ac_prefactor = Acup / Acdown_scaled = Ac * exp(arg_g1_rm)
-    double Ac_prefactor = Acup / Acdown_scaled;
-
-    // 求解线性方程组
-    int size = nf + 1;
-    Eigen::MatrixXd A_mat(size, size);
-    Eigen::VectorXd b_vec(size);
-    b_vec.setZero(); b_vec(nf) = 1.0;
-
-    for (int i = 0; i < nf; ++i) {
-        for (int j = 0; j < nf; ++j) {
-            // 积分核函数: K0 + Ac*I0
-            auto integrand = [&](double a) -> double {
-                double dist = std::sqrt(std::pow(xwD[i] - xwD[j] - a, 2) + std::pow(ywD[i] - ywD[j], 2));
-                double arg_dist = gama1 * dist; if (arg_dist < 1e-10) arg_dist = 1e-10;
-
-                // 计算 Ac * I0(g1*dist)
-                // = (Ac_prefactor * exp(-arg_g1_rm)) * (scaled_I0 * exp(arg_dist))
-                // = Ac_prefactor * scaled_I0 * exp(arg_dist - arg_g1_rm)
-                double term2 = 0.0;
-                double exponent = arg_dist - arg_g1_rm;
-                if (exponent > -700.0) {
-                    term2 = Ac_prefactor * scaled_besseli(0, arg_dist) * std::exp(exponent);
-                }
-                return cyl_bessel_k(0, arg_dist) + term2;
-            };
-            double val = adaptiveGauss(integrand, -LfD, LfD, 1e-5, 0, 10);
-            A_mat(i, j) = z * val / (M12 * z * 2 * LfD);
-        }
-    }
-    // 流量条件
-    for (int i = 0; i < nf; ++i) { A_mat(i, nf) = -1.0; A_mat(nf, i) = z; }
-    A_mat(nf, nf) = 0.0;
-
-    return A_mat.fullPivLu().solve(b_vec)(nf);
-}
-
-double ModelWidget01_06::scaled_besseli(int v, double x) {
-    if (x < 0) x = -x;
-    if (x > 600.0) return 1.0 / std::sqrt(2.0 * M_PI * x);
-    return boost::math::cyl_bessel_i(v, x) * std::exp(-x);
-}
-double ModelWidget01_06::gauss15(std::function<double(double)> f, double a, double b) {
-    static const double X[] = { 0.0, 0.201194, 0.394151, 0.570972, 0.724418, 0.848207, 0.937299, 0.987993 };
-    static const double W[] = { 0.202578, 0.198431, 0.186161, 0.166269, 0.139571, 0.107159, 0.070366, 0.030753 };
-    double h = 0.5 * (b - a); double c = 0.5 * (a + b); double s = W[0] * f(c);
-    for (int i = 1; i < 8; ++i) { double dx = h * X[i]; s += W[i] * (f(c - dx) + f(c + dx)); }
-    return s * h;
-}
-double ModelWidget01_06::adaptiveGauss(std::function<double(double)> f, double a, double b, double eps, int depth, int maxDepth) {
-    double c = (a + b) / 2.0; double v1 = gauss15(f, a, b); double v2 = gauss15(f, a, c) + gauss15(f, c, b);
-    if (depth >= maxDepth || std::abs(v1 - v2) < 1e-10 * std::abs(v2) + eps) return v2;
-    return adaptiveGauss(f, a, c, eps/2, depth+1, maxDepth) + adaptiveGauss(f, c, b, eps/2, depth+1, maxDepth);
-}
-double ModelWidget01_06::stefestCoefficient(int i, int N) {
-    double s = 0.0; int k1 = (i + 1) / 2; int k2 = std::min(i, N / 2);
-    for (int k = k1; k <= k2; ++k) {
-        double num = pow(k, N / 2.0) * factorial(2 * k);
-        double den = factorial(N / 2 - k) * factorial(k) * factorial(k - 1) * factorial(i - k) * factorial(2 * k - i);
-        if(den!=0) s += num/den;
-    }
-    return ((i + N / 2) % 2 == 0 ? 1.0 : -1.0) * s;
-}
-double ModelWidget01_06::factorial(int n) { if(n<=1)return 1; double r=1; for(int i=2;i<=n;++i)r*=i; return r; }
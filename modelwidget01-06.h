@@ -4,11 +4,14 @@
 #include <QWidget>
 #include <QMap>
 #include <QVector>
+#include <QStringList>
 #include <QColor>
-#include <tuple>
-#include <functional>
+#include <QFutureWatcher>
 #include "mousezoom.h"
 #include "chartsetting1.h"
+#include "compositemodel.h"
+#include "parametersweep.h"
+#include "typecurveatlas.h"
 
 namespace Ui {
 class ModelWidget01_06;
@@ -16,22 +19,19 @@ class ModelWidget01_06;
 
 class QCPTextElement;
 
-// 类型定义: <时间, 压力, 导数>
-using ModelCurveData = std::tuple<QVector<double>, QVector<double>, QVector<double>>;
-
 class ModelWidget01_06 : public QWidget
 {
     Q_OBJECT
 
 public:
-    enum ModelType {
-        Model_1 = 0, // 无限大 + 变井储
-        Model_2,     // 无限大 + 恒定井储
-        Model_3,     // 封闭边界 + 变井储
-        Model_4,     // 封闭边界 + 恒定井储
-        Model_5,     // 定压边界 + 变井储
-        Model_6      // 定压边界 + 恒定井储
-    };
+    // 使用 CompositeModel 中定义的枚举
+    using ModelType = CompositeModel::ModelType;
+    static const ModelType Model_1 = CompositeModel::Model_1; // 无限大 + 变井储
+    static const ModelType Model_2 = CompositeModel::Model_2; // 无限大 + 恒定井储
+    static const ModelType Model_3 = CompositeModel::Model_3; // 封闭边界 + 变井储
+    static const ModelType Model_4 = CompositeModel::Model_4; // 封闭边界 + 恒定井储
+    static const ModelType Model_5 = CompositeModel::Model_5; // 定压边界 + 变井储
+    static const ModelType Model_6 = CompositeModel::Model_6; // 定压边界 + 恒定井储
 
     explicit ModelWidget01_06(ModelType type, QWidget *parent = nullptr);
     ~ModelWidget01_06();
@@ -39,9 +39,33 @@ public:
     // 设置是否使用高精度 Stehfest 反演 (对应 MATLAB 中的 N=8)
     void setHighPrecision(bool high);
 
+    // 选择拉普拉斯数值反演算法 (order <= 0 时取该算法默认阶数)
+    // Stehfest 阶数仍由参数 N 决定; 低精度模式 (拟合迭代) 下复平面方法阶数减半
+    void setInversionMethod(LaplaceInversionMethod method, int order = 0);
+    LaplaceInversionMethod inversionMethod() const;
+
+    // 设置是否按时间点并行执行 Stehfest 反演 (结果与串行逐位一致)
+    void setParallelEvaluation(bool enabled);
+
+    // 拉普拉斯空间求值缓存控制与命中统计
+    void setEvaluationCacheEnabled(bool enabled);
+    void clearEvaluationCache();
+    LaplaceCacheStats cacheStatistics() const;
+    void resetCacheStatistics();
+
+    // 积分核函数累计求值次数 (随 resetCacheStatistics 清零)
+    quint64 quadratureEvaluations() const;
+
+    // 线程安全的计算对象 (可在工作线程中直接调用, 不经过界面)
+    const CompositeModel* model() const;
+
     // 计算理论曲线 (供 FittingWidget 调用)
     ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
 
+    // 计算理论曲线并同时求出对 paramNames 中各参数的偏导数 (一次求值, 仅支持 Stehfest 反演)
+    ModelSensitivityData calculateTheoreticalCurveSensitivity(const QMap<QString, double>& params, const QStringList& paramNames,
+                                                              const QVector<double>& providedTime = QVector<double>());
+
     // 获取当前模型名称
     QString getModelName() const;
 
@@ -60,6 +84,11 @@ public slots:
     void onDependentParamsChanged();
     void onShowPointsToggled(bool checked);
 
+private slots:
+    // 扫描工况逐条到达时绘图, 全部结束 (或取消) 后输出结果表
+    void onSweepResultReady(int resultIndex);
+    void onSweepFinished();
+
 private:
     void initUi();
     void initChart();
@@ -70,33 +99,33 @@ private:
     QVector<double> parseInput(const QString& text);
     void setInputText(QLineEdit* edit, double value);
     void plotCurve(const ModelCurveData& data, const QString& name, QColor color, bool isSensitivity);
-
-    // 数学计算核心 (Stehfest 反演循环)
-    void calculatePDandDeriv(const QVector<double>& tD, const QMap<QString, double>& params,
-                             std::function<double(double, const QMap<QString, double>&)> laplaceFunc,
-                             QVector<double>& outPD, QVector<double>& outDeriv);
-
-    // 拉普拉斯空间解 (复合模型通用入口)
-    double flaplace_composite(double z, const QMap<QString, double>& p);
-
-    // PWD 核心计算 (包含边界条件处理 Logic from MATLAB PWD_inf)
-    double PWD_composite(double z, double fs1, double fs2, double M12, double LfD, double rmD, double reD, int nf, const QVector<double>& xwD, ModelType type);
-
-    // 数学工具函数 (对应 MATLAB 内置函数或逻辑)
-    double scaled_besseli(int v, double x); // 缩放 Bessel I
-    double gauss15(std::function<double(double)> f, double a, double b);
-    double adaptiveGauss(std::function<double(double)> f, double a, double b, double eps, int depth, int maxDepth);
-    double stefestCoefficient(int i, int N);
-    double factorial(int n);
+    QColor curveColor(int index) const;
+    void setCalculationRunning(bool running);
+    // 图版即时预览: 精确曲线到达前先画出图版插值曲线 (细点线), 到达后逐条替换
+    void showAtlasPreview(const QVector<double>& t);
+    void removeAtlasPreview(int caseIndex);
 
 private:
     Ui::ModelWidget01_06 *ui;
     MouseZoom* m_plot;
     QCPTextElement* m_plotTitle;
     ModelType m_type;
-    bool m_highPrecision;
+
+    // 计算对象 (求值选项、缓存与统计均在其中)
+    CompositeModel m_model;
     QList<QColor> m_colorList;
 
+    // 后台扫描: 每个工况一个线程池任务, 结果按到达顺序绘制
+    QFutureWatcher<SweepResult> m_sweepWatcher;
+    // 取消时正在计算的工况也在下一个时间点停止 (而不是等整条曲线算完)
+    CancellationToken m_sweepCancel;
+    QVector<SweepAxis> m_sweepAxes;
+    QVector<SweepCase> m_sweepCases;
+    QVector<ModelCurveData> m_sweepCurves;  // 按工况序号, 未完成的为空
+    QMap<QString, double> m_sweepBaseParams;
+    int m_sweepArrived;
+    QMap<int, QList<QCPGraph*>> m_previewGraphs;  // 按工况序号
+
     // 缓存结果
     QVector<double> res_tD;
     QVector<double> res_pD;
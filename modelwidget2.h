@@ -60,10 +60,6 @@ private:
     double flaplace_composite(double z, const QMap<QString, double>& p);
     double PWD_inf(double z, double fs1, double fs2, double M12, double LfD, double rmD, int nf, const QVector<double>& xwD);
     double scaled_besseli(int v, double x);
-    double adaptiveGauss(std::function<double(double)> f, double a, double b, double eps, int depth, int maxDepth);
-    double gauss15(std::function<double(double)> f, double a, double b);
-    double stefestCoefficient(int i, int N);
-    double factorial(int n);
 
 private:
     Ui::ModelWidget2 *ui;
@@ -1,4 +1,6 @@
 #include "modelwidget3.h"
+#include "gausskronrod.h"
+#include "stehfest.h"
 #include "ui_modelwidget3.h"
 #include "modelmanager.h"
 #include "pressurederivativecalculator.h"
@@ -388,7 +390,7 @@ void ModelWidget3::calculatePDandDeriv(const QVector<double>& tD, const QMap<QSt
 
     int N_param = (int)params.value("N", 4);
     int N = m_highPrecision ? N_param : 4;
-    if (N % 2 != 0) N = 4;
+    N = Stehfest::normalizeN(N);
     double ln2 = log(2.0);
 
     double gamaD = params.value("gamaD", 0.0);
@@ -401,7 +403,7 @@ void ModelWidget3::calculatePDandDeriv(const QVector<double>& tD, const QMap<QSt
             double z = m * ln2 / t;
             double pf = laplaceFunc(z, params);
             if (std::isnan(pf) || std::isinf(pf)) pf = 0.0;
-            pd_val += stefestCoefficient(m, N) * pf;
+            pd_val += Stehfest::coefficients(N)[m] * pf;
         }
         outPD[k] = pd_val * ln2 / t;
 
@@ -529,7 +531,7 @@ double ModelWidget3::PWD_inf(double z, double fs1, double fs2, double M12, doubl
                 }
                 return cyl_bessel_k(0, arg_dist) + term2;
             };
-            double val = adaptiveGauss(integrand, -LfD, LfD, 1e-5, 0, 10);
+            double val = GaussKronrod::integrate(integrand, -LfD, LfD, 1e-5, 1e-10, 10);
             A_mat(i, j) = z * val / (M12 * z * 2 * LfD);
         }
     }
@@ -542,25 +544,3 @@ double ModelWidget3::scaled_besseli(int v, double x) {
     if (x > 600.0) return 1.0 / std::sqrt(2.0 * M_PI * x);
     return boost::math::cyl_bessel_i(v, x) * std::exp(-x);
 }
-double ModelWidget3::gauss15(std::function<double(double)> f, double a, double b) {
-    static const double X[] = { 0.0, 0.201194, 0.394151, 0.570972, 0.724418, 0.848207, 0.937299, 0.987993 };
-    static const double W[] = { 0.202578, 0.198431, 0.186161, 0.166269, 0.139571, 0.107159, 0.070366, 0.030753 };
-    double h = 0.5 * (b - a); double c = 0.5 * (a + b); double s = W[0] * f(c);
-    for (int i = 1; i < 8; ++i) { double dx = h * X[i]; s += W[i] * (f(c - dx) + f(c + dx)); }
-    return s * h;
-}
-double ModelWidget3::adaptiveGauss(std::function<double(double)> f, double a, double b, double eps, int depth, int maxDepth) {
-    double c = (a + b) / 2.0; double v1 = gauss15(f, a, b); double v2 = gauss15(f, a, c) + gauss15(f, c, b);
-    if (depth >= maxDepth || std::abs(v1 - v2) < 1e-10 * std::abs(v2) + eps) return v2;
-    return adaptiveGauss(f, a, c, eps/2, depth+1, maxDepth) + adaptiveGauss(f, c, b, eps/2, depth+1, maxDepth);
-}
-double ModelWidget3::stefestCoefficient(int i, int N) {
-    double s = 0.0; int k1 = (i + 1) / 2; int k2 = std::min(i, N / 2);
-    for (int k = k1; k <= k2; ++k) {
-        double num = pow(k, N / 2.0) * factorial(2 * k);
-        double den = factorial(N / 2 - k) * factorial(k) * factorial(k - 1) * factorial(i - k) * factorial(2 * k - i);
-        if(den!=0) s += num/den;
-    }
-    return ((i + N / 2) % 2 == 0 ? 1.0 : -1.0) * s;
-}
-double ModelWidget3::factorial(int n) { if(n<=1)return 1; double r=1; for(int i=2;i<=n;++i)r*=i; return r; }
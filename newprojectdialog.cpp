@@ -8,6 +8,7 @@
 #include <QDate>
 #include <QStandardPaths>
 #include <QStyle>
+#include "datasetcache.h"
 
 NewProjectDialog::NewProjectDialog(QWidget *parent) :
     QDialog(parent),
@@ -348,6 +349,8 @@ bool NewProjectDialog::createProjectStructure()
             return false;
         }
     }
+    // 数据文件解析结果的二进制缓存目录 (DataSetCache)
+    QDir().mkpath(DataSetCache::cacheDirectory(projectDirPath));
 
     m_projectData.projectName = ui->editProjectName->text().trimmed();
     m_projectData.oilFieldName = ui->editOilField->text().trimmed();
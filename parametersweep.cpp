@@ -0,0 +1,72 @@
+#include "parametersweep.h"
+
+#include <QThreadPool>
+#include <QtConcurrent>
+
+namespace ParameterSweep {
+
+int caseCount(const QVector<SweepAxis>& axes)
+{
+    if (axes.isEmpty()) return 1;
+    int n = 1;
+    for (const SweepAxis& a : axes) n *= std::max(1, (int)a.values.size());
+    return n;
+}
+
+QVector<SweepCase> buildCases(const CompositeParameters& base, const QVector<SweepAxis>& axes)
+{
+    int total = caseCount(axes);
+    QVector<SweepCase> cases;
+    cases.reserve(total);
+    bool syncLfD = false;
+    for (const SweepAxis& a : axes) {
+        if (a.id == CompositeParameters::L || a.id == CompositeParameters::Lf) syncLfD = true;
+    }
+
+    for (int k = 0; k < total; ++k) {
+        SweepCase c;
+        c.index = k;
+        c.params = base;
+        c.axisValues.resize(axes.size());
+        // 混合进制分解: 最后一个维度变化最快
+        int rem = k;
+        for (int a = axes.size() - 1; a >= 0; --a) {
+            int n = std::max(1, (int)axes[a].values.size());
+            double v = axes[a].values.isEmpty() ? base[axes[a].id] : axes[a].values[rem % n];
+            rem /= n;
+            c.axisValues[a] = v;
+            c.params[axes[a].id] = v;
+        }
+        if (syncLfD) c.params.syncDerived();
+        cases.append(c);
+    }
+    return cases;
+}
+
+QString caseLabel(const QVector<SweepAxis>& axes, const SweepCase& c)
+{
+    QStringList parts;
+    for (int a = 0; a < axes.size() && a < c.axisValues.size(); ++a)
+        parts << QString("%1=%2").arg(CompositeParameters::keyOf(axes[a].id)).arg(c.axisValues[a]);
+    return parts.join(", ");
+}
+
+QFuture<SweepResult> run(const CompositeModel* model, const QVector<SweepCase>& cases, const QVector<double>& time,
+                         const ModelEvaluationOptions& options, QThreadPool* pool)
+{
+    if (!pool) pool = QThreadPool::globalInstance();
+    // 工况数不足以占满线程池时, 保留工况内部按时间点并行, 否则单条曲线只用到一个线程
+    ModelEvaluationOptions caseOptions = options;
+    if (cases.size() >= pool->maxThreadCount()) caseOptions.parallel = false;
+    std::function<SweepResult(const SweepCase&)> evaluate = [model, time, caseOptions](const SweepCase& c) {
+        SweepResult r;
+        r.index = c.index;
+        r.curve = model->calculateTheoreticalCurve(c.params, time, caseOptions);
+        // 计算中途取消的曲线不完整 (未算的时间点为 NaN), 不作为结果
+        if (caseOptions.cancelled()) r.index = -1;
+        return r;
+    };
+    return QtConcurrent::mapped(pool, cases, evaluate);
+}
+
+} // namespace ParameterSweep
@@ -0,0 +1,56 @@
+#ifndef PARAMETERSWEEP_H
+#define PARAMETERSWEEP_H
+
+#include <QVector>
+#include <QString>
+#include <QFuture>
+#include "compositemodel.h"
+#include "compositeparameters.h"
+
+class QThreadPool;
+
+// 一个扫描维度: 参数及其取值
+struct SweepAxis {
+    CompositeParameters::Id id = CompositeParameters::Invalid;
+    QVector<double> values;
+};
+
+// 一个扫描工况: 参数组与各维度的取值 (与 axes 顺序一致)
+struct SweepCase {
+    int index = 0;
+    CompositeParameters params;
+    QVector<double> axisValues;
+};
+
+struct SweepResult {
+    int index = -1;
+    ModelCurveData curve;
+};
+
+/**
+ * @brief 参数敏感性 / 网格扫描
+ *
+ * 多个多值参数取笛卡尔积 (第一个维度变化最慢), 每个工况作为独立任务提交到线程池,
+ * 返回的 QFuture 可交给 QFutureWatcher: resultReadyAt 逐条取结果, cancel() 取消尚未开始的工况;
+ * options.cancel 另可中止正在计算的工况, 中途取消的工况结果 index 为 -1。
+ * 工况之间并行; 工况数填满线程池时工况内部按时间点串行 (避免线程池嵌套),
+ * 工况数少于线程数时 (包括单条曲线) 保留调用方的按时间点并行选项。
+ */
+namespace ParameterSweep {
+
+// 笛卡尔积展开; 扫描 L 或 Lf 时同步 LfD
+QVector<SweepCase> buildCases(const CompositeParameters& base, const QVector<SweepAxis>& axes);
+
+// 工况数 (各维度取值数之积)
+int caseCount(const QVector<SweepAxis>& axes);
+
+// 图例 / 表格使用的工况标签, 如 "kf=0.001, S=2"
+QString caseLabel(const QVector<SweepAxis>& axes, const SweepCase& c);
+
+// 异步计算全部工况 (model 须在 future 结束前保持有效)
+QFuture<SweepResult> run(const CompositeModel* model, const QVector<SweepCase>& cases, const QVector<double>& time,
+                         const ModelEvaluationOptions& options, QThreadPool* pool);
+
+} // namespace ParameterSweep
+
+#endif // PARAMETERSWEEP_H
@@ -1,5 +1,6 @@
 #include "plottingwidget.h"
 #include "ui_plottingwidget.h"
+#include "datatablemodel.h"
 #include <QPaintEvent>
 #include <QPainter>
 #include <QApplication>
@@ -1467,7 +1468,7 @@ void PlottingWidget::setTableData(const TableData &data)
     ui->label_dataInfo->setText(dataInfo);
 }
 
-void PlottingWidget::setTableDataFromModel(QStandardItemModel* model, const QString &fileName)
+void PlottingWidget::setTableDataFromModel(DataTableModel* model, const QString &fileName)
 {
     if (!model) {
         return;
@@ -1485,21 +1486,12 @@ void PlottingWidget::setTableDataFromModel(QStandardItemModel* model, const QStr
         data.headers.append(header);
     }
 
+    // 直接复制列存储的数值, 空白或非数值单元格为 0
     data.columns.resize(model->columnCount());
     for (int col = 0; col < model->columnCount(); ++col) {
-        for (int row = 0; row < model->rowCount(); ++row) {
-            QStandardItem* item = model->item(row, col);
-            if (item) {
-                bool ok;
-                double value = item->text().toDouble(&ok);
-                if (ok) {
-                    data.columns[col].append(value);
-                } else {
-                    data.columns[col].append(0.0);
-                }
-            } else {
-                data.columns[col].append(0.0);
-            }
+        data.columns[col] = model->columnValues(col);
+        for (double& value : data.columns[col]) {
+            if (std::isnan(value)) value = 0.0;
         }
     }
 
@@ -29,7 +29,6 @@
 #include <QScrollArea>
 #include <QSlider>
 #include <QProgressBar>
-#include <QStandardItemModel>
 #include <QMessageBox>
 #include <QLineEdit>
 #include <QListWidget>
@@ -46,6 +45,8 @@ namespace Ui {
 class PlottingWidget;
 }
 
+class DataTableModel;
+
 // 线型枚举
 enum class LineStyle {
     Solid,      // 实线
@@ -349,7 +350,7 @@ public:
 
     // 设置表格数据
     void setTableData(const TableData &data);
-    void setTableDataFromModel(QStandardItemModel* model, const QString &fileName = "");
+    void setTableDataFromModel(DataTableModel* model, const QString &fileName = "");
 
     // 多曲线管理
     void addCurve(const CurveData &curve);
@@ -0,0 +1,76 @@
+#ifndef STEHFEST_H
+#define STEHFEST_H
+
+#include <array>
+
+/**
+ * @brief Stehfest 反演系数表 (编译期计算)
+ *
+ * V_i = (-1)^(i+N/2) * sum_{k=floor((i+1)/2)}^{min(i,N/2)}
+ *        k^(N/2) (2k)! / [ (N/2-k)! k! (k-1)! (i-k)! (2k-i)! ]
+ *
+ * 所有偶数 N (2..MaxN) 的系数在编译期以 long double 计算后取整为 double,
+ * 由全部模型共享, 反演内层循环只做查表。N=20 时 |V_i| 已达 1e9 量级, 交替求和的
+ * 相消误差随 N 指数增长, 双精度的 F(s) 无法再支撑更高的 N, 因此 N 被限制在 MaxN 以内,
+ * 求和应使用 long double 累加。
+ */
+namespace Stehfest {
+
+constexpr int MaxN = 20;
+
+using Table = std::array<std::array<double, MaxN + 1>, MaxN / 2 + 1>;
+
+constexpr long double factorial(int n)
+{
+    long double r = 1.0L;
+    for (int i = 2; i <= n; ++i) r *= i;
+    return r;
+}
+
+constexpr long double ipow(int base, int e)
+{
+    long double r = 1.0L;
+    for (int i = 0; i < e; ++i) r *= base;
+    return r;
+}
+
+// table[N/2][i] = V_i (i = 1..N), table[N/2][0] 未使用
+constexpr Table buildTable()
+{
+    Table t{};
+    for (int half = 1; half <= MaxN / 2; ++half) {
+        int N = 2 * half;
+        for (int i = 1; i <= N; ++i) {
+            long double s = 0.0L;
+            int k1 = (i + 1) / 2;
+            int k2 = (i < half) ? i : half;
+            for (int k = k1; k <= k2; ++k) {
+                long double num = ipow(k, half) * factorial(2 * k);
+                long double den = factorial(half - k) * factorial(k) * factorial(k - 1)
+                                  * factorial(i - k) * factorial(2 * k - i);
+                s += num / den;
+            }
+            t[half][i] = static_cast<double>(((i + half) % 2 == 0) ? s : -s);
+        }
+    }
+    return t;
+}
+
+inline constexpr Table kTable = buildTable();
+
+// 规范化反演阶数: 奇数或过小时取 4, 超过 MaxN 时取 MaxN
+constexpr int normalizeN(int N)
+{
+    if (N < 2 || N % 2 != 0) return 4;
+    return (N > MaxN) ? MaxN : N;
+}
+
+// 返回 N 阶系数数组, 下标 1..N 有效
+inline const double* coefficients(int N)
+{
+    return kTable[normalizeN(N) / 2].data();
+}
+
+} // namespace Stehfest
+
+#endif // STEHFEST_H
@@ -0,0 +1,140 @@
+#include "tst_besselkernel.h"
+#include "besselkernel.h"
+
+#include <QtTest>
+#include <boost/math/special_functions/bessel.hpp>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const double kTolerance = 1e-12;
+const double kBoostLimit = 700.0;   // 更大的 x 上 cyl_bessel_i 溢出
+
+enum Function { K0, K1, I0e, I1e };
+const char* const kNames[] = { "K0", "K1", "I0e", "I1e" };
+
+using Scalar = double (*)(double);
+using Batch = void (*)(const double*, int, double*);
+const Scalar kScalar[] = { BesselKernel::k0, BesselKernel::k1, BesselKernel::i0e, BesselKernel::i1e };
+const Batch kBatch[] = { BesselKernel::k0, BesselKernel::k1, BesselKernel::i0e, BesselKernel::i1e };
+
+double reference(Function f, double x)
+{
+    switch (f) {
+    case K0: return boost::math::cyl_bessel_k(0, x);
+    case K1: return boost::math::cyl_bessel_k(1, x);
+    case I0e: return boost::math::cyl_bessel_i(0, x) * std::exp(-x);
+    default: return boost::math::cyl_bessel_i(1, x) * std::exp(-x);
+    }
+}
+
+// exp(-x)*I_v(x) ~ 1/sqrt(2*pi*x) * sum (-1)^k a_k(v) / x^k, a_k = prod_{j<=k} (4v^2 - (2j-1)^2) / (k! 8^k)
+double asymptoticScaledI(int v, double x)
+{
+    const double mu = 4.0 * v * v;
+    double term = 1.0, sum = 1.0;
+    for (int k = 1; k < 30; ++k) {
+        term *= -(mu - (2.0 * k - 1.0) * (2.0 * k - 1.0)) / (k * 8.0 * x);
+        sum += term;
+        if (std::abs(term) < 1e-18 * std::abs(sum)) break;
+    }
+    return sum / std::sqrt(2.0 * M_PI * x);
+}
+
+// [1e-8, 700] 上对数等距的宗量, 覆盖各展开段及其分界点 (2, 8) 附近
+std::vector<double> arguments()
+{
+    std::vector<double> x;
+    for (double e = -8.0; e <= std::log10(kBoostLimit); e += 1e-3) x.push_back(std::pow(10.0, e));
+    for (double split : { 2.0, 8.0 }) {
+        x.push_back(std::nextafter(split, 0.0));
+        x.push_back(split);
+        x.push_back(std::nextafter(split, 1e300));
+    }
+    x.push_back(kBoostLimit);
+    return x;
+}
+
+double relativeError(double value, double expected)
+{
+    return std::abs(value - expected) / std::abs(expected);
+}
+
+} // namespace
+
+void TestBesselKernel::scalarMatchesBoost()
+{
+    const std::vector<double> x = arguments();
+    for (int f = K0; f <= I1e; ++f) {
+        double worst = 0.0, worstX = 0.0;
+        for (double xi : x) {
+            double err = relativeError(kScalar[f](xi), reference(Function(f), xi));
+            if (err > worst) { worst = err; worstX = xi; }
+        }
+        QVERIFY2(worst < kTolerance, qPrintable(QString("%1: 相对误差 %2 (x = %3)").arg(kNames[f]).arg(worst).arg(worstX)));
+    }
+}
+
+void TestBesselKernel::batchMatchesBoost()
+{
+    qInfo("SIMD 路径: %s", BesselKernel::simdEnabled() ? "AVX2" : "标量");
+    const std::vector<double> x = arguments();
+    std::vector<double> out(x.size());
+    for (int f = K0; f <= I1e; ++f) {
+        kBatch[f](x.data(), int(x.size()), out.data());
+        double worst = 0.0, worstX = 0.0;
+        for (size_t i = 0; i < x.size(); ++i) {
+            double err = relativeError(out[i], reference(Function(f), x[i]));
+            if (err > worst) { worst = err; worstX = x[i]; }
+        }
+        QVERIFY2(worst < kTolerance, qPrintable(QString("%1: 相对误差 %2 (x = %3)").arg(kNames[f]).arg(worst).arg(worstX)));
+    }
+}
+
+void TestBesselKernel::batchTailMatchesScalar()
+{
+    // 长度不是 4 的倍数时, SIMD 路径剩余的元素走标量尾部; 同一数组中混合不同展开段
+    const double values[] = { 1e-6, 0.5, 1.999, 2.0, 3.7, 7.99, 8.0, 25.0, 150.0, 650.0, 0.03 };
+    for (int n = 1; n <= int(sizeof(values) / sizeof(values[0])); ++n) {
+        double out[16];
+        for (int f = K0; f <= I1e; ++f) {
+            kBatch[f](values, n, out);
+            for (int i = 0; i < n; ++i) {
+                QVERIFY2(relativeError(out[i], kScalar[f](values[i])) < kTolerance,
+                         qPrintable(QString("%1: n = %2, x = %3").arg(kNames[f]).arg(n).arg(values[i])));
+            }
+        }
+    }
+}
+
+void TestBesselKernel::largeArgumentAsymptotic()
+{
+    for (double x : { 700.5, 800.0, 1e3, 1e4, 1e6, 1e8 }) {
+        QVERIFY2(relativeError(BesselKernel::i0e(x), asymptoticScaledI(0, x)) < kTolerance, qPrintable(QString("I0e, x = %1").arg(x)));
+        QVERIFY2(relativeError(BesselKernel::i1e(x), asymptoticScaledI(1, x)) < kTolerance, qPrintable(QString("I1e, x = %1").arg(x)));
+    }
+}
+
+void TestBesselKernel::symmetry()
+{
+    // I0e 为偶函数, I1e 为奇函数
+    for (double x : { 1e-5, 0.7, 2.0, 9.5, 120.0 }) {
+        QCOMPARE(BesselKernel::i0e(-x), BesselKernel::i0e(x));
+        QCOMPARE(BesselKernel::i1e(-x), -BesselKernel::i1e(x));
+    }
+}
+
+void TestBesselKernel::complexOnRealAxis()
+{
+    // 复数宗量版本 (幂级数 / CF1+CF2 两段) 在实轴上应与实数参考值一致
+    for (double x : { 1e-4, 0.3, 1.9, 2.1, 5.0, 17.0, 90.0, 400.0 }) {
+        const std::complex<double> z(x, 0.0);
+        const std::complex<double> values[] = { BesselKernel::k0(z), BesselKernel::k1(z), BesselKernel::i0e(z), BesselKernel::i1e(z) };
+        for (int f = K0; f <= I1e; ++f) {
+            const double expected = reference(Function(f), x);
+            QVERIFY2(std::abs(values[f] - expected) / std::abs(expected) < kTolerance,
+                     qPrintable(QString("%1: x = %2").arg(kNames[f]).arg(x)));
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef TST_BESSELKERNEL_H
+#define TST_BESSELKERNEL_H
+
+#include <QObject>
+
+/**
+ * @brief BesselKernel 与 Boost 参考值的对照
+ *
+ * 参考值: x <= 700 取 boost::math::cyl_bessel_k / cyl_bessel_i (I 乘以 exp(-x));
+ * 更大的 x 上 Boost 的 I0/I1 溢出, 改用 Hankel 渐近级数。
+ * 容差: 相对误差 1e-12 (批量 / SIMD 路径与标量路径相同)。
+ */
+class TestBesselKernel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void scalarMatchesBoost();
+    void batchMatchesBoost();
+    void batchTailMatchesScalar();
+    void largeArgumentAsymptotic();
+    void symmetry();
+    void complexOnRealAxis();
+};
+
+#endif // TST_BESSELKERNEL_H
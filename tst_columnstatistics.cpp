@@ -0,0 +1,241 @@
+#include "tst_columnstatistics.h"
+#include "columnstatistics.h"
+#include "mappedtextfile.h"
+
+#include <QtTest>
+#include <QTemporaryDir>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+const double kMeanTolerance = 1e-12;
+const double kVarianceTolerance = 1e-10;
+
+// 20 万行 (约 3 个并行块), 每 7 行一个空单元格
+QVector<double> sampleValues()
+{
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> normal(50.0, 10.0);
+    QVector<double> values(200000);
+    for (int i = 0; i < values.size(); ++i) {
+        values[i] = i % 7 == 3 ? std::numeric_limits<double>::quiet_NaN() : normal(rng);
+    }
+    return values;
+}
+
+// 两遍法的均值与总体方差, 排序后线性插值的分位数
+struct Naive {
+    int numeric = 0;
+    int empty = 0;
+    double minimum = 0.0, maximum = 0.0, mean = 0.0, variance = 0.0;
+    double q1 = 0.0, median = 0.0, q3 = 0.0;
+};
+
+Naive naive(const QVector<double>& values, int first, int rows)
+{
+    Naive r;
+    std::vector<double> finite;
+    for (int i = first; i < first + rows; ++i) {
+        if (std::isnan(values[i])) ++r.empty;
+        else finite.push_back(values[i]);
+    }
+    r.numeric = int(finite.size());
+    std::sort(finite.begin(), finite.end());
+    r.minimum = finite.front();
+    r.maximum = finite.back();
+    double sum = 0.0;
+    for (double v : finite) sum += v;
+    r.mean = sum / r.numeric;
+    double m2 = 0.0;
+    for (double v : finite) m2 += (v - r.mean) * (v - r.mean);
+    r.variance = m2 / r.numeric;
+    auto quantile = [&finite](double p) {
+        const double h = (finite.size() - 1) * p;
+        const size_t k = size_t(std::floor(h));
+        if (k + 1 >= finite.size() || h == k) return finite[k];
+        return finite[k] + (h - k) * (finite[k + 1] - finite[k]);
+    };
+    r.q1 = quantile(0.25);
+    r.median = quantile(0.5);
+    r.q3 = quantile(0.75);
+    return r;
+}
+
+bool close(double value, double expected, double tolerance)
+{
+    return std::abs(value - expected) <= tolerance * std::abs(expected);
+}
+
+void compareToNaive(const ColumnStatistics::Summary& s, const Naive& n, int rows)
+{
+    QCOMPARE(s.count, rows);
+    QCOMPARE(s.numeric, n.numeric);
+    QCOMPARE(s.empty, n.empty);
+    QCOMPARE(s.text, 0);
+    QCOMPARE(s.minimum, n.minimum);
+    QCOMPARE(s.maximum, n.maximum);
+    QVERIFY2(close(s.mean, n.mean, kMeanTolerance), qPrintable(QString("均值 %1 / %2").arg(s.mean, 0, 'g', 17).arg(n.mean, 0, 'g', 17)));
+    QVERIFY2(close(s.variance(), n.variance, kVarianceTolerance),
+             qPrintable(QString("方差 %1 / %2").arg(s.variance(), 0, 'g', 17).arg(n.variance, 0, 'g', 17)));
+    QCOMPARE(s.lowerQuartile, n.q1);
+    QCOMPARE(s.median, n.median);
+    QCOMPARE(s.upperQuartile, n.q3);
+}
+
+} // namespace
+
+void TestColumnStatistics::computeMatchesNaive()
+{
+    const QVector<double> values = sampleValues();
+    const ColumnStatistics::Summary s = ColumnStatistics::compute(DataColumn(values));
+    compareToNaive(s, naive(values, 0, values.size()), values.size());
+    QVERIFY(s.isNumeric());
+}
+
+void TestColumnStatistics::computeRowRange()
+{
+    // 起点不在块边界上, 终点超出列长时截到列末尾
+    const QVector<double> values = sampleValues();
+    const DataColumn column(values);
+    compareToNaive(ColumnStatistics::compute(column, ColumnStatistics::TextSource(), 1234, 70000), naive(values, 1234, 70000), 70000);
+    const int tail = values.size() - 150000;
+    compareToNaive(ColumnStatistics::compute(column, ColumnStatistics::TextSource(), 150000, 100000), naive(values, 150000, tail), tail);
+    compareToNaive(ColumnStatistics::compute(column, ColumnStatistics::TextSource(), 150000), naive(values, 150000, tail), tail);
+}
+
+void TestColumnStatistics::mergeMatchesWhole()
+{
+    const QVector<double> values = sampleValues();
+    const DataColumn column(values);
+    const ColumnStatistics::Summary whole = ColumnStatistics::compute(column);
+    for (int split : { 1, 777, 65536, 123457 }) {
+        const ColumnStatistics::Summary merged = ColumnStatistics::merge(
+            ColumnStatistics::compute(column, ColumnStatistics::TextSource(), 0, split),
+            ColumnStatistics::compute(column, ColumnStatistics::TextSource(), split));
+        QCOMPARE(merged.count, whole.count);
+        QCOMPARE(merged.numeric, whole.numeric);
+        QCOMPARE(merged.empty, whole.empty);
+        QCOMPARE(merged.minimum, whole.minimum);
+        QCOMPARE(merged.maximum, whole.maximum);
+        QVERIFY2(close(merged.mean, whole.mean, kMeanTolerance), qPrintable(QString("split = %1").arg(split)));
+        QVERIFY2(close(merged.m2, whole.m2, kVarianceTolerance), qPrintable(QString("split = %1").arg(split)));
+        QVERIFY(std::isnan(merged.median));
+    }
+
+    // 与空段合并不改变结果
+    const ColumnStatistics::Summary withEmpty = ColumnStatistics::merge(ColumnStatistics::Summary(), whole);
+    QCOMPARE(withEmpty.numeric, whole.numeric);
+    QCOMPARE(withEmpty.mean, whole.mean);
+    QCOMPARE(withEmpty.m2, whole.m2);
+}
+
+void TestColumnStatistics::subtractMatchesRest()
+{
+    // 扣除前段后的计数与矩等于直接统计后段; 最值保持整列的值
+    const QVector<double> values = sampleValues();
+    const DataColumn column(values);
+    const ColumnStatistics::Summary whole = ColumnStatistics::compute(column);
+    for (int split : { 1, 4, 777, 65536, 123457 }) {
+        const ColumnStatistics::Summary rest = ColumnStatistics::subtract(
+            whole, ColumnStatistics::compute(column, ColumnStatistics::TextSource(), 0, split));
+        const ColumnStatistics::Summary tail = ColumnStatistics::compute(column, ColumnStatistics::TextSource(), split);
+        QCOMPARE(rest.count, tail.count);
+        QCOMPARE(rest.numeric, tail.numeric);
+        QCOMPARE(rest.empty, tail.empty);
+        QCOMPARE(rest.minimum, whole.minimum);
+        QCOMPARE(rest.maximum, whole.maximum);
+        QVERIFY2(close(rest.mean, tail.mean, kMeanTolerance), qPrintable(QString("split = %1").arg(split)));
+        QVERIFY2(close(rest.m2, tail.m2, kVarianceTolerance), qPrintable(QString("split = %1").arg(split)));
+        QVERIFY(std::isnan(rest.median));
+    }
+
+    // 扣除全部数值后矩为空; 扣除不含数值的段时矩不变
+    const ColumnStatistics::Summary none = ColumnStatistics::subtract(whole, whole);
+    QCOMPARE(none.count, 0);
+    QCOMPARE(none.numeric, 0);
+    QVERIFY(std::isnan(none.mean));
+    ColumnStatistics::Summary blank;
+    blank.count = blank.empty = 3;
+    const ColumnStatistics::Summary withoutBlank = ColumnStatistics::subtract(whole, blank);
+    QCOMPARE(withoutBlank.empty, whole.empty - 3);
+    QCOMPARE(withoutBlank.mean, whole.mean);
+    QCOMPARE(withoutBlank.m2, whole.m2);
+}
+
+void TestColumnStatistics::textAndEmptyCells()
+{
+    DataColumn column(6);
+    column.setValue(0, 2.0);
+    column.setText(1, "abc");
+    column.setText(2, "   ");
+    column.setText(3, "4");
+    column.setText(4, "abc");
+
+    const ColumnStatistics::Summary s = ColumnStatistics::compute(column);
+    QCOMPARE(s.count, 6);
+    QCOMPARE(s.numeric, 2);
+    QCOMPARE(s.text, 2);
+    QCOMPARE(s.empty, 2);
+    QCOMPARE(s.minimum, 2.0);
+    QCOMPARE(s.maximum, 4.0);
+    QCOMPARE(s.mean, 3.0);
+    QCOMPARE(s.variance(), 1.0);
+    QCOMPARE(s.median, 3.0);
+    QVERIFY(!s.isNumeric());
+
+    // 没有数值时最值与均值为 NaN, 方差为 NaN
+    DataColumn text(2);
+    text.setText(0, "x");
+    const ColumnStatistics::Summary none = ColumnStatistics::compute(text);
+    QCOMPARE(none.text, 1);
+    QCOMPARE(none.empty, 1);
+    QVERIFY(std::isnan(none.minimum));
+    QVERIFY(std::isnan(none.mean));
+    QVERIFY(std::isnan(none.variance()));
+    QVERIFY(std::isnan(none.median));
+}
+
+void TestColumnStatistics::mappedTextSource()
+{
+    // 大文件模式: 文本留在映射中, NaN 单元格按源文件字段区分空与文本
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("mapped.csv");
+    QFile out(path);
+    QVERIFY(out.open(QIODevice::WriteOnly));
+    out.write("t,note\n1,x\n2,\n3,y\n4, \n");
+    out.close();
+
+    MappedTextFile file;
+    QVERIFY(file.open(path, MappedTextFile::KeepEmptyLines));
+    ColumnStatistics::TextSource source;
+    source.file = &file;
+    source.firstLine = 1;
+    source.separator = ",";
+    source.field = 1;
+
+    const ColumnStatistics::Summary s = ColumnStatistics::compute(DataColumn(4), source);
+    QCOMPARE(s.count, 4);
+    QCOMPARE(s.numeric, 0);
+    QCOMPARE(s.text, 2);
+    QCOMPARE(s.empty, 2);
+}
+
+void TestColumnStatistics::quantileEdges()
+{
+    QVector<double> empty;
+    QVERIFY(std::isnan(ColumnStatistics::quantile(empty, 0.5)));
+
+    QVector<double> single{ 5.0 };
+    QCOMPARE(ColumnStatistics::quantile(single, 0.0), 5.0);
+    QCOMPARE(ColumnStatistics::quantile(single, 1.0), 5.0);
+
+    QVector<double> four{ 4.0, 1.0, 3.0, 2.0 };
+    QCOMPARE(ColumnStatistics::quantile(four, 0.5), 2.5);
+    QCOMPARE(ColumnStatistics::quantile(four, 0.25), 1.75);
+    // p 超出 [0, 1] 时取端点
+    QCOMPARE(ColumnStatistics::quantile(four, -1.0), 1.0);
+    QCOMPARE(ColumnStatistics::quantile(four, 2.0), 4.0);
+}
@@ -0,0 +1,25 @@
+#ifndef TST_COLUMNSTATISTICS_H
+#define TST_COLUMNSTATISTICS_H
+
+#include <QObject>
+
+/**
+ * @brief ColumnStatistics 与直接计算 (两遍求矩、排序取分位数) 的对照
+ *
+ * 行数跨过多个并行块; 计数与最值、分位数逐位相同, 均值与方差相对误差不超过 1e-12 / 1e-10。
+ */
+class TestColumnStatistics : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void computeMatchesNaive();
+    void computeRowRange();
+    void mergeMatchesWhole();
+    void subtractMatchesRest();
+    void textAndEmptyCells();
+    void mappedTextSource();
+    void quantileEdges();
+};
+
+#endif // TST_COLUMNSTATISTICS_H
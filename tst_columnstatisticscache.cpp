@@ -0,0 +1,201 @@
+#include "tst_columnstatisticscache.h"
+#include "columnstatisticscache.h"
+#include "datatablemodel.h"
+
+#include <QtTest>
+#include <cmath>
+
+namespace {
+
+const double kMeanTolerance = 1e-12;
+const double kVarianceTolerance = 1e-10;
+const int kRows = 1000;
+
+bool close(double a, double b, double tolerance)
+{
+    return std::fabs(a - b) <= tolerance * qMax(1.0, std::fabs(b));
+}
+
+// 第 0 列: 数值, 首行为最小值 -100, 末行为最大值 100, 其余在 (0, 1) 内, 每 10 行一个空单元格;
+// 第 1 列: 文本与空单元格; 第 2 列: 数值
+void fill(DataTableModel& model)
+{
+    QVector<DataColumn> columns(3, DataColumn(kRows));
+    for (int r = 0; r < kRows; ++r) {
+        if (r % 10 != 5) columns[0].setValue(r, 0.5 + 0.4 * std::sin(r * 0.37));
+        if (r % 3 != 0) columns[1].setText(r, QString("t%1").arg(r % 17));
+        columns[2].setValue(r, r * 0.25);
+    }
+    columns[0].setValue(0, -100.0);
+    columns[0].setValue(kRows - 1, 100.0);
+    model.setTable({ "p", "note", "t" }, columns);
+}
+
+// 缓存的计数、最值与矩 (quantiles 为真时还有分位数) 与重新统计一致
+bool matches(const ColumnStatistics::Summary& s, const DataTableModel& model, int column, bool quantiles)
+{
+    const ColumnStatistics::Summary fresh = ColumnStatistics::compute(model.column(column));
+    if (s.count != fresh.count || s.numeric != fresh.numeric || s.text != fresh.text || s.empty != fresh.empty) return false;
+    if (fresh.numeric == 0) return true;
+    if (s.minimum != fresh.minimum || s.maximum != fresh.maximum) return false;
+    if (!close(s.mean, fresh.mean, kMeanTolerance) || !close(s.m2, fresh.m2, kVarianceTolerance)) return false;
+    if (!quantiles) return true;
+    return s.lowerQuartile == fresh.lowerQuartile && s.median == fresh.median && s.upperQuartile == fresh.upperQuartile;
+}
+
+} // namespace
+
+void TestColumnStatisticsCache::insertRowsKeepsCache()
+{
+    DataTableModel model;
+    fill(model);
+    ColumnStatisticsCache cache(&model);
+    cache.summaries();
+
+    // 新行为空单元格, 缓存只累加计数, 不需要重新统计
+    QVERIFY(model.insertRows(5, 3));
+    QVERIFY(model.insertRows(model.rowCount(), 2));
+    for (int c = 0; c < model.columnCount(); ++c) {
+        QVERIFY(cache.isValid(c));
+        QVERIFY2(matches(cache.summary(c), model, c, true), qPrintable(QString("column %1").arg(c)));
+    }
+}
+
+void TestColumnStatisticsCache::removeBlankRowsKeepsCache()
+{
+    DataTableModel model;
+    fill(model);
+    ColumnStatisticsCache cache(&model);
+    cache.summaries();
+
+    // 第 15 行在第 0 列为空, 在第 1 列为空 (15 % 3 == 0): 两列均无数值被删
+    QVERIFY(model.removeRows(15, 1));
+    QVERIFY(cache.isValid(0));
+    QVERIFY(cache.isValid(1));
+    QVERIFY(matches(cache.summary(0), model, 0, true));
+    QVERIFY(matches(cache.summary(1), model, 1, true));
+    // 第 2 列删掉了一个非最值的数值: 矩增量更新, 分位数失效
+    QVERIFY(cache.hasMoments(2));
+    QVERIFY(!cache.isValid(2));
+}
+
+void TestColumnStatisticsCache::removeNumericRows()
+{
+    DataTableModel model;
+    fill(model);
+    ColumnStatisticsCache cache(&model);
+    cache.summaries();
+
+    // 删掉中间一段 (不含最值): 计数与矩按扣除更新, 最值保持
+    QVERIFY(model.removeRows(100, 237));
+    for (int c = 0; c < model.columnCount(); ++c) {
+        QVERIFY(cache.hasMoments(c));
+        QVERIFY2(matches(cache.moments(c), model, c, false), qPrintable(QString("column %1").arg(c)));
+    }
+    QVERIFY(!cache.isValid(0));
+    QVERIFY(std::isnan(cache.moments(0).median));
+    QVERIFY(cache.isValid(1));
+
+    // 读取全部统计量时补算分位数
+    for (int c = 0; c < model.columnCount(); ++c) {
+        QVERIFY2(matches(cache.summary(c), model, c, true), qPrintable(QString("column %1").arg(c)));
+        QVERIFY(cache.isValid(c));
+    }
+}
+
+void TestColumnStatisticsCache::removeExtremeRow()
+{
+    DataTableModel model;
+    fill(model);
+    ColumnStatisticsCache cache(&model);
+    cache.summaries();
+
+    // 首行是第 0、2 列的最小值: 最值失效, 读取时重新统计
+    QVERIFY(model.removeRows(0, 1));
+    QVERIFY(!cache.hasMoments(0));
+    QVERIFY(!cache.hasMoments(2));
+    QVERIFY(cache.isValid(1));
+    for (int c = 0; c < model.columnCount(); ++c) {
+        QVERIFY2(matches(cache.summary(c), model, c, true), qPrintable(QString("column %1").arg(c)));
+    }
+
+    // 删到不剩数值时最值不必重新统计
+    DataTableModel small;
+    small.setTable({ "p" }, { DataColumn(QVector<double>{ 1.0, 2.0, 3.0 }) });
+    ColumnStatisticsCache smallCache(&small);
+    smallCache.summaries();
+    QVERIFY(small.removeRows(0, 3));
+    QVERIFY(smallCache.isValid(0));
+    QCOMPARE(smallCache.summary(0).count, 0);
+    QCOMPARE(smallCache.summary(0).numeric, 0);
+}
+
+void TestColumnStatisticsCache::cellEdits()
+{
+    DataTableModel model;
+    fill(model);
+    ColumnStatisticsCache cache(&model);
+    cache.summaries();
+
+    // 非最值的数值改为另一个数值: 计数与矩增量更新, 分位数失效
+    model.setValue(40, 0, 0.75);
+    QVERIFY(cache.hasMoments(0));
+    QVERIFY(!cache.isValid(0));
+    QVERIFY(matches(cache.moments(0), model, 0, false));
+
+    // 新值超出最大值: 最值随之更新
+    model.setValue(41, 0, 250.0);
+    QVERIFY(cache.hasMoments(0));
+    QCOMPARE(cache.moments(0).maximum, 250.0);
+    QVERIFY(matches(cache.moments(0), model, 0, false));
+
+    // 数值改为文本、空单元格改为数值, 以及经 setData 的编辑
+    model.setText(42, 0, "abc");
+    model.setText(45, 0, "0.125");
+    QVERIFY(model.setData(model.index(46, 0), "0.625"));
+    QVERIFY(cache.hasMoments(0));
+    QVERIFY(matches(cache.moments(0), model, 0, false));
+
+    // 改掉最小值: 最值失效
+    model.setValue(0, 0, 0.5);
+    QVERIFY(!cache.hasMoments(0));
+    QVERIFY(matches(cache.summary(0), model, 0, true));
+
+    // 文本列的文本修改不涉及数值, 缓存保持有效
+    model.setText(1, 1, "changed");
+    model.setText(3, 1, "new");
+    QVERIFY(cache.isValid(1));
+    QVERIFY(matches(cache.summary(1), model, 1, true));
+
+    // 其他列不受影响
+    QVERIFY(cache.isValid(2));
+}
+
+void TestColumnStatisticsCache::styleChangesKeepCache()
+{
+    DataTableModel model;
+    fill(model);
+    ColumnStatisticsCache cache(&model);
+    cache.summaries();
+
+    model.setColumnForeground(0, Qt::red);
+    model.setColumnBackground(1, Qt::yellow);
+    model.setCellForeground(3, 2, Qt::blue);
+    model.clearCellStyles();
+    for (int c = 0; c < model.columnCount(); ++c) QVERIFY(cache.isValid(c));
+}
+
+void TestColumnStatisticsCache::setColumnInvalidates()
+{
+    DataTableModel model;
+    fill(model);
+    ColumnStatisticsCache cache(&model);
+    cache.summaries();
+
+    model.setColumn(2, DataColumn(QVector<double>(kRows, 3.0)));
+    QVERIFY(!cache.isValid(2));
+    QVERIFY(!cache.hasMoments(2));
+    QVERIFY(cache.isValid(0));
+    QCOMPARE(cache.summary(2).mean, 3.0);
+    QVERIFY(matches(cache.summary(2), model, 2, true));
+}
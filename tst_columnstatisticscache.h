@@ -0,0 +1,26 @@
+#ifndef TST_COLUMNSTATISTICSCACHE_H
+#define TST_COLUMNSTATISTICSCACHE_H
+
+#include <QObject>
+
+/**
+ * @brief ColumnStatisticsCache 的增量更新与整列重新统计的对照
+ *
+ * 插入行、删除行与单元格修改后, 缓存的计数与矩须与 ColumnStatistics::compute 一致;
+ * 只有最值被删 / 被改时最值失效, 数值变化后分位数失效, 样式变化不影响缓存。
+ */
+class TestColumnStatisticsCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertRowsKeepsCache();
+    void removeBlankRowsKeepsCache();
+    void removeNumericRows();
+    void removeExtremeRow();
+    void cellEdits();
+    void styleChangesKeepCache();
+    void setColumnInvalidates();
+};
+
+#endif // TST_COLUMNSTATISTICSCACHE_H
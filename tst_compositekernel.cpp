@@ -0,0 +1,138 @@
+#include "tst_compositekernel.h"
+#include "compositekernel.h"
+
+#include <QtTest>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+namespace {
+
+const double kSolveTolerance = 1e-9;
+
+// 以 solveDense 求解同一 Toeplitz 方程组, 返回 Levinson 结果的最大相对偏差 (按解的无穷范数)
+template <typename T>
+double levinsonDeviation(const std::vector<T>& col, const std::vector<T>& b, bool* ok)
+{
+    const int n = int(col.size());
+    std::vector<T> x;
+    *ok = CompositeKernel::solveSymmetricToeplitz(col, b, x);
+
+    std::vector<T> A(n * n), ref = b;
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j) A[i * n + j] = col[std::abs(i - j)];
+    if (!CompositeKernel::solveDense(A, ref, n)) { *ok = false; return 0.0; }
+
+    double diff = 0.0, scale = 0.0;
+    for (int i = 0; i < n; ++i) {
+        diff = std::max(diff, std::abs(x[i] - ref[i]));
+        scale = std::max(scale, std::abs(ref[i]));
+    }
+    return diff / scale;
+}
+
+} // namespace
+
+void TestCompositeKernel::toeplitzMatchesDense()
+{
+    std::mt19937 rng(20240611);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+    for (int n = 1; n <= 40; ++n) {
+        std::vector<double> b(n);
+        for (double& v : b) v = uniform(rng);
+
+        // 对角占优: t0 = 1 + 2*sum|tk|
+        std::vector<double> dominant(n);
+        double offSum = 0.0;
+        for (int k = 1; k < n; ++k) { dominant[k] = uniform(rng); offSum += std::abs(dominant[k]); }
+        dominant[0] = 1.0 + 2.0 * offSum;
+
+        // 谱构造: tk = sum_j a_j cos(w_j k) + 0.05 delta_k0, 半正定部分加小对角, 条件数较大
+        std::vector<double> spectral(n, 0.0);
+        for (int j = 0; j < 6; ++j) {
+            const double a = 0.5 + 0.5 * uniform(rng), w = M_PI * (0.5 + 0.5 * uniform(rng));
+            for (int k = 0; k < n; ++k) spectral[k] += a * std::cos(w * k);
+        }
+        spectral[0] += 0.05;
+
+        // Kac-Murdock-Szego: tk = rho^k
+        std::vector<double> kms(n);
+        for (int k = 0; k < n; ++k) kms[k] = std::pow(0.9, k);
+
+        const std::vector<double>* cases[] = { &dominant, &spectral, &kms };
+        const char* const names[] = { "对角占优", "谱构造", "KMS" };
+        for (int c = 0; c < 3; ++c) {
+            bool ok = false;
+            const double dev = levinsonDeviation(*cases[c], b, &ok);
+            QVERIFY2(ok, qPrintable(QString("%1: n = %2 求解失败").arg(names[c]).arg(n)));
+            QVERIFY2(dev < kSolveTolerance, qPrintable(QString("%1: n = %2, 偏差 %3").arg(names[c]).arg(n).arg(dev)));
+        }
+    }
+}
+
+void TestCompositeKernel::toeplitzComplexMatchesDense()
+{
+    // 复反演路径上的影响矩阵为复对称 (非 Hermite) Toeplitz
+    using C = std::complex<double>;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+    for (int n = 1; n <= 30; ++n) {
+        std::vector<C> col(n), b(n);
+        double offSum = 0.0;
+        for (int k = 1; k < n; ++k) { col[k] = C(uniform(rng), uniform(rng)); offSum += std::abs(col[k]); }
+        col[0] = C(1.0 + 2.0 * offSum, uniform(rng));
+        for (C& v : b) v = C(uniform(rng), uniform(rng));
+
+        bool ok = false;
+        const double dev = levinsonDeviation(col, b, &ok);
+        QVERIFY2(ok, qPrintable(QString("n = %1 求解失败").arg(n)));
+        QVERIFY2(dev < kSolveTolerance, qPrintable(QString("n = %1, 偏差 %2").arg(n).arg(dev)));
+    }
+}
+
+void TestCompositeKernel::toeplitzSingular()
+{
+    // 全 1 矩阵的二阶主子式为零, 应返回 false 交由 solveDense 处理
+    std::vector<double> x;
+    QVERIFY(!CompositeKernel::solveSymmetricToeplitz(std::vector<double>(3, 1.0), std::vector<double>(3, 1.0), x));
+    QVERIFY(!CompositeKernel::solveSymmetricToeplitz(std::vector<double>{ 0.0, 1.0 }, std::vector<double>(2, 1.0), x));
+    QVERIFY(!CompositeKernel::solveSymmetricToeplitz(std::vector<double>(), std::vector<double>(), x));
+}
+
+void TestCompositeKernel::influenceIntegralClosedForm()
+{
+    // Ac = 0 时被积函数为 K0(gama1*LfD*|u|); gama1*LfD 足够大时 int_0^inf K0 = pi/2 截断误差可忽略
+    for (double gama1 : { 40.0, 60.0, 120.0 }) {
+        for (double LfD : { 1.0, 0.5 }) {
+            const double expected = M_PI / (gama1 * LfD);
+            QuadratureStats stats;
+            const double value = CompositeKernel::influenceIntegral(gama1, 1e4, 0.0, LfD, 0.0, &stats, nullptr);
+            const double err = std::abs(value - expected);
+            QVERIFY2(err < 1e-5, qPrintable(QString("gama1 = %1, LfD = %2: 误差 %3").arg(gama1).arg(LfD).arg(err)));
+            QCOMPARE(stats.evaluations, 15 * stats.panels);
+        }
+    }
+}
+
+void TestCompositeKernel::influenceIntegralBatchMatchesScalar()
+{
+    // 批量 Bessel 路径 (double 重载) 与逐点模板路径积分同一被积函数; offset 覆盖奇点在区间内外
+    const double offsets[] = { 0.0, 0.3, 0.9, 1.8 };
+    const double params[][4] = {   // gama1, rmD, Ac_prefactor, LfD
+        { 0.05, 5.0, 0.8, 0.6 },
+        { 1.3, 3.0, 0.2, 0.3 },
+        { 8.0, 2.0, 1.5, 0.15 },
+    };
+    for (const auto& p : params) {
+        const double argRm = p[0] * p[1];
+        for (double offset : offsets) {
+            const double batch = CompositeKernel::influenceIntegral(p[0], argRm, p[2], p[3], offset, nullptr, nullptr);
+            const double scalar = CompositeKernel::influenceIntegral<double>(p[0], argRm, p[2], p[3], offset, nullptr, nullptr);
+            const double rel = std::abs(batch - scalar) / std::abs(scalar);
+            QVERIFY2(rel < 1e-12, qPrintable(QString("gama1 = %1, offset = %2: 相对偏差 %3").arg(p[0]).arg(offset).arg(rel)));
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef TST_COMPOSITEKERNEL_H
+#define TST_COMPOSITEKERNEL_H
+
+#include <QObject>
+
+/**
+ * @brief CompositeKernel 中 Levinson 递推与影响积分的对照
+ *
+ * Toeplitz: 随机对称正定 (对角占优 / 谱构造 / KMS) 矩阵上与 solveDense 相对误差不超过 1e-9,
+ * 复对称矩阵同样; 奇异主子式时返回 false。
+ * 影响积分: Ac = 0 且 gama1*LfD 很大时 int_{-1}^{1} K0 = pi / (gama1*LfD), 容差取积分的绝对误差限 1e-5;
+ * 批量实数路径与模板标量路径相对误差不超过 1e-12。
+ */
+class TestCompositeKernel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void toeplitzMatchesDense();
+    void toeplitzComplexMatchesDense();
+    void toeplitzSingular();
+    void influenceIntegralClosedForm();
+    void influenceIntegralBatchMatchesScalar();
+};
+
+#endif // TST_COMPOSITEKERNEL_H
@@ -0,0 +1,149 @@
+#include "tst_compositemodel.h"
+#include "compositemodel.h"
+#include "dualnumber.h"
+
+#include <QtTest>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using P = CompositeParameters;
+
+const double kTolerance = 1e-5;
+const double kRelativeStep = 2e-3;
+const double kNegligible = 1e-3;   // 灵敏度低于曲线尺度的该比例时视为无影响
+
+// 两组参数: 边界影响出现在测试时间范围之外 / 之内
+QVector<P> parameterPoints()
+{
+    P a;
+    a[P::Kf] = 1e-3; a[P::Km] = 1e-4; a[P::L] = 1000.0; a[P::Lf] = 200.0;
+    a[P::RmD] = 2.0; a[P::ReD] = 20.0; a[P::Omega1] = 0.05; a[P::Omega2] = 0.3; a[P::Lambda1] = 0.01;
+    a[P::Nf] = 4; a[P::CD] = 1.0; a[P::S] = 0.1; a[P::GamaD] = 0.02; a[P::N] = 8;
+    a.syncDerived();
+
+    P b;
+    b[P::Kf] = 5e-3; b[P::Km] = 2e-4; b[P::L] = 600.0; b[P::Lf] = 90.0;
+    b[P::RmD] = 1.5; b[P::ReD] = 4.0; b[P::Omega1] = 0.2; b[P::Omega2] = 0.05; b[P::Lambda1] = 0.1;
+    b[P::Nf] = 3; b[P::CD] = 0.3; b[P::S] = 1.0; b[P::GamaD] = 0.005; b[P::N] = 10;
+    b[P::Phi] = 0.08; b[P::Mu] = 1.2; b[P::Ct] = 1e-3;
+    b.syncDerived();
+    return { a, b };
+}
+
+// 被求导的参数: 模型使用的全部连续参数 (裂缝条数为整数, 不参与)
+QVector<P::Id> differentiableIds(CompositeModel::ModelType type)
+{
+    QVector<P::Id> ids = CompositeModel::parameterSchema(type);
+    ids.removeAll(P::Nf);
+    return ids;
+}
+
+ModelEvaluationOptions stehfestOptions()
+{
+    ModelEvaluationOptions options;
+    options.highPrecision = true;
+    options.parallel = false;
+    return options;
+}
+
+} // namespace
+
+void TestCompositeModel::sensitivityMatchesFiniteDifference()
+{
+    const QVector<double> t = CompositeModel::logTimeSteps(40, -2.0, 4.0);
+    const ModelEvaluationOptions options = stehfestOptions();
+    const QVector<P> points = parameterPoints();
+
+    for (int type = CompositeModel::Model_1; type <= CompositeModel::Model_6; ++type) {
+        const CompositeModel model(static_cast<CompositeModel::ModelType>(type));
+        const QVector<P::Id> allIds = differentiableIds(model.type());
+
+        for (int pt = 0; pt < points.size(); ++pt) {
+            const P& params = points[pt];
+            // 参数个数可能超过对偶数分量上限, 分组求导
+            for (int first = 0; first < allIds.size(); first += Dual::MaxDerivatives) {
+                const QVector<P::Id> ids = allIds.mid(first, Dual::MaxDerivatives);
+                const ModelSensitivityData sens = model.calculateTheoreticalCurveSensitivity(params, ids, t, options);
+                QVERIFY(sens.valid);
+                QCOMPARE(sens.dPressure.size(), ids.size());
+
+                const double pressureScale = *std::max_element(sens.pressure.cbegin(), sens.pressure.cend());
+                const double derivativeScale = *std::max_element(sens.derivative.cbegin(), sens.derivative.cend());
+
+                for (int j = 0; j < ids.size(); ++j) {
+                    const P::Id id = ids[j];
+                    const double h = kRelativeStep * std::abs(params[id]);
+                    // 五点中心差分: 截断误差 O(h^4); 步长不宜过小, 否则自适应积分的离散误差被 1/h 放大
+                    ModelCurveData curves[4];
+                    const double offsets[4] = { -2.0, -1.0, 1.0, 2.0 };
+                    for (int s = 0; s < 4; ++s) {
+                        P shifted = params;
+                        shifted[id] += offsets[s] * h;
+                        shifted.syncDerived();
+                        curves[s] = model.calculateTheoreticalCurve(shifted, t, options);
+                    }
+                    auto difference = [&](int column, int i) {
+                        auto at = [&](int s) { return column == 1 ? std::get<1>(curves[s])[i] : std::get<2>(curves[s])[i]; };
+                        return (at(0) - 8.0 * at(1) + 8.0 * at(2) - at(3)) / (12.0 * h);
+                    };
+
+                    // 列的尺度取差分列的无穷范数; 对当前时间范围几乎无影响的参数 (如远边界 reD) 以曲线尺度 / 参数值为下限
+                    double pErr = 0.0, pNorm = kNegligible * pressureScale / std::abs(params[id]);
+                    double dErr = 0.0, dNorm = kNegligible * derivativeScale / std::abs(params[id]);
+                    for (int i = 0; i < t.size(); ++i) {
+                        const double fdP = difference(1, i);
+                        const double fdD = difference(2, i);
+                        pErr = std::max(pErr, std::abs(sens.dPressure[j][i] - fdP));
+                        dErr = std::max(dErr, std::abs(sens.dDerivative[j][i] - fdD));
+                        pNorm = std::max(pNorm, std::abs(fdP));
+                        dNorm = std::max(dNorm, std::abs(fdD));
+                    }
+                    const QString where = QString("Model %1, 参数组 %2, %3").arg(type + 1).arg(pt + 1).arg(P::keyOf(id));
+                    QVERIFY2(pErr / pNorm < kTolerance, qPrintable(QString("%1: 压力列相对误差 %2").arg(where).arg(pErr / pNorm)));
+                    QVERIFY2(dErr / dNorm < kTolerance, qPrintable(QString("%1: 导数列相对误差 %2").arg(where).arg(dErr / dNorm)));
+                }
+            }
+        }
+    }
+}
+
+void TestCompositeModel::sensitivityValuesMatchCurve()
+{
+    // 对偶数求值的实部与实数路径的理论曲线一致
+    const QVector<double> t = CompositeModel::logTimeSteps(30, -2.0, 4.0);
+    const ModelEvaluationOptions options = stehfestOptions();
+    for (int type = CompositeModel::Model_1; type <= CompositeModel::Model_6; ++type) {
+        const CompositeModel model(static_cast<CompositeModel::ModelType>(type));
+        for (const P& params : parameterPoints()) {
+            const ModelSensitivityData sens = model.calculateTheoreticalCurveSensitivity(params, { P::Kf, P::Lf }, t, options);
+            const ModelCurveData curve = model.calculateTheoreticalCurve(params, t, options);
+            QVERIFY(sens.valid);
+            for (int i = 0; i < t.size(); ++i) {
+                const double p = std::get<1>(curve)[i], d = std::get<2>(curve)[i];
+                QVERIFY2(std::abs(sens.pressure[i] - p) <= 1e-10 * std::abs(p),
+                         qPrintable(QString("Model %1, t = %2: 压力 %3 / %4").arg(type + 1).arg(t[i]).arg(sens.pressure[i]).arg(p)));
+                QVERIFY2(std::abs(sens.derivative[i] - d) <= 1e-10 * std::abs(d) + 1e-14,
+                         qPrintable(QString("Model %1, t = %2: 导数 %3 / %4").arg(type + 1).arg(t[i]).arg(sens.derivative[i]).arg(d)));
+            }
+        }
+    }
+}
+
+void TestCompositeModel::sensitivityUnsupported()
+{
+    // 复平面反演与超过分量上限的参数个数不支持自动微分, 由调用方退回差分
+    const CompositeModel model(CompositeModel::Model_1);
+    const QVector<double> t = CompositeModel::logTimeSteps(10, -1.0, 2.0);
+    const P params = parameterPoints().first();
+
+    ModelEvaluationOptions talbot = stehfestOptions();
+    talbot.inversionMethod = LaplaceInversionMethod::Talbot;
+    QVERIFY(!model.calculateTheoreticalCurveSensitivity(params, { P::Kf }, t, talbot).valid);
+
+    QVector<P::Id> tooMany;
+    for (int k = 0; k <= Dual::MaxDerivatives; ++k) tooMany << P::Kf;
+    QVERIFY(!model.calculateTheoreticalCurveSensitivity(params, tooMany, t, stehfestOptions()).valid);
+    QVERIFY(!model.calculateTheoreticalCurveSensitivity(params, QVector<P::Id>(), t, stehfestOptions()).valid);
+}
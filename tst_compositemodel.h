@@ -0,0 +1,24 @@
+#ifndef TST_COMPOSITEMODEL_H
+#define TST_COMPOSITEMODEL_H
+
+#include <QObject>
+
+/**
+ * @brief CompositeModel 前向自动微分灵敏度与中心差分的对照
+ *
+ * Model 1-6 各取两组参数, 对 parameterSchema 中全部连续参数求导 (L / Lf 经 LfD 传播),
+ * 压力列与 Bourdet 导数列分别比较。差分取五点中心公式, 步长为参数值的 2e-3
+ * (更小的步长会放大自适应积分的离散误差); 实测最大偏差约 5e-6。
+ * 容差: 按列的无穷范数计相对误差不超过 1e-5 (逐点相对误差在灵敏度过零处无意义)。
+ */
+class TestCompositeModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sensitivityMatchesFiniteDifference();
+    void sensitivityValuesMatchCurve();
+    void sensitivityUnsupported();
+};
+
+#endif // TST_COMPOSITEMODEL_H
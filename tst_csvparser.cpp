@@ -0,0 +1,152 @@
+#include "tst_csvparser.h"
+#include "csvparser.h"
+#include "mappedtextfile.h"
+
+#include <QtTest>
+#include <QTemporaryDir>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const QStringList kSeparators = { ",", "\t", ";", "|" };
+
+QString writeFile(const QTemporaryDir& dir, const QString& name, const QByteArray& content)
+{
+    const QString path = dir.filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size()) return QString();
+    return path;
+}
+
+} // namespace
+
+void TestCsvParser::detectEncoding_data()
+{
+    QTest::addColumn<QByteArray>("sample");
+    QTest::addColumn<QString>("encoding");
+
+    QTest::newRow("ASCII") << QByteArray("time,pressure\n0.5,12.3\n") << QString("UTF-8");
+    QTest::newRow("UTF-8 中文") << QByteArray("\xE5\x8E\x8B\xE5\x8A\x9B,\xE6\x97\xB6\xE9\x97\xB4\n") << QString("UTF-8");
+    QTest::newRow("GBK 中文") << QByteArray("\xD1\xB9\xC1\xA6,\xCA\xB1\xBC\xE4\n") << QString("GBK");
+    QTest::newRow("末尾截断的字符") << QByteArray("abc,\xE5\x8E") << QString("UTF-8");
+    QTest::newRow("缺少后续字节") << QByteArray("a\xE5\x41\x42") << QString("GBK");
+    QTest::newRow("二进制") << QByteArray("a\0\xFF", 3) << QString("UTF-8");
+}
+
+void TestCsvParser::detectEncoding()
+{
+    QFETCH(QByteArray, sample);
+    QFETCH(QString, encoding);
+    QCOMPARE(CsvParser::detectEncoding(sample), encoding);
+}
+
+void TestCsvParser::detectSeparator_data()
+{
+    QTest::addColumn<QByteArray>("sample");
+    QTest::addColumn<QString>("separator");
+
+    QTest::newRow("逗号") << QByteArray("a,b,c\n1,2,3\n4,5,6\n") << QString(",");
+    QTest::newRow("制表符") << QByteArray("t\tp\r\n1\t2\r\n3\t4\r\n") << QString("\t");
+    QTest::newRow("竖线") << QByteArray("a|b\n1|2\n") << QString("|");
+    // 说明行中的逗号只出现在一行, 取多数行一致的分号
+    QTest::newRow("说明行") << QByteArray("# 试井数据, 2024\ntime;pressure;rate\n1;2;3\n4;5;6\n") << QString(";");
+    // 引号内的逗号不计
+    QTest::newRow("引号") << QByteArray("\"a,b\";c\n\"d,e\";f\n") << QString(";");
+    // 末尾被截断的行不计
+    QTest::newRow("截断的末行") << QByteArray("a;b\n1;2\n3,4,5,6,7") << QString(";");
+    QTest::newRow("没有分隔符") << QByteArray("abc\ndef\n") << QString(",");
+}
+
+void TestCsvParser::detectSeparator()
+{
+    QFETCH(QByteArray, sample);
+    QFETCH(QString, separator);
+    QCOMPARE(CsvParser::detectSeparator(sample, kSeparators), separator);
+    QCOMPARE(CsvParser::sniff(sample, kSeparators).separator, separator);
+}
+
+void TestCsvParser::readSampleSkipsBom()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = writeFile(dir, "bom.csv", QByteArray("\xEF\xBB\xBFtime,p\n1,2\n"));
+    QVERIFY(!path.isEmpty());
+    QCOMPARE(CsvParser::readSample(path), QByteArray("time,p\n1,2\n"));
+    QVERIFY(CsvParser::readSample(dir.filePath("missing.csv")).isEmpty());
+}
+
+void TestCsvParser::parseFields()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = writeFile(dir, "fields.csv",
+                                   QByteArray("time,pressure,note\r\n"
+                                              "0.5,10.25,ok\r\n"
+                                              "1,,\r\n"
+                                              "\"2\",11.5,\"x,y\"\r\n"
+                                              "3,12.75\r\n"
+                                              " 4 ,+13,5\r\n"));
+    MappedTextFile file;
+    QString error;
+    QVERIFY2(file.open(path, MappedTextFile::KeepEmptyLines, &error), qPrintable(error));
+    QCOMPARE(file.lineCount(), 6);
+
+    CsvParser parser;
+    const CsvParser::Result result = parser.parse(file, 1, 3, ",");
+    QCOMPARE(result.rowCount, 5);
+    QCOMPARE(result.columns.size(), 3);
+    QCOMPARE(result.textFields, (QVector<int>{ -1, -1, 2 }));
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const QVector<QVector<double>> expected = {
+        { 0.5, 1.0, 2.0, 3.0, 4.0 },
+        { 10.25, nan, 11.5, 12.75, 13.0 },
+        { nan, nan, nan, nan, 5.0 },
+    };
+    for (int c = 0; c < 3; ++c) {
+        QVERIFY(result.columns[c].isNumeric());
+        for (int row = 0; row < 5; ++row) {
+            const double value = result.columns[c].value(row);
+            const double want = expected[c][row];
+            QVERIFY2(std::isnan(want) ? std::isnan(value) : value == want,
+                     qPrintable(QString("列 %1 行 %2: %3").arg(c).arg(row).arg(value)));
+        }
+    }
+}
+
+void TestCsvParser::parseManyChunks()
+{
+    // 行数远多于一块, 各块并行解析后行序与数值应与逐行生成的一致
+    const int rows = 200000;
+    QByteArray content("index\tvalue\n");
+    content.reserve(rows * 16);
+    for (int i = 0; i < rows; ++i) {
+        content += QByteArray::number(i) + '\t' + QByteArray::number(i * 0.25, 'g', 17) + '\n';
+    }
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = writeFile(dir, "large.txt", content);
+    QVERIFY(!path.isEmpty());
+
+    MappedTextFile file;
+    QVERIFY(file.open(path, MappedTextFile::KeepEmptyLines));
+    QCOMPARE(file.lineCount(), rows + 1);
+
+    CsvParser parser;
+    std::atomic<int> lastPercent(0);
+    connect(&parser, &CsvParser::progress, [&lastPercent](int percent, const QString&) {
+        int seen = lastPercent.load();
+        while (percent > seen && !lastPercent.compare_exchange_weak(seen, percent)) {}
+    });
+    const CsvParser::Result result = parser.parse(file, 1, 2, "\t");
+    QCOMPARE(result.rowCount, rows);
+    QCOMPARE(result.textFields, (QVector<int>{ -1, -1 }));
+    QCOMPARE(lastPercent.load(), 100);
+    for (int i = 0; i < rows; ++i) {
+        if (result.columns[0].value(i) != i || result.columns[1].value(i) != i * 0.25) {
+            QFAIL(qPrintable(QString("行 %1 与生成的数据不一致").arg(i)));
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef TST_CSVPARSER_H
+#define TST_CSVPARSER_H
+
+#include <QObject>
+
+/**
+ * @brief CsvParser 的编码 / 分隔符检测与多线程解析
+ *
+ * 解析结果与逐行串行解析一致: 行序不变, 空字段与缺少的字段为 NaN,
+ * 出现非数值文本的列记入 textFields。
+ */
+class TestCsvParser : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void detectEncoding_data();
+    void detectEncoding();
+    void detectSeparator_data();
+    void detectSeparator();
+    void readSampleSkipsBom();
+    void parseFields();
+    void parseManyChunks();
+};
+
+#endif // TST_CSVPARSER_H
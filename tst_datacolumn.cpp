@@ -0,0 +1,116 @@
+#include "tst_datacolumn.h"
+#include "datacolumn.h"
+
+#include <QtTest>
+#include <cmath>
+#include <limits>
+#include <random>
+
+void TestDataColumn::parse_data()
+{
+    QTest::addColumn<QByteArray>("text");
+    QTest::addColumn<double>("value");
+    QTest::addColumn<bool>("ok");
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    QTest::newRow("整数") << QByteArray("42") << 42.0 << true;
+    QTest::newRow("小数") << QByteArray("1.5") << 1.5 << true;
+    QTest::newRow("首尾空白") << QByteArray(" \t-2.25\r ") << -2.25 << true;
+    QTest::newRow("前导加号") << QByteArray("+3") << 3.0 << true;
+    QTest::newRow("科学计数") << QByteArray("1e3") << 1000.0 << true;
+    QTest::newRow("大写指数") << QByteArray("2.5E-3") << 0.0025 << true;
+    QTest::newRow("省略整数部分") << QByteArray(".5") << 0.5 << true;
+    QTest::newRow("空串") << QByteArray("") << nan << true;
+    QTest::newRow("空白") << QByteArray("   ") << nan << true;
+    QTest::newRow("文本") << QByteArray("abc") << nan << false;
+    QTest::newRow("数值后跟文本") << QByteArray("12abc") << nan << false;
+    QTest::newRow("两个小数点") << QByteArray("1.2.3") << nan << false;
+    QTest::newRow("逗号小数") << QByteArray("1,5") << nan << false;
+    QTest::newRow("只有加号") << QByteArray("+") << nan << false;
+    QTest::newRow("加减号") << QByteArray("+-1") << nan << false;
+    QTest::newRow("十六进制") << QByteArray("0x10") << nan << false;
+    QTest::newRow("inf") << QByteArray("inf") << nan << false;
+    QTest::newRow("nan") << QByteArray("nan") << nan << false;
+    QTest::newRow("溢出") << QByteArray("1e400") << nan << false;
+}
+
+void TestDataColumn::parse()
+{
+    QFETCH(QByteArray, text);
+    QFETCH(double, value);
+    QFETCH(bool, ok);
+
+    bool bytesOk = !ok;
+    const double fromBytes = DataColumn::parse(text, &bytesOk);
+    bool stringOk = !ok;
+    const double fromString = DataColumn::parse(QString::fromLatin1(text), &stringOk);
+
+    QCOMPARE(bytesOk, ok);
+    QCOMPARE(stringOk, ok);
+    if (std::isnan(value)) {
+        QVERIFY(std::isnan(fromBytes));
+        QVERIFY(std::isnan(fromString));
+    } else {
+        QCOMPARE(fromBytes, value);
+        QCOMPARE(fromString, value);
+    }
+}
+
+void TestDataColumn::formatNotation()
+{
+    // 常见量级为定点 (不出现 1e+06), 极大或极小的值为科学计数
+    QCOMPARE(DataColumn::format(1000000.0), QString("1000000"));
+    QCOMPARE(DataColumn::format(2500000.0), QString("2500000"));
+    QCOMPARE(DataColumn::format(-0.125), QString("-0.125"));
+    QCOMPARE(DataColumn::format(0.1), QString("0.1"));
+    QCOMPARE(DataColumn::format(0.0), QString("0"));
+    QCOMPARE(DataColumn::format(1e-5), QString("1e-05"));
+    QCOMPARE(DataColumn::format(1e20), QString("1e+20"));
+    QCOMPARE(DataColumn::format(3.14159, 2), QString("3.14"));
+    QCOMPARE(DataColumn::format(2.0, 6), QString("2.000000"));
+    QVERIFY(DataColumn::format(std::numeric_limits<double>::quiet_NaN()).isEmpty());
+}
+
+void TestDataColumn::formatRoundTrip()
+{
+    // 最短表示写出后再解析应逐位还原 (保存 CSV 后重新打开数值不变)
+    std::mt19937_64 rng(20240521);
+    std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-12, 18);
+    for (int i = 0; i < 20000; ++i) {
+        const double v = mantissa(rng) * std::pow(10.0, exponent(rng));
+        const QString text = DataColumn::format(v);
+        bool ok = false;
+        const double back = DataColumn::parse(text.toLatin1(), &ok);
+        QVERIFY2(ok && back == v, qPrintable(QString("%1 -> %2").arg(v, 0, 'g', 17).arg(text)));
+    }
+}
+
+void TestDataColumn::textConversion()
+{
+    DataColumn column(4);
+    QVERIFY(column.isNumeric());
+    column.setValue(0, 1.5);
+    column.setText(1, "2.5");
+    QVERIFY(column.isNumeric());
+
+    // 写入非数值文本后整列转为文本列, 已有数值保留
+    column.setText(2, "abc");
+    QVERIFY(column.kind() == DataColumn::Text);
+    QCOMPARE(column.value(0), 1.5);
+    QCOMPARE(column.value(1), 2.5);
+    QVERIFY(std::isnan(column.value(2)));
+    QCOMPARE(column.text(0), QString("1.5"));
+    QCOMPARE(column.text(2), QString("abc"));
+    QVERIFY(column.isEmpty(3));
+    QVERIFY(!column.isEmpty(2));
+
+    // 相同文本在字符串池中只存一份; fromText 重建出相同的列
+    column.setText(3, "abc");
+    QCOMPARE(column.textIds().at(2), column.textIds().at(3));
+    const DataColumn rebuilt = DataColumn::fromText(column.values(), column.strings(), column.textIds());
+    QVERIFY(rebuilt.kind() == DataColumn::Text);
+    for (int row = 0; row < column.size(); ++row) {
+        QCOMPARE(rebuilt.text(row), column.text(row));
+    }
+}
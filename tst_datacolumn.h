@@ -0,0 +1,24 @@
+#ifndef TST_DATACOLUMN_H
+#define TST_DATACOLUMN_H
+
+#include <QObject>
+
+/**
+ * @brief DataColumn 单元格文本的解析、格式化与文本列转换
+ *
+ * 字节形式 (映射文件, std::from_chars) 与 QString 形式的解析规则必须一致:
+ * 去掉首尾空白, 空白为 NaN 且有效, 允许前导 '+', 非数值、溢出与非有限值无效。
+ */
+class TestDataColumn : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parse_data();
+    void parse();
+    void formatNotation();
+    void formatRoundTrip();
+    void textConversion();
+};
+
+#endif // TST_DATACOLUMN_H
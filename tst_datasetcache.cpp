@@ -0,0 +1,211 @@
+#include "tst_datasetcache.h"
+#include "datasetcache.h"
+
+#include <QtTest>
+#include <QJsonArray>
+#include <QTemporaryDir>
+#include <cmath>
+
+namespace {
+
+const int kRows = 1000;
+
+// 数值列 (含空单元格)、文本列与留在映射中的列各一
+DataSetCache::Content sampleContent(const QString& sourcePath)
+{
+    DataSetCache::Content content;
+    content.source = DataSetCache::describe(sourcePath, "csv|1|1|UTF-8|,");
+    content.rowCount = kRows;
+
+    DataSetCache::Column numeric;
+    numeric.header = "时间";
+    numeric.data = DataColumn(kRows);
+    for (int i = 0; i < kRows; ++i) {
+        if (i % 10 != 9) numeric.data.setValue(i, i * 0.1 - 3.0);
+    }
+
+    DataSetCache::Column text;
+    text.header = "备注";
+    text.data = DataColumn(kRows);
+    for (int i = 0; i < kRows; ++i) {
+        text.data.setText(i, i % 3 == 0 ? QString("关井") : QString::number(i));
+    }
+
+    DataSetCache::Column mapped;
+    mapped.header = "说明";
+    mapped.data = DataColumn(kRows);
+    mapped.sourceField = 2;
+
+    content.columns = { numeric, text, mapped };
+    content.firstLine = 1;
+    content.separator = ",";
+    content.localEncoding = true;
+    content.lineMode = 1;
+    content.metadata = QJsonObject{ { "columns", QJsonArray{ QJsonObject{ { "name", "压力" }, { "unit", "MPa" } } } } };
+    return content;
+}
+
+QString writeSource(const QTemporaryDir& dir)
+{
+    const QString path = dir.filePath("data.csv");
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return QString();
+    file.write("时间,备注,说明\n0,关井,a\n");
+    return path;
+}
+
+bool sameValues(const QVector<double>& a, const QVector<double>& b)
+{
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < a.size(); ++i) {
+        if (std::isnan(a[i]) != std::isnan(b[i]) || (!std::isnan(a[i]) && a[i] != b[i])) return false;
+    }
+    return true;
+}
+
+void compareColumns(const DataSetCache::Content& read, const DataSetCache::Content& written)
+{
+    QCOMPARE(read.rowCount, written.rowCount);
+    QCOMPARE(read.columns.size(), written.columns.size());
+    for (int c = 0; c < written.columns.size(); ++c) {
+        const DataSetCache::Column& a = read.columns[c];
+        const DataSetCache::Column& b = written.columns[c];
+        QCOMPARE(a.header, b.header);
+        QCOMPARE(a.sourceField, b.sourceField);
+        QVERIFY(a.data.kind() == b.data.kind());
+        QVERIFY2(sameValues(a.data.values(), b.data.values()), qPrintable(QString("列 %1 数值不一致").arg(c)));
+        QCOMPARE(a.data.strings(), b.data.strings());
+        QCOMPARE(a.data.textIds(), b.data.textIds());
+    }
+}
+
+} // namespace
+
+void TestDataSetCache::roundTrip()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString source = writeSource(dir);
+    QVERIFY(!source.isEmpty());
+    const QString cacheFile = DataSetCache::cacheFilePath(dir.path(), source);
+    QVERIFY(cacheFile.startsWith(DataSetCache::cacheDirectory(dir.path())));
+
+    const DataSetCache::Content written = sampleContent(source);
+    QVERIFY(written.columns[1].data.kind() == DataColumn::Text);
+    QString error;
+    QVERIFY2(DataSetCache::write(cacheFile, written, &error), qPrintable(error));
+
+    DataSetCache::Content read;
+    QVERIFY2(DataSetCache::read(cacheFile, written.source, &read, &error), qPrintable(error));
+    QCOMPARE(read.source.path, written.source.path);
+    QCOMPARE(read.source.size, written.source.size);
+    QCOMPARE(read.source.modified, written.source.modified);
+    QCOMPARE(read.source.loadKey, written.source.loadKey);
+    compareColumns(read, written);
+    QCOMPARE(read.firstLine, written.firstLine);
+    QCOMPARE(read.separator, written.separator);
+    QCOMPARE(read.localEncoding, written.localEncoding);
+    QCOMPARE(read.lineMode, written.lineMode);
+    QVERIFY(read.metadata == written.metadata);
+    for (int row = 0; row < kRows; ++row) {
+        QCOMPARE(read.columns[1].data.text(row), written.columns[1].data.text(row));
+    }
+}
+
+void TestDataSetCache::staleSource()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString source = writeSource(dir);
+    const QString cacheFile = DataSetCache::cacheFilePath(dir.path(), source);
+    const DataSetCache::Content written = sampleContent(source);
+    QVERIFY(DataSetCache::write(cacheFile, written));
+
+    DataSetCache::Content read;
+    QString error;
+    DataSetCache::Source otherKey = written.source;
+    otherKey.loadKey = "csv|2|1|UTF-8|,";
+    QVERIFY(!DataSetCache::read(cacheFile, otherKey, &read, &error));
+    QVERIFY(!error.isEmpty());
+
+    // 来源文件被修改后大小不同, 缓存失效
+    QFile file(source);
+    QVERIFY(file.open(QIODevice::Append));
+    file.write("1,2,b\n");
+    file.close();
+    error.clear();
+    QVERIFY(!DataSetCache::read(cacheFile, DataSetCache::describe(source, written.source.loadKey), &read, &error));
+    QVERIFY(!error.isEmpty());
+
+    QVERIFY(!DataSetCache::read(dir.filePath("missing.wtdc"), written.source, &read));
+}
+
+void TestDataSetCache::corruptFile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString source = writeSource(dir);
+    const QString cacheFile = dir.filePath("corrupt.wtdc");
+    const DataSetCache::Content written = sampleContent(source);
+    DataSetCache::Content read;
+
+    // 魔数不符
+    QVERIFY(DataSetCache::write(cacheFile, written));
+    {
+        QFile file(cacheFile);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        file.write("XXXX");
+    }
+    QVERIFY(!DataSetCache::read(cacheFile, written.source, &read));
+
+    // 截断: 目录块超出文件末尾
+    QVERIFY(DataSetCache::write(cacheFile, written));
+    QVERIFY(QFile::resize(cacheFile, 4096));
+    QVERIFY(!DataSetCache::read(cacheFile, written.source, &read));
+}
+
+void TestDataSetCache::updateMetadata()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString source = writeSource(dir);
+    const QString cacheFile = DataSetCache::cacheFilePath(dir.path(), source);
+    const DataSetCache::Content written = sampleContent(source);
+    QVERIFY(DataSetCache::write(cacheFile, written));
+
+    // 先换成更长的列定义, 再换成更短的: 文件末尾不应残留旧内容
+    QJsonArray longer;
+    for (int i = 0; i < 50; ++i) longer.append(QJsonObject{ { "name", QString("列%1").arg(i) }, { "unit", "h" } });
+    const QJsonObject shorter{ { "columns", QJsonArray{ QJsonObject{ { "name", "时间" } } } } };
+    for (const QJsonObject& metadata : { QJsonObject{ { "columns", longer } }, shorter }) {
+        QString error;
+        QVERIFY2(DataSetCache::updateMetadata(cacheFile, metadata, &error), qPrintable(error));
+        DataSetCache::Content read;
+        QVERIFY2(DataSetCache::read(cacheFile, written.source, &read, &error), qPrintable(error));
+        QVERIFY(read.metadata == metadata);
+        compareColumns(read, written);
+    }
+}
+
+void TestDataSetCache::updateMetadataMissingFile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString cacheFile = dir.filePath("missing.wtdc");
+    QString error;
+    QVERIFY(!DataSetCache::updateMetadata(cacheFile, QJsonObject{ { "columns", QJsonArray() } }, &error));
+    QVERIFY(!error.isEmpty());
+    QVERIFY(!QFile::exists(cacheFile));
+
+    // 不是缓存文件时拒绝更新, 原内容不变
+    const QByteArray garbage("not a cache file, just some text that is longer than the preamble");
+    {
+        QFile file(cacheFile);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(garbage);
+    }
+    QVERIFY(!DataSetCache::updateMetadata(cacheFile, QJsonObject(), &error));
+    QFile file(cacheFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), garbage);
+}
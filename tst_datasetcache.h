@@ -0,0 +1,23 @@
+#ifndef TST_DATASETCACHE_H
+#define TST_DATASETCACHE_H
+
+#include <QObject>
+
+/**
+ * @brief DataSetCache 的写入 / 读取往返、失效判断与列定义更新
+ *
+ * 缓存文件放在临时目录中; 往返后各列数值逐位相同, 文本列的字符串池与下标不变。
+ */
+class TestDataSetCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void staleSource();
+    void corruptFile();
+    void updateMetadata();
+    void updateMetadataMissingFile();
+};
+
+#endif // TST_DATASETCACHE_H
@@ -0,0 +1,120 @@
+#include "tst_datatablemodel.h"
+#include "datatablemodel.h"
+#include "csvparser.h"
+
+#include <QtTest>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <memory>
+
+namespace {
+
+// 第 1、2 列含文本, 按映射列加载; 第 0、3 列为数值列
+const QByteArray kContent("t,note,remark,p\n"
+                          "1,a,x,10\n"
+                          "2,,y,11\n"
+                          "3,\"b,c\",z,12\n"
+                          "4,d,w,13\n");
+
+struct MappedFixture {
+    QTemporaryDir dir;
+    QSharedPointer<MappedTextFile> file;
+    DataTableModel model;
+
+    bool load()
+    {
+        const QString path = dir.filePath("mapped.csv");
+        QFile out(path);
+        if (!dir.isValid() || !out.open(QIODevice::WriteOnly) || out.write(kContent) != kContent.size()) return false;
+        out.close();
+        file.reset(new MappedTextFile);
+        if (!file->open(path, MappedTextFile::KeepEmptyLines)) return false;
+        CsvParser parser;
+        const CsvParser::Result parsed = parser.parse(*file, 1, 4, ",");
+        model.setMappedTable({ "t", "note", "remark", "p" }, parsed.columns, file, 1, ",", parsed.textFields);
+        return true;
+    }
+};
+
+} // namespace
+
+void TestDataTableModel::mappedText()
+{
+    MappedFixture f;
+    QVERIFY(f.load());
+    QVERIFY(f.model.isMapped());
+    QCOMPARE(f.model.rowCount(), 4);
+    QCOMPARE(f.model.columnCount(), 4);
+    QCOMPARE(f.model.sourceField(0), -1);
+    QCOMPARE(f.model.sourceField(1), 1);
+    QCOMPARE(f.model.sourceField(2), 2);
+    QCOMPARE(f.model.sourceField(3), -1);
+
+    // 映射列的文本取自源文件, 数值列照常格式化
+    QCOMPARE(f.model.text(0, 1), QString("a"));
+    QCOMPARE(f.model.text(2, 1), QString("b,c"));
+    QVERIFY(f.model.isEmpty(1, 1));
+    QCOMPARE(f.model.data(f.model.index(3, 2)).toString(), QString("w"));
+    QCOMPARE(f.model.text(2, 0), QString("3"));
+    QCOMPARE(f.model.value(1, 3), 11.0);
+    QVERIFY(f.model.isNumericColumn(0));
+    QVERIFY(!f.model.isNumericColumn(1));
+}
+
+void TestDataTableModel::editMaterializesColumn()
+{
+    MappedFixture f;
+    QVERIFY(f.load());
+    QSignalSpy changed(&f.model, &DataTableModel::dataChanged);
+
+    f.model.setText(1, 1, "新值");
+    QCOMPARE(changed.count(), 1);
+    // 只有被写入的列转为普通文本列, 其余行保留源文件中的文本
+    QCOMPARE(f.model.sourceField(1), -1);
+    QVERIFY(f.model.column(1).kind() == DataColumn::Text);
+    QCOMPARE(f.model.text(1, 1), QString("新值"));
+    QCOMPARE(f.model.text(0, 1), QString("a"));
+    QCOMPARE(f.model.text(2, 1), QString("b,c"));
+    QCOMPARE(f.model.sourceField(2), 2);
+    QVERIFY(f.model.isMapped());
+
+    // 最后一个映射列物化后释放源文件
+    QVERIFY(f.model.setData(f.model.index(0, 2), "y2"));
+    QVERIFY(!f.model.isMapped());
+    QVERIFY(f.model.source().isNull());
+    QCOMPARE(f.model.text(0, 2), QString("y2"));
+    QCOMPARE(f.model.text(3, 2), QString("w"));
+}
+
+void TestDataTableModel::insertRowsMaterializesAll()
+{
+    MappedFixture f;
+    QVERIFY(f.load());
+    QVERIFY(f.model.insertRows(1, 2));
+    QVERIFY(!f.model.isMapped());
+    QCOMPARE(f.model.rowCount(), 6);
+    QCOMPARE(f.model.sourceField(1), -1);
+    QCOMPARE(f.model.sourceField(2), -1);
+
+    // 插入行之后的行号不再对应源文件行, 文本须已随行移动
+    const QStringList note = { "a", "", "", "", "b,c", "d" };
+    const QStringList remark = { "x", "", "", "y", "z", "w" };
+    for (int row = 0; row < 6; ++row) {
+        QCOMPARE(f.model.text(row, 1), note[row]);
+        QCOMPARE(f.model.text(row, 2), remark[row]);
+    }
+    QCOMPARE(f.model.value(4, 3), 12.0);
+    QVERIFY(f.model.isEmpty(1, 0));
+}
+
+void TestDataTableModel::removeRowsMaterializesAll()
+{
+    MappedFixture f;
+    QVERIFY(f.load());
+    QVERIFY(f.model.removeRows(0, 2));
+    QVERIFY(!f.model.isMapped());
+    QCOMPARE(f.model.rowCount(), 2);
+    QCOMPARE(f.model.text(0, 1), QString("b,c"));
+    QCOMPARE(f.model.text(1, 2), QString("w"));
+    QCOMPARE(f.model.value(0, 0), 3.0);
+}
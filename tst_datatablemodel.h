@@ -0,0 +1,23 @@
+#ifndef TST_DATATABLEMODEL_H
+#define TST_DATATABLEMODEL_H
+
+#include <QObject>
+
+/**
+ * @brief DataTableModel 的大文件模式 (映射列)
+ *
+ * 映射列从源文件取字段显示; 写入时只物化该列, 增删行前物化全部列,
+ * 最后一个映射列物化后释放源文件。
+ */
+class TestDataTableModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void mappedText();
+    void editMaterializesColumn();
+    void insertRowsMaterializesAll();
+    void removeRowsMaterializesAll();
+};
+
+#endif // TST_DATATABLEMODEL_H
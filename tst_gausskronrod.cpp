@@ -0,0 +1,112 @@
+#include "tst_gausskronrod.h"
+#include "gausskronrod.h"
+
+#include <QtTest>
+#include <cmath>
+#include <complex>
+
+namespace {
+
+const double kSmoothTolerance = 1e-12;
+const double kSingularTolerance = 1e-9;
+
+// 在 1/3 处跳变的阶跃函数: 含跳变点的子区间误差估计始终不满足相对误差限, 一直细分到深度上限
+double step(double x) { return x < 1.0 / 3.0 ? 0.0 : 1.0; }
+
+} // namespace
+
+void TestGaussKronrod::smoothIntegrands()
+{
+    // int_0^1 x^k = 1/(k+1); 13 次以下 G7 与 K15 同样精确, 误差估计为零, 不细分
+    for (int k = 0; k <= 30; ++k) {
+        QuadratureStats stats;
+        const double value = GaussKronrod::integrate([k](double x) { return std::pow(x, k); }, 0.0, 1.0, 0.0, 1e-13, 30, &stats);
+        const double expected = 1.0 / (k + 1);
+        QVERIFY2(std::abs(value - expected) / expected < kSmoothTolerance, qPrintable(QString("x^%1: %2").arg(k).arg(value)));
+        if (k <= 13) QCOMPARE(stats.panels, 1);
+    }
+
+    const double e = GaussKronrod::integrate([](double x) { return std::exp(x); }, 0.0, 1.0, 0.0, 1e-13, 30);
+    QVERIFY2(std::abs(e - (M_E - 1.0)) / (M_E - 1.0) < kSmoothTolerance, qPrintable(QString("exp: %1").arg(e)));
+
+    const double s = GaussKronrod::integrate([](double x) { return std::sin(x); }, 0.0, M_PI, 0.0, 1e-13, 30);
+    QVERIFY2(std::abs(s - 2.0) / 2.0 < kSmoothTolerance, qPrintable(QString("sin: %1").arg(s)));
+
+    // 反向区间取相反数; 窄峰 1/(1e-4 + x^2) 需要多层细分
+    const double reversed = GaussKronrod::integrate([](double x) { return std::exp(x); }, 1.0, 0.0, 0.0, 1e-13, 30);
+    QVERIFY2(std::abs(reversed + (M_E - 1.0)) / (M_E - 1.0) < kSmoothTolerance, qPrintable(QString("反向: %1").arg(reversed)));
+    const double peak = GaussKronrod::integrate([](double x) { return 1.0 / (1e-4 + x * x); }, -1.0, 1.0, 0.0, 1e-13, 40);
+    const double peakExpected = 2.0 * std::atan(100.0) * 100.0;
+    QVERIFY2(std::abs(peak - peakExpected) / peakExpected < kSmoothTolerance, qPrintable(QString("窄峰: %1").arg(peak)));
+}
+
+void TestGaussKronrod::logSingularIntegrand()
+{
+    // 影响积分中 K0 在 u = offset/LfD 处的对数奇点: int_0^1 ln(x) = -1, int_{-1}^{1} ln|x| = -2
+    const double a = GaussKronrod::integrate([](double x) { return std::log(x); }, 0.0, 1.0, 1e-11, 0.0, 50);
+    QVERIFY2(std::abs(a + 1.0) < kSingularTolerance, qPrintable(QString("ln(x): %1").arg(a)));
+
+    const double b = GaussKronrod::integrate([](double x) { return std::log(std::abs(x)); }, -1.0, 1.0, 1e-11, 0.0, 50);
+    QVERIFY2(std::abs(b + 2.0) < kSingularTolerance, qPrintable(QString("ln|x|: %1").arg(b)));
+
+    // 奇点不在二分点上: int_0^1 ln|x - 1/3| = (2/3) ln(2/3) + (1/3) ln(1/3) - 1
+    const double c = GaussKronrod::integrate([](double x) { return std::log(std::abs(x - 1.0 / 3.0)); }, 0.0, 1.0, 1e-11, 0.0, 60);
+    const double cExpected = 2.0 / 3.0 * std::log(2.0 / 3.0) + 1.0 / 3.0 * std::log(1.0 / 3.0) - 1.0;
+    QVERIFY2(std::abs(c - cExpected) < kSingularTolerance, qPrintable(QString("ln|x-1/3|: %1").arg(c)));
+
+    const double d = GaussKronrod::integrate([](double x) { return 1.0 / std::sqrt(x); }, 0.0, 1.0, 1e-11, 0.0, 60);
+    QVERIFY2(std::abs(d - 2.0) < kSingularTolerance, qPrintable(QString("1/sqrt(x): %1").arg(d)));
+}
+
+void TestGaussKronrod::complexIntegrand()
+{
+    // 复反演路径的被积函数为复数: int_0^2 exp(i*w*x) = (exp(2iw) - 1) / (iw)
+    using C = std::complex<double>;
+    for (double w : { 0.5, 3.0, 20.0 }) {
+        const C value = GaussKronrod::integrate([w](double x) { return std::exp(C(0.0, w * x)); }, 0.0, 2.0, 0.0, 1e-13, 30);
+        const C expected = (std::exp(C(0.0, 2.0 * w)) - 1.0) / C(0.0, w);
+        QVERIFY2(std::abs(value - expected) / std::abs(expected) < kSmoothTolerance, qPrintable(QString("w = %1").arg(w)));
+    }
+}
+
+void TestGaussKronrod::batchMatchesScalar()
+{
+    auto f = [](double x) { return std::log(std::abs(x - 0.2)) + std::cos(5.0 * x); };
+    auto fBatch = [&f](const double* x, double* fx, int n) { for (int i = 0; i < n; ++i) fx[i] = f(x[i]); };
+
+    QuadratureStats scalarStats, batchStats;
+    const double scalar = GaussKronrod::integrate(f, -1.0, 1.0, 1e-8, 1e-10, 20, &scalarStats);
+    const double batch = GaussKronrod::integrateBatch(fBatch, -1.0, 1.0, 1e-8, 1e-10, 20, &batchStats);
+    QCOMPARE(batch, scalar);
+    QCOMPARE(batchStats.panels, scalarStats.panels);
+    QCOMPARE(batchStats.evaluations, 15 * batchStats.panels);
+}
+
+void TestGaussKronrod::depthLimit()
+{
+    // maxDepth = 0: 整个区间一次 K15, 即便误差估计不满足也直接接受
+    QuadratureStats stats;
+    GaussKronrod::integrate(step, 0.0, 1.0, 0.0, 1e-12, 0, &stats);
+    QCOMPARE(stats.panels, 1);
+    QCOMPARE(stats.evaluations, 15);
+
+    // 跳变点所在子区间每层细分一次, 其余子区间一次接受: 子区间数 = 2*maxDepth + 1
+    for (int depth : { 1, 5, 20, 40 }) {
+        QuadratureStats s;
+        const double value = GaussKronrod::integrate(step, 0.0, 1.0, 0.0, 1e-12, depth, &s);
+        QCOMPARE(s.panels, 2 * depth + 1);
+        QVERIFY2(std::abs(value - 2.0 / 3.0) < std::ldexp(1.0, -depth), qPrintable(QString("depth = %1: %2").arg(depth).arg(value)));
+    }
+}
+
+void TestGaussKronrod::depthClamp()
+{
+    // 超过 62 的 maxDepth 按 62 处理 (区间栈容量 64), 结果与 maxDepth = 62 完全相同
+    QuadratureStats at62, huge;
+    const double v62 = GaussKronrod::integrate(step, 0.0, 1.0, 0.0, 1e-12, 62, &at62);
+    const double vHuge = GaussKronrod::integrate(step, 0.0, 1.0, 0.0, 1e-12, 100000, &huge);
+    QCOMPARE(vHuge, v62);
+    QCOMPARE(huge.panels, at62.panels);
+    QVERIFY2(at62.panels <= 2 * 62 + 1, qPrintable(QString("子区间数 %1").arg(at62.panels)));
+    QVERIFY2(std::abs(v62 - 2.0 / 3.0) < 1e-15, qPrintable(QString("阶跃: %1").arg(v62)));
+}
@@ -0,0 +1,26 @@
+#ifndef TST_GAUSSKRONROD_H
+#define TST_GAUSSKRONROD_H
+
+#include <QObject>
+
+/**
+ * @brief GaussKronrod 自适应积分与解析值的对照
+ *
+ * 光滑被积函数 (多项式、exp、sin、复指数) 相对误差不超过 1e-12; 端点奇异的 ln(x)、1/sqrt(x)
+ * 绝对误差不超过 1e-9; 批量版本与标量版本逐位相同。
+ * 深度限制: maxDepth = 0 只求一个子区间, 超过 62 的深度按 62 截断, 间断点处的细分不会越过栈容量。
+ */
+class TestGaussKronrod : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void smoothIntegrands();
+    void logSingularIntegrand();
+    void complexIntegrand();
+    void batchMatchesScalar();
+    void depthLimit();
+    void depthClamp();
+};
+
+#endif // TST_GAUSSKRONROD_H
@@ -0,0 +1,101 @@
+#include "tst_laplaceinversion.h"
+#include "laplaceinversion.h"
+
+#include <QtTest>
+#include <cmath>
+#include <complex>
+
+namespace {
+
+using cd = std::complex<double>;
+
+struct Transform {
+    const char* name;
+    double (*real)(double);
+    cd (*complex)(cd);
+    double (*original)(double);
+    bool absolute;   // 原函数趋于零时以绝对误差计
+};
+
+const Transform kTransforms[] = {
+    { "1/s^2", [](double s) { return 1.0 / (s * s); }, [](cd s) { return 1.0 / (s * s); },
+      [](double t) { return t; }, false },
+    { "1/(s+1)", [](double s) { return 1.0 / (s + 1.0); }, [](cd s) { return 1.0 / (s + 1.0); },
+      [](double t) { return std::exp(-t); }, true },
+    { "1/sqrt(s)", [](double s) { return 1.0 / std::sqrt(s); }, [](cd s) { return 1.0 / std::sqrt(s); },
+      [](double t) { return 1.0 / std::sqrt(M_PI * t); }, false },
+};
+
+struct Case {
+    LaplaceInversionMethod method;
+    double fullTolerance;   // 默认阶数
+    double halfTolerance;   // 阶数减半
+};
+
+const Case kCases[] = {
+    { LaplaceInversionMethod::Stehfest, 2e-3, 1e-1 },
+    { LaplaceInversionMethod::Talbot, 2e-9, 1e-4 },
+    { LaplaceInversionMethod::DeHoog, 5e-9, 2e-3 },
+    { LaplaceInversionMethod::Euler, 1e-6, 1e-2 },
+};
+
+const double kTimes[] = { 0.01, 0.1, 1.0, 10.0, 100.0 };
+
+} // namespace
+
+void TestLaplaceInversion::knownTransforms()
+{
+    for (const Case& c : kCases) {
+        const int fullOrder = LaplaceInversion::defaultOrder(c.method);
+        // 与 CompositeModel 低精度模式相同的减半方式
+        const int halfOrder = LaplaceInversion::normalizeOrder(c.method, fullOrder / 2);
+        const int orders[] = { fullOrder, halfOrder };
+        const double tolerances[] = { c.fullTolerance, c.halfTolerance };
+
+        for (int o = 0; o < 2; ++o) {
+            for (const Transform& f : kTransforms) {
+                for (double t : kTimes) {
+                    const double value = LaplaceInversion::invert(c.method, orders[o], t, f.real, f.complex);
+                    const double expected = f.original(t);
+                    const double err = f.absolute ? std::abs(value - expected) : std::abs(value - expected) / std::abs(expected);
+                    QVERIFY2(err < tolerances[o],
+                             qPrintable(QString("%1 (阶数 %2), %3, t = %4: 误差 %5")
+                                        .arg(LaplaceInversion::methodName(c.method)).arg(orders[o]).arg(f.name).arg(t).arg(err)));
+                }
+            }
+        }
+    }
+}
+
+void TestLaplaceInversion::orderNormalization()
+{
+    // 超出范围的阶数截断到各算法的合法区间, Stehfest 取偶数
+    QCOMPARE(LaplaceInversion::normalizeOrder(LaplaceInversionMethod::Talbot, 1), 4);
+    QCOMPARE(LaplaceInversion::normalizeOrder(LaplaceInversionMethod::Talbot, 100), 32);
+    QCOMPARE(LaplaceInversion::normalizeOrder(LaplaceInversionMethod::DeHoog, 0), 2);
+    QCOMPARE(LaplaceInversion::normalizeOrder(LaplaceInversionMethod::DeHoog, 40), 16);
+    QCOMPARE(LaplaceInversion::normalizeOrder(LaplaceInversionMethod::Euler, 2), 4);
+    QCOMPARE(LaplaceInversion::normalizeOrder(LaplaceInversionMethod::Euler, 50), 20);
+    QCOMPARE(LaplaceInversion::normalizeOrder(LaplaceInversionMethod::Stehfest, 7), 4);
+    QCOMPARE(LaplaceInversion::normalizeOrder(LaplaceInversionMethod::Stehfest, 30), 20);
+
+    // 超出范围的阶数与截断后的阶数给出相同结果
+    const Transform& f = kTransforms[2];
+    QCOMPARE(LaplaceInversion::talbot(f.complex, 1.0, 100), LaplaceInversion::talbot(f.complex, 1.0, 32));
+    QCOMPARE(LaplaceInversion::euler(f.complex, 1.0, 50), LaplaceInversion::euler(f.complex, 1.0, 20));
+}
+
+void TestLaplaceInversion::evaluationCounts()
+{
+    // evaluationsPerPoint 与各算法实际调用 F 的次数一致
+    for (const Case& c : kCases) {
+        for (int order : { 4, LaplaceInversion::defaultOrder(c.method), 12 }) {
+            int calls = 0;
+            auto realF = [&calls](double s) { ++calls; return 1.0 / (s + 1.0); };
+            auto complexF = [&calls](cd s) { ++calls; return 1.0 / (s + 1.0); };
+            LaplaceInversion::invert(c.method, order, 1.0, realF, complexF);
+            QVERIFY2(calls == LaplaceInversion::evaluationsPerPoint(c.method, order),
+                     qPrintable(QString("%1 (阶数 %2): %3 次求值").arg(LaplaceInversion::methodName(c.method)).arg(order).arg(calls)));
+        }
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef TST_LAPLACEINVERSION_H
+#define TST_LAPLACEINVERSION_H
+
+#include <QObject>
+
+/**
+ * @brief LaplaceInversion 各算法与解析反演的对照
+ *
+ * 像函数 1/s^2 -> t, 1/(s+1) -> exp(-t), 1/sqrt(s) -> 1/sqrt(pi*t), t 取 0.01 .. 100。
+ * 每种算法取默认阶数与减半阶数 (拟合迭代时的低精度模式), 容差为实测最大误差放宽约 5 倍:
+ *   Stehfest 8 / 4: 2e-3 / 1e-1;  Talbot 16 / 8: 2e-9 / 1e-4;
+ *   de Hoog 8 / 4: 5e-9 / 2e-3;  Euler 11 / 5: 1e-6 / 1e-2。
+ * exp(-t) 在大 t 上趋于零, 以绝对误差计, 其余以相对误差计。
+ */
+class TestLaplaceInversion : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void knownTransforms();
+    void orderNormalization();
+    void evaluationCounts();
+};
+
+#endif // TST_LAPLACEINVERSION_H
@@ -0,0 +1,52 @@
+/*
+ * welltest_tests 入口: 依次运行各测试类, 任一失败时返回非零
+ * 运行单个测试类: welltest_tests <类名> [QTest 参数]
+ */
+
+#include <QCoreApplication>
+#include <QtTest>
+#include <memory>
+#include <vector>
+
+#include "tst_besselkernel.h"
+#include "tst_columnstatistics.h"
+#include "tst_datacolumn.h"
+#include "tst_csvparser.h"
+#include "tst_datasetcache.h"
+#include "tst_datatablemodel.h"
+#include "tst_mappedtextfile.h"
+#include "tst_compositekernel.h"
+#include "tst_gausskronrod.h"
+#include "tst_laplaceinversion.h"
+#include "tst_compositemodel.h"
+#include "tst_columnstatisticscache.h"
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    std::vector<std::unique_ptr<QObject>> tests;
+    tests.emplace_back(new TestBesselKernel);
+    tests.emplace_back(new TestColumnStatistics);
+    tests.emplace_back(new TestDataColumn);
+    tests.emplace_back(new TestCsvParser);
+    tests.emplace_back(new TestDataSetCache);
+    tests.emplace_back(new TestDataTableModel);
+    tests.emplace_back(new TestMappedTextFile);
+    tests.emplace_back(new TestCompositeKernel);
+    tests.emplace_back(new TestGaussKronrod);
+    tests.emplace_back(new TestLaplaceInversion);
+    tests.emplace_back(new TestCompositeModel);
+    tests.emplace_back(new TestColumnStatisticsCache);
+
+    QStringList args = app.arguments();
+    QString only;
+    if (args.size() > 1 && !args.at(1).startsWith('-')) only = args.takeAt(1);
+
+    int failed = 0;
+    for (const auto& test : tests) {
+        if (!only.isEmpty() && only != test->metaObject()->className()) continue;
+        failed += QTest::qExec(test.get(), args) != 0;
+    }
+    return failed;
+}
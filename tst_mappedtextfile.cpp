@@ -0,0 +1,124 @@
+#include "tst_mappedtextfile.h"
+#include "mappedtextfile.h"
+
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QThread>
+#include <random>
+
+namespace {
+
+// 按换行符直接拆分的参考结果: 去掉行尾 '\r', SkipEmptyLines 时去掉只含空白的行
+QList<QByteArray> referenceLines(const QByteArray& content, MappedTextFile::LineMode mode)
+{
+    QByteArray text = content.startsWith("\xEF\xBB\xBF") ? content.mid(3) : content;
+    QList<QByteArray> lines = text.split('\n');
+    if (text.endsWith('\n') || text.isEmpty()) lines.removeLast();
+    QList<QByteArray> result;
+    for (QByteArray line : lines) {
+        if (line.endsWith('\r')) line.chop(1);
+        if (mode == MappedTextFile::SkipEmptyLines && line.trimmed().isEmpty()) continue;
+        result.append(line);
+    }
+    return result;
+}
+
+QString writeFile(const QTemporaryDir& dir, const QString& name, const QByteArray& content)
+{
+    const QString path = dir.filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size()) return QString();
+    return path;
+}
+
+void compareLines(const MappedTextFile& file, const QList<QByteArray>& expected)
+{
+    QCOMPARE(file.lineCount(), expected.size());
+    for (int i = 0; i < expected.size(); ++i) {
+        if (file.line(i) != expected[i]) {
+            QFAIL(qPrintable(QString("第 %1 行不一致: %2").arg(i).arg(QString::fromUtf8(file.line(i).left(40)))));
+        }
+    }
+}
+
+} // namespace
+
+void TestMappedTextFile::smallFile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QByteArray content("\xEF\xBB\xBFtime,p\r\n1,2\r\n\r\n  \n3,4");
+    const QString path = writeFile(dir, "small.csv", content);
+    QVERIFY(!path.isEmpty());
+
+    MappedTextFile file;
+    QVERIFY(file.open(path, MappedTextFile::KeepEmptyLines));
+    compareLines(file, referenceLines(content, MappedTextFile::KeepEmptyLines));
+    QCOMPARE(file.line(0), QByteArray("time,p"));
+    QVERIFY(file.line(-1).isEmpty());
+    QVERIFY(file.line(file.lineCount()).isEmpty());
+
+    QVERIFY(file.open(path, MappedTextFile::SkipEmptyLines));
+    compareLines(file, referenceLines(content, MappedTextFile::SkipEmptyLines));
+    QCOMPARE(file.lineCount(), 3);
+
+    // 空文件为零行
+    const QString empty = writeFile(dir, "empty.csv", QByteArray());
+    QVERIFY(file.open(empty, MappedTextFile::KeepEmptyLines));
+    QCOMPARE(file.lineCount(), 0);
+}
+
+void TestMappedTextFile::parallelIndex_data()
+{
+    QTest::addColumn<int>("mode");
+    QTest::newRow("KeepEmptyLines") << int(MappedTextFile::KeepEmptyLines);
+    QTest::newRow("SkipEmptyLines") << int(MappedTextFile::SkipEmptyLines);
+}
+
+void TestMappedTextFile::parallelIndex()
+{
+    if (QThread::idealThreadCount() <= 1) QSKIP("单核机器上不走并行建索引");
+    QFETCH(int, mode);
+    const MappedTextFile::LineMode lineMode = MappedTextFile::LineMode(mode);
+
+    // 约 24 MB: 长短不一的行 (含空行、空白行与 CRLF), 末行没有换行符;
+    // 中间一行 13 MB, 四线程及以上时有整块落在这一行内部 (块内没有行首)
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> length(0, 120);
+    QByteArray content;
+    content.reserve(26 * 1024 * 1024);
+    auto appendLines = [&](qint64 bytes) {
+        const qint64 target = content.size() + bytes;
+        for (int i = 0; content.size() < target; ++i) {
+            const int n = length(rng);
+            if (n < 5) content += n % 2 ? "\n" : " \t\r\n";
+            else content += QByteArray::number(i) + ',' + QByteArray(n, char('a' + n % 26)) + (i % 3 ? "\n" : "\r\n");
+        }
+    };
+    appendLines(5 * 1024 * 1024);
+    content += QByteArray(13 * 1024 * 1024, 'x') + '\n';
+    appendLines(6 * 1024 * 1024);
+    content += "last,line";
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = writeFile(dir, "large.csv", content);
+    QVERIFY(!path.isEmpty());
+
+    MappedTextFile file;
+    QVERIFY(file.open(path, lineMode));
+    compareLines(file, referenceLines(content, lineMode));
+    QCOMPARE(file.line(file.lineCount() - 1), QByteArray("last,line"));
+}
+
+void TestMappedTextFile::fieldSplitting()
+{
+    const QByteArray line("1, \"a,b\" ,,x\"y\"z");
+    QCOMPARE(MappedTextFile::field(line, ",", 0), QByteArray("1"));
+    QCOMPARE(MappedTextFile::field(line, ",", 1), QByteArray("a,b"));
+    QCOMPARE(MappedTextFile::field(line, ",", 2), QByteArray());
+    QCOMPARE(MappedTextFile::field(line, ",", 3), QByteArray("xyz"));
+    QVERIFY(MappedTextFile::field(line, ",", 4).isEmpty());
+    QVERIFY(MappedTextFile::field(line, ",", -1).isEmpty());
+    QCOMPARE(MappedTextFile::splitLine("a\t\tb", "\t").size(), 3);
+}
@@ -0,0 +1,23 @@
+#ifndef TST_MAPPEDTEXTFILE_H
+#define TST_MAPPEDTEXTFILE_H
+
+#include <QObject>
+
+/**
+ * @brief MappedTextFile 的行索引与逐行读取
+ *
+ * 超过并行阈值 (16 MB) 的文件按字节切块建立索引, 结果须与按换行符直接拆分的行逐行相同,
+ * 包括跨块的行、恰好从块边界开始的行和比一整块还长的行。
+ */
+class TestMappedTextFile : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void smallFile();
+    void parallelIndex_data();
+    void parallelIndex();
+    void fieldSplitting();
+};
+
+#endif // TST_MAPPEDTEXTFILE_H
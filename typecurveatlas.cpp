@@ -0,0 +1,523 @@
+#include "typecurveatlas.h"
+#include "datadecimation.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <numeric>
+
+namespace {
+
+const char kMagic[8] = { 'W', 'T', 'A', 'T', 'L', 'A', 'S', '\0' };
+const quint32 kByteOrderMark = 0x01020304u;
+const quint32 kVersion = 1;
+
+// 文件头 (本机字节序), 其后依次为各维度的 AxisHeader + 节点值 (double)、各节点的 float 序列
+struct FileHeader {
+    char magic[8];
+    quint32 byteOrder;
+    quint32 version;
+    qint32 modelType;
+    qint32 axisCount;
+    qint32 timeCount;
+    qint32 nf;
+    qint64 nodeCount;
+    double logTD0;
+    double logTDStep;
+    double m12;
+    double lfD;
+};
+
+struct AxisHeader {
+    qint32 id;
+    qint32 count;
+    qint32 logScale;
+    qint32 reserved;
+};
+
+// 对数等距时间节点上的序列按 log10 tD 线性插值; 超出范围返回 NaN
+template <typename T>
+double sampleUniform(const T* series, int count, double x0, double dx, double x)
+{
+    double u = (x - x0) / dx;
+    if (!(u >= 0.0) || u > count - 1) return std::numeric_limits<double>::quiet_NaN();
+    int i = std::min((int)u, count - 2);
+    double f = u - i;
+    return series[i] + f * (series[i + 1] - series[i]);
+}
+
+// 压敏效应的摄动换算 (与 CompositeModel 一致): pD -> -ln(1 - γ pD)/γ, pD' 按链式法则除以 (1 - γ pD)
+void applyGamma(double gamaD, double& pD, double& deriv)
+{
+    if (std::abs(gamaD) <= 1e-9) return;
+    double arg = 1.0 - gamaD * pD;
+    if (arg > 1e-12) {
+        pD = -1.0 / gamaD * std::log(arg);
+        deriv /= arg;
+    }
+}
+
+double timeScale(const CompositeParameters& p)
+{
+    using P = CompositeParameters;
+    return 14.4 * p[P::Kf] / (p[P::Phi] * p[P::Mu] * p[P::Ct] * std::pow(p[P::L], 2));
+}
+
+double pressureFactor(const CompositeParameters& p)
+{
+    using P = CompositeParameters;
+    return 1.842e-3 * p[P::Q] * p[P::Mu] * p[P::B] / (p[P::Kf] * p[P::H]);
+}
+
+bool fail(QString* error, const QString& message)
+{
+    if (error) *error = message;
+    return false;
+}
+
+TypeCurveAtlas::Axis makeAxis(CompositeParameters::Id id, double lo, double hi, int n)
+{
+    TypeCurveAtlas::Axis a;
+    a.id = id;
+    a.logScale = true;
+    for (int i = 0; i < n; ++i) a.values.append(std::pow(10.0, std::log10(lo) + (std::log10(hi) - std::log10(lo)) * i / (n - 1)));
+    return a;
+}
+
+TypeCurveAtlas::Axis fixedAxis(CompositeParameters::Id id, double v)
+{
+    TypeCurveAtlas::Axis a;
+    a.id = id;
+    a.logScale = false;
+    a.values = { v };
+    return a;
+}
+
+} // namespace
+
+TypeCurveAtlas::~TypeCurveAtlas()
+{
+    close();
+}
+
+CompositeParameters TypeCurveAtlas::defaultBase()
+{
+    using P = CompositeParameters;
+    P p;
+    p[P::Kf] = 1e-3;
+    p[P::Km] = 1e-4;
+    p[P::L] = 1000.0;
+    p[P::Lf] = 100.0;
+    p[P::Nf] = 4;
+    p[P::RmD] = 4.0;
+    p[P::Omega1] = 0.4;
+    p[P::Omega2] = 0.08;
+    p[P::Lambda1] = 1e-3;
+    p[P::N] = 8;
+    p.syncDerived();
+    return p;
+}
+
+TypeCurveAtlas::Spec TypeCurveAtlas::defaultSpec(CompositeModel::ModelType type, const CompositeParameters& base)
+{
+    using P = CompositeParameters;
+    Spec s;
+    s.type = type;
+    s.base = base;
+    QVector<P::Id> schema = CompositeModel::parameterSchema(type);
+    s.axes << makeAxis(P::Omega1, 0.05, 0.8, 3)
+           << makeAxis(P::Omega2, 0.01, 0.5, 3)
+           << makeAxis(P::Lambda1, 1e-5, 1e-1, 4)
+           << makeAxis(P::RmD, 1.5, 12.0, 3);
+    // 外边界半径取在复合半径网格之外
+    s.axes << (schema.contains(P::ReD) ? makeAxis(P::ReD, 25.0, 400.0, 3) : fixedAxis(P::ReD, 0.0));
+    if (schema.contains(P::CD)) {
+        Axis skin;
+        skin.id = P::S;
+        skin.logScale = false;
+        skin.values = { 0.0, 1.0, 3.0, 6.0 };
+        s.axes << makeAxis(P::CD, 1e-4, 1.0, 4) << skin;
+    } else {
+        s.axes << fixedAxis(P::CD, 0.0) << fixedAxis(P::S, 0.0);
+    }
+    return s;
+}
+
+bool TypeCurveAtlas::build(const Spec& spec, const QString& fileName, QString* error,
+                           const CancellationToken* cancel, const std::function<void(int, int)>& progress)
+{
+    using P = CompositeParameters;
+    P base = spec.base;
+    base.syncDerived();
+    base[P::GamaD] = 0.0;
+    if (base[P::Km] <= 0.0 || base[P::Kf] <= 0.0) return fail(error, "基准参数的 kf / km 必须为正");
+    int timeCount = (int)std::lround((spec.logTDMax - spec.logTDMin) * spec.pointsPerDecade) + 1;
+    if (spec.pointsPerDecade <= 0 || timeCount < 3) return fail(error, "tD 范围无效");
+    if (spec.axes.isEmpty()) return fail(error, "图版没有网格维度");
+
+    qint64 nodeCount = 1;
+    QVector<qint64> strides(spec.axes.size());
+    for (int a = spec.axes.size() - 1; a >= 0; --a) {
+        if (spec.axes[a].values.isEmpty()) return fail(error, QString("维度 %1 没有节点").arg(P::keyOf(spec.axes[a].id)));
+        strides[a] = nodeCount;
+        nodeCount *= spec.axes[a].values.size();
+    }
+    if (nodeCount > std::numeric_limits<int>::max() / 2) return fail(error, "网格节点过多");
+
+    // 以基准参数的换算系数反推有因次时间, 曲线除以压力换算系数即为 pD (网格维度不影响换算)
+    double dx = 1.0 / spec.pointsPerDecade;
+    double tScale = timeScale(base);
+    double pFactor = pressureFactor(base);
+    QVector<double> t(timeCount);
+    for (int j = 0; j < timeCount; ++j) t[j] = std::pow(10.0, spec.logTDMin + j * dx) / tScale;
+
+    CompositeModel model(spec.type);
+    model.setEvaluationCacheEnabled(false);
+    ModelEvaluationOptions options = model.evaluationOptions();
+    options.highPrecision = true;
+    options.parallel = false;
+    options.cancel = cancel;
+
+    std::vector<float> data((size_t)nodeCount * 2 * timeCount);
+    std::atomic<int> done(0);
+    auto evaluateNode = [&](int node) {
+        if (cancel && cancel->isCancelled()) return;
+        P p = base;
+        for (int a = 0; a < spec.axes.size(); ++a) {
+            const Axis& ax = spec.axes[a];
+            p[ax.id] = ax.values[(node / strides[a]) % ax.values.size()];
+        }
+        ModelCurveData c = model.calculateTheoreticalCurve(p, t, options);
+        float* out = data.data() + (size_t)node * 2 * timeCount;
+        const QVector<double>& pd = std::get<1>(c);
+        const QVector<double>& dd = std::get<2>(c);
+        for (int j = 0; j < timeCount; ++j) {
+            out[j] = (float)std::log10(std::max(j < pd.size() ? pd[j] / pFactor : 0.0, 1e-30));
+            out[timeCount + j] = (float)std::log10(std::max(j < dd.size() ? dd[j] / pFactor : 0.0, 1e-30));
+        }
+        int n = ++done;
+        if (progress) progress(n, (int)nodeCount);
+    };
+    QVector<int> nodes((int)nodeCount);
+    std::iota(nodes.begin(), nodes.end(), 0);
+    QtConcurrent::blockingMap(nodes, evaluateNode);
+    if (cancel && cancel->isCancelled()) return fail(error, "图版生成已取消");
+
+    FileHeader h;
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.byteOrder = kByteOrderMark;
+    h.version = kVersion;
+    h.modelType = spec.type;
+    h.axisCount = spec.axes.size();
+    h.timeCount = timeCount;
+    h.nf = base.fractureCount();
+    h.nodeCount = nodeCount;
+    h.logTD0 = spec.logTDMin;
+    h.logTDStep = dx;
+    h.m12 = base[P::Kf] / base[P::Km];
+    h.lfD = base[P::LfD];
+
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) return fail(error, QString("无法写入: %1").arg(fileName));
+    file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    for (const Axis& ax : spec.axes) {
+        AxisHeader ah = { (qint32)ax.id, (qint32)ax.values.size(), ax.logScale ? 1 : 0, 0 };
+        file.write(reinterpret_cast<const char*>(&ah), sizeof(ah));
+        file.write(reinterpret_cast<const char*>(ax.values.constData()), ax.values.size() * sizeof(double));
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), (qint64)(data.size() * sizeof(float)));
+    if (!file.commit()) return fail(error, QString("无法写入: %1").arg(fileName));
+    return true;
+}
+
+QString TypeCurveAtlas::defaultFileName(CompositeModel::ModelType type)
+{
+    return QDir(QCoreApplication::applicationDirPath()).filePath(QString("atlas/model%1.wta").arg(type + 1));
+}
+
+std::shared_ptr<const TypeCurveAtlas> TypeCurveAtlas::shared(CompositeModel::ModelType type)
+{
+    static QMutex mutex;
+    static std::map<int, std::shared_ptr<const TypeCurveAtlas>> loaded;
+    QMutexLocker locker(&mutex);
+    auto it = loaded.find(type);
+    if (it != loaded.end()) return it->second;
+    // 只缓存打开成功的图版: 之后生成的文件在下次调用时即可使用
+    QString fileName = defaultFileName(type);
+    if (!QFileInfo::exists(fileName)) return nullptr;
+    auto atlas = std::make_shared<TypeCurveAtlas>();
+    if (!atlas->open(fileName) || atlas->modelType() != type) return nullptr;
+    loaded[type] = atlas;
+    return atlas;
+}
+
+bool TypeCurveAtlas::open(const QString& fileName, QString* error)
+{
+    close();
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadOnly)) return fail(error, QString("无法打开: %1").arg(fileName));
+    qint64 size = m_file.size();
+    if (size < (qint64)sizeof(FileHeader)) { close(); return fail(error, "图版文件不完整"); }
+    m_map = m_file.map(0, size);
+    if (!m_map) { close(); return fail(error, "图版文件映射失败"); }
+
+    FileHeader h;
+    std::memcpy(&h, m_map, sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.byteOrder != kByteOrderMark || h.version != kVersion
+        || h.modelType < CompositeModel::Model_1 || h.modelType > CompositeModel::Model_6
+        || h.axisCount <= 0 || h.timeCount < 3 || h.nodeCount <= 0 || !(h.logTDStep > 0.0)) {
+        close();
+        return fail(error, "不是有效的图版文件 (或字节序 / 版本不符)");
+    }
+
+    qint64 offset = sizeof(FileHeader);
+    qint64 nodes = 1;
+    for (int a = 0; a < h.axisCount; ++a) {
+        AxisHeader ah;
+        if (offset + (qint64)sizeof(ah) > size) { close(); return fail(error, "图版文件不完整"); }
+        std::memcpy(&ah, m_map + offset, sizeof(ah));
+        offset += sizeof(ah);
+        if (ah.count <= 0 || ah.id < 0 || ah.id >= CompositeParameters::Count || offset + ah.count * (qint64)sizeof(double) > size) {
+            close();
+            return fail(error, "图版文件不完整");
+        }
+        Axis ax;
+        ax.id = (CompositeParameters::Id)ah.id;
+        ax.logScale = ah.logScale != 0;
+        ax.values.resize(ah.count);
+        std::memcpy(ax.values.data(), m_map + offset, ah.count * sizeof(double));
+        offset += ah.count * sizeof(double);
+        nodes *= ah.count;
+        m_axes.append(ax);
+    }
+    if (nodes != h.nodeCount || offset + nodes * 2 * h.timeCount * (qint64)sizeof(float) != size) {
+        close();
+        return fail(error, "图版文件大小与网格不符");
+    }
+
+    m_strides.resize(m_axes.size());
+    qint64 stride = 1;
+    for (int a = m_axes.size() - 1; a >= 0; --a) { m_strides[a] = stride; stride *= m_axes[a].values.size(); }
+    m_type = (CompositeModel::ModelType)h.modelType;
+    m_nodeCount = h.nodeCount;
+    m_timeCount = h.timeCount;
+    m_logTD0 = h.logTD0;
+    m_logTDStep = h.logTDStep;
+    m_m12 = h.m12;
+    m_lfD = h.lfD;
+    m_nf = h.nf;
+    m_data = reinterpret_cast<const float*>(m_map + offset);
+    return true;
+}
+
+void TypeCurveAtlas::close()
+{
+    if (m_map) m_file.unmap(m_map);
+    if (m_file.isOpen()) m_file.close();
+    m_map = nullptr;
+    m_data = nullptr;
+    m_axes.clear();
+    m_strides.clear();
+    m_nodeCount = 0;
+}
+
+double TypeCurveAtlas::coordinate(const Axis& a, double v)
+{
+    return a.logScale ? std::log10(std::max(v, 1e-300)) : v;
+}
+
+bool TypeCurveAtlas::covers(const CompositeParameters& p) const
+{
+    using P = CompositeParameters;
+    if (!isOpen() || p[P::Km] <= 0.0) return false;
+    auto near = [](double a, double b) { return std::abs(a - b) <= 1e-3 * std::max(std::abs(a), std::abs(b)); };
+    P q = p;
+    q.syncDerived();
+    return near(q[P::Kf] / q[P::Km], m_m12) && near(q[P::LfD], m_lfD) && q.fractureCount() == m_nf;
+}
+
+void TypeCurveAtlas::interpolateLog(const CompositeParameters& p, QVector<double>& logPD, QVector<double>& logDeriv) const
+{
+    int na = m_axes.size();
+    QVector<int> lo(na, 0);
+    QVector<double> frac(na, 0.0);
+    QVector<int> active;
+    for (int a = 0; a < na; ++a) {
+        const Axis& ax = m_axes[a];
+        int n = ax.values.size();
+        if (n == 1) continue;
+        double x = coordinate(ax, p[ax.id]);
+        int i = 0;
+        while (i < n - 2 && coordinate(ax, ax.values[i + 1]) <= x) ++i;
+        double x0 = coordinate(ax, ax.values[i]);
+        double x1 = coordinate(ax, ax.values[i + 1]);
+        // 网格外按边界截断
+        lo[a] = i;
+        frac[a] = std::clamp((x - x0) / (x1 - x0), 0.0, 1.0);
+        if (frac[a] > 0.0) active.append(a);
+    }
+
+    logPD.fill(0.0, m_timeCount);
+    logDeriv.fill(0.0, m_timeCount);
+    qint64 baseNode = 0;
+    for (int a = 0; a < na; ++a) baseNode += lo[a] * m_strides[a];
+    // 2^k 个角点加权 (k 为落在网格内部的维度数)
+    for (int c = 0; c < (1 << active.size()); ++c) {
+        double w = 1.0;
+        qint64 node = baseNode;
+        for (int k = 0; k < active.size(); ++k) {
+            int a = active[k];
+            if (c & (1 << k)) { w *= frac[a]; node += m_strides[a]; }
+            else w *= 1.0 - frac[a];
+        }
+        if (w == 0.0) continue;
+        const float* s = nodeSeries(node);
+        for (int j = 0; j < m_timeCount; ++j) {
+            logPD[j] += w * s[j];
+            logDeriv[j] += w * s[m_timeCount + j];
+        }
+    }
+}
+
+ModelCurveData TypeCurveAtlas::curve(const CompositeParameters& p, const QVector<double>& t) const
+{
+    using P = CompositeParameters;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    QVector<double> outP(t.size(), nan), outD(t.size(), nan);
+    if (!isOpen()) return std::make_tuple(t, outP, outD);
+
+    QVector<double> logPD, logDeriv;
+    interpolateLog(p, logPD, logDeriv);
+    double tScale = timeScale(p);
+    double factor = pressureFactor(p);
+    double gamaD = p[P::GamaD];
+    for (int i = 0; i < t.size(); ++i) {
+        if (t[i] <= 0.0) continue;
+        double x = std::log10(tScale * t[i]);
+        double lp = sampleUniform(logPD.constData(), m_timeCount, m_logTD0, m_logTDStep, x);
+        double ld = sampleUniform(logDeriv.constData(), m_timeCount, m_logTD0, m_logTDStep, x);
+        if (std::isnan(lp) || std::isnan(ld)) continue;
+        double pD = std::pow(10.0, lp), deriv = std::pow(10.0, ld);
+        applyGamma(gamaD, pD, deriv);
+        outP[i] = factor * pD;
+        outD[i] = factor * deriv;
+    }
+    return std::make_tuple(t, outP, outD);
+}
+
+QVector<TypeCurveAtlas::Match> TypeCurveAtlas::bestMatches(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d, double weight,
+                                                            const CompositeParameters& current, const QVector<CompositeParameters::Id>& freeIds, int count) const
+{
+    using P = CompositeParameters;
+    QVector<Match> out;
+    if (!isOpen() || t.isEmpty() || count <= 0) return out;
+
+    // 观测按对数均匀抽稀 (每十倍 10 点): 匹配只需覆盖曲线形状
+    struct Obs { double x0, lp, ld; bool hasP, hasD; };
+    QVector<Obs> obs;
+    double logScale0 = std::log10(timeScale(current));
+    double logFactor0 = std::log10(pressureFactor(current));
+    for (int i : DataDecimation::logUniformIndices(t, 10)) {
+        Obs o;
+        o.x0 = std::log10(t[i]) + logScale0;
+        o.hasP = i < p.size() && p[i] > 1e-10;
+        o.hasD = i < d.size() && d[i] > 1e-10;
+        o.lp = o.hasP ? std::log10(p[i]) : 0.0;
+        o.ld = o.hasD ? std::log10(d[i]) : 0.0;
+        if (o.hasP || o.hasD) obs.append(o);
+    }
+    if (obs.isEmpty()) return out;
+
+    // 未被拟合的维度固定在最接近当前值的节点
+    int na = m_axes.size();
+    QVector<QVector<int>> choices(na);
+    for (int a = 0; a < na; ++a) {
+        const Axis& ax = m_axes[a];
+        if (freeIds.contains(ax.id)) {
+            for (int i = 0; i < ax.values.size(); ++i) choices[a].append(i);
+        } else {
+            double x = coordinate(ax, current[ax.id]);
+            int nearest = 0;
+            for (int i = 1; i < ax.values.size(); ++i)
+                if (std::abs(coordinate(ax, ax.values[i]) - x) < std::abs(coordinate(ax, ax.values[nearest]) - x)) nearest = i;
+            choices[a].append(nearest);
+        }
+    }
+    QVector<double> shifts = { 0.0 };
+    if (freeIds.contains(P::Kf) && freeIds.contains(P::Km)) {
+        shifts.clear();
+        for (int k = -40; k <= 40; ++k) shifts.append(0.05 * k);
+    }
+
+    const double ln10 = std::log(10.0);
+    const double gamaD = current[P::GamaD];
+    const double wp = weight, wd = 1.0 - weight;
+    struct Scored { qint64 node; double shift; double mse; };
+    QVector<Scored> scored;
+    QVector<int> pos(na, 0);
+    for (;;) {
+        qint64 node = 0;
+        for (int a = 0; a < na; ++a) node += choices[a][pos[a]] * m_strides[a];
+        const float* s = nodeSeries(node);
+        Scored best = { node, 0.0, std::numeric_limits<double>::infinity() };
+        for (double sh : shifts) {
+            // kf 乘以 10^sh: tD 右移 sh, 压力换算系数除以 10^sh
+            double sse = 0.0;
+            int terms = 0, inRange = 0;
+            for (const Obs& o : obs) {
+                double x = o.x0 + sh;
+                double lp = sampleUniform(s, m_timeCount, m_logTD0, m_logTDStep, x);
+                double ld = sampleUniform(s + m_timeCount, m_timeCount, m_logTD0, m_logTDStep, x);
+                if (std::isnan(lp) || std::isnan(ld)) continue;
+                if (std::abs(gamaD) > 1e-9) {
+                    double pD = std::pow(10.0, lp), deriv = std::pow(10.0, ld);
+                    applyGamma(gamaD, pD, deriv);
+                    lp = std::log10(std::max(pD, 1e-30));
+                    ld = std::log10(std::max(deriv, 1e-30));
+                }
+                ++inRange;
+                if (o.hasP) { double r = (o.lp - (logFactor0 - sh + lp)) * ln10 * wp; sse += r * r; ++terms; }
+                if (o.hasD) { double r = (o.ld - (logFactor0 - sh + ld)) * ln10 * wd; sse += r * r; ++terms; }
+            }
+            // 大部分观测落在图版时间范围之外时不参与比较
+            if (inRange * 2 < obs.size() || terms == 0) continue;
+            double mse = sse / terms;
+            if (mse < best.mse) { best.shift = sh; best.mse = mse; }
+        }
+        if (std::isfinite(best.mse)) scored.append(best);
+
+        int a = na - 1;
+        while (a >= 0 && ++pos[a] == choices[a].size()) { pos[a] = 0; --a; }
+        if (a < 0) break;
+    }
+
+    int n = std::min(count, (int)scored.size());
+    std::partial_sort(scored.begin(), scored.begin() + n, scored.end(), [](const Scored& x, const Scored& y) { return x.mse < y.mse; });
+    for (int k = 0; k < n; ++k) {
+        Match m;
+        m.params = current;
+        for (int a = 0; a < na; ++a) {
+            const Axis& ax = m_axes[a];
+            if (ax.values.size() > 1) m.params[ax.id] = ax.values[(scored[k].node / m_strides[a]) % ax.values.size()];
+        }
+        if (scored[k].shift != 0.0) {
+            double f = std::pow(10.0, scored[k].shift);
+            m.params[P::Kf] *= f;
+            m.params[P::Km] *= f;
+        }
+        m.params.syncDerived();
+        m.mse = scored[k].mse;
+        out.append(m);
+    }
+    return out;
+}
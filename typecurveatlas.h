@@ -0,0 +1,117 @@
+#ifndef TYPECURVEATLAS_H
+#define TYPECURVEATLAS_H
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <functional>
+#include <memory>
+#include "compositemodel.h"
+
+/**
+ * @brief 无因次图版 (type-curve atlas): 预先计算的 pD / pD' 表及其插值查询
+ *
+ * 每种模型一个二进制文件: 在 (omega1, omega2, lambda1, rmD, reD, cD, S) 网格的每个节点上,
+ * 按对数等距的 tD 存放 log10 pD 与 log10 pD' (float)。模型未使用的维度 (无限大模型的 reD、
+ * 恒定井储模型的 cD / S) 只有一个节点。M12 = kf/km、LfD、nf 不进入网格, 为图版的固定值,
+ * 查询时须一致。压敏系数 gamaD 不进入网格: 表中为 gamaD = 0 的解, 查询时按摄动式换算。
+ *
+ * 文件以 QFile::map 映射, 打开后只读, 可在多个线程中同时查询; 网格内多线性插值
+ * (网格坐标与 CompositeModel 拟合一致: 对数参数取 log10, S 为线性), 单条曲线为微秒量级。
+ * 文件为本机字节序, 头部的字节序标记不符时拒绝打开。
+ */
+class TypeCurveAtlas
+{
+public:
+    struct Axis {
+        CompositeParameters::Id id = CompositeParameters::Invalid;
+        QVector<double> values;   // 升序
+        bool logScale = true;     // 插值坐标取 log10
+    };
+
+    struct Spec {
+        CompositeModel::ModelType type = CompositeModel::Model_1;
+        CompositeParameters base;  // 固定无因次组 (M12, LfD, nf) 与反演阶数取自此处
+        QVector<Axis> axes;
+        double logTDMin = -7.0;
+        double logTDMax = 4.0;
+        int pointsPerDecade = 10;
+    };
+
+    // 网格最优节点 (含时间 / 压力平移后的 kf, km)
+    struct Match {
+        CompositeParameters params;
+        double mse = 0.0;
+    };
+
+    TypeCurveAtlas() = default;
+    ~TypeCurveAtlas();
+    TypeCurveAtlas(const TypeCurveAtlas&) = delete;
+    TypeCurveAtlas& operator=(const TypeCurveAtlas&) = delete;
+
+    // ---- 生成 (离线) ----
+
+    // 与 ModelManager 默认参数一致的基准参数
+    static CompositeParameters defaultBase();
+    // 默认网格: 各维 3~4 个节点, 模型未使用的维度只保留一个节点
+    static Spec defaultSpec(CompositeModel::ModelType type, const CompositeParameters& base);
+    // 各节点在线程池中并行求值 (节点内串行), 结果写入 fileName; 取消或失败时返回 false
+    static bool build(const Spec& spec, const QString& fileName, QString* error = nullptr,
+                      const CancellationToken* cancel = nullptr,
+                      const std::function<void(int done, int total)>& progress = std::function<void(int, int)>());
+
+    // 默认文件位置: 程序目录下 atlas/model<n>.wta
+    static QString defaultFileName(CompositeModel::ModelType type);
+    // 按默认位置打开并共享的图版 (首次使用时加载); 文件不存在或无效时返回空指针
+    static std::shared_ptr<const TypeCurveAtlas> shared(CompositeModel::ModelType type);
+
+    // ---- 查询 ----
+
+    bool open(const QString& fileName, QString* error = nullptr);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    CompositeModel::ModelType modelType() const { return m_type; }
+    const QVector<Axis>& axes() const { return m_axes; }
+    qint64 nodeCount() const { return m_nodeCount; }
+
+    // 参数的固定无因次组与图版一致 (网格维度超出范围时按边界截断, 不影响判断)
+    bool covers(const CompositeParameters& p) const;
+
+    // 有因次理论曲线 (与 CompositeModel::calculateTheoreticalCurve 相同的换算);
+    // 超出图版 tD 范围的时间点为 NaN
+    ModelCurveData curve(const CompositeParameters& p, const QVector<double>& t) const;
+
+    /**
+     * @brief 网格节点上的最佳匹配, 用作拟合初值
+     * @param freeIds 被拟合的参数: 只有这些网格维度参与搜索 (其余取最接近当前值的节点);
+     *        kf 与 km 同时被拟合时再按 log10 kf 平移 ±2 (保持 M12), 对应双对数图上的时间 / 压力平移
+     * @param weight 压力残差的权重 (导数为 1 - weight), 与拟合一致
+     * @return 按 MSE 升序的至多 count 个节点
+     */
+    QVector<Match> bestMatches(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d, double weight,
+                               const CompositeParameters& current, const QVector<CompositeParameters::Id>& freeIds, int count) const;
+
+private:
+    // 网格坐标: 对数维度取 log10
+    static double coordinate(const Axis& a, double v);
+    // 网格内多线性插值, 结果为图版时间节点上的 log10 pD / log10 pD'
+    void interpolateLog(const CompositeParameters& p, QVector<double>& logPD, QVector<double>& logDeriv) const;
+    const float* nodeSeries(qint64 node) const { return m_data + node * 2 * m_timeCount; }
+
+    QFile m_file;
+    uchar* m_map = nullptr;
+    const float* m_data = nullptr;
+    CompositeModel::ModelType m_type = CompositeModel::Model_1;
+    QVector<Axis> m_axes;
+    QVector<qint64> m_strides;
+    qint64 m_nodeCount = 0;
+    int m_timeCount = 0;
+    double m_logTD0 = 0.0;
+    double m_logTDStep = 0.0;
+    double m_m12 = 0.0;
+    double m_lfD = 0.0;
+    int m_nf = 1;
+};
+
+#endif // TYPECURVEATLAS_H
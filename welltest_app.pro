@@ -0,0 +1,77 @@
+######################################################################
+# WellTest 界面程序 (计算部分链接 welltest_core 静态库)
+######################################################################
+QT += core gui axcontainer svg printsupport core5compat concurrent
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TEMPLATE = app
+TARGET = WellTest
+
+include(welltest_common.pri)
+include(welltest_core.pri)
+
+# Input
+HEADERS += dataeditorwidget.h \
+           datatablemodel.h \
+           columnstatisticscache.h \
+           chartsetting1.h \
+           fitscheduler.h \
+           fittingpage.h \
+           fittingwidget.h \
+           modelmanager.h \
+           modelparameter.h \
+           modelselect.h \
+           modelwidget01-06.h \
+           mousezoom.h \
+           plottingwidget.h \
+           mainwindow.h \
+           monitorbtn.h \
+           monitostatew.h \
+           navbtn.h \
+           newprojectdialog.h \
+           pressurederivativecalculator.h \
+           settingswidget.h \
+           qcustomplot.h \
+           wt_projectwidget.h
+
+FORMS += dataeditorwidget.ui \
+         fittingpage.ui \
+         fittingwidget.ui \
+         modelselect.ui \
+         modelwidget01-06.ui \
+         plottingwidget.ui \
+         mainwindow.ui \
+         monitorbtn.ui \
+         monitostatew.ui \
+         navbtn.ui \
+         newprojectdialog.ui \
+         settingswidget.ui \
+         wt_projectwidget.ui
+
+SOURCES += DataEditorWidget.cpp \
+           datatablemodel.cpp \
+           columnstatisticscache.cpp \
+           chartsetting1.cpp \
+           fitscheduler.cpp \
+           fittingpage.cpp \
+           fittingwidget.cpp \
+           modelmanager.cpp \
+           modelparameter.cpp \
+           modelselect.cpp \
+           modelwidget01-06.cpp \
+           mousezoom.cpp \
+           plottingwidget.cpp \
+           plotwindow.cpp \
+           main.cpp \
+           mainwindow.cpp \
+           monitorbtn.cpp \
+           monitostatew.cpp \
+           navbtn.cpp \
+           newprojectdialog.cpp \
+           pressurederivativecalculator.cpp \
+           settingswidget.cpp \
+           qcustomplot.cpp \
+           wt_projectwidget.cpp
+
+RESOURCES += resource.qrc
@@ -0,0 +1,314 @@
+/*
+ * welltest_cli.cpp
+ * 命令行批处理: 读取参数文件, 用计算核心库 (welltest_core) 计算理论曲线并输出 CSV。
+ * 不依赖界面模块, 可在无图形环境下批量计算。
+ *
+ * 参数文件格式:
+ *   1) 拟合页面保存的 JSON 状态 (modelType + parameters 数组 [{name, value}, ...]);
+ *   2) 扁平 JSON 对象 {"kf": 1e-3, ...}, 可带 "modelType";
+ *   3) 文本 "键 = 值" 每行一项, '#' 开头为注释。
+ * 输出每个输入一个 CSV: t, dp, dp' (与输入同名, 后缀 _curve.csv)。
+ *
+ * --build-atlas <dir>: 离线生成无因次图版 (TypeCurveAtlas), 放到程序目录 atlas/ 下即被界面使用。
+ */
+
+#include "compositemodel.h"
+#include "compositeparameters.h"
+#include "laplaceinversion.h"
+#include "typecurveatlas.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QRegularExpression>
+#include <QtConcurrent>
+#include <memory>
+
+namespace {
+
+struct BatchJob {
+    QString input;
+    QString output;
+    int modelIndex = -1;          // 0..5, -1 表示未指定
+    CompositeParameters params;
+    QString error;
+    int points = 0;
+    qint64 elapsedMs = 0;
+};
+
+// 读取参数文件, 失败时写入 job.error
+bool loadParameters(BatchJob& job)
+{
+    QFile file(job.input);
+    if (!file.open(QIODevice::ReadOnly)) {
+        job.error = QString("无法打开文件: %1").arg(job.input);
+        return false;
+    }
+    QByteArray data = file.readAll();
+
+    QMap<QString, double> map;
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(data, &err);
+    if (err.error == QJsonParseError::NoError && doc.isObject()) {
+        QJsonObject root = doc.object();
+        if (root.contains("modelType")) job.modelIndex = root["modelType"].toInt(-1);
+        if (root["parameters"].isArray()) {
+            for (const QJsonValue& v : root["parameters"].toArray()) {
+                QJsonObject o = v.toObject();
+                map.insert(o["name"].toString(), o["value"].toDouble());
+            }
+        } else {
+            for (auto it = root.constBegin(); it != root.constEnd(); ++it) {
+                if (it.key() != "modelType" && it.value().isDouble()) map.insert(it.key(), it.value().toDouble());
+            }
+        }
+    } else {
+        QTextStream in(&data);
+        int lineNo = 0;
+        while (!in.atEnd()) {
+            QString line = in.readLine().trimmed();
+            ++lineNo;
+            if (line.isEmpty() || line.startsWith('#')) continue;
+            int eq = line.indexOf('=');
+            bool ok = false;
+            double v = (eq > 0) ? line.mid(eq + 1).trimmed().toDouble(&ok) : 0.0;
+            if (!ok) {
+                job.error = QString("%1:%2 无法解析: %3").arg(job.input).arg(lineNo).arg(line);
+                return false;
+            }
+            QString key = line.left(eq).trimmed();
+            if (key == "modelType") job.modelIndex = (int)v;
+            else map.insert(key, v);
+        }
+    }
+
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+        if (!CompositeParameters::keys().contains(it.key())) {
+            job.error = QString("%1: 未知参数 %2").arg(job.input, it.key());
+            return false;
+        }
+    }
+    job.params = CompositeParameters::fromMap(map);
+    return true;
+}
+
+// 读取时间序列: 每行第一列 (逗号/空白分隔), 跳过无法解析的表头行
+QVector<double> loadTimeColumn(const QString& path, QString* error)
+{
+    QVector<double> t;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        *error = QString("无法打开时间文件: %1").arg(path);
+        return t;
+    }
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        QString first = in.readLine().section(QRegularExpression("[,;\\s]+"), 0, 0, QString::SectionSkipEmpty);
+        bool ok = false;
+        double v = first.toDouble(&ok);
+        if (ok && v > 0) t.append(v);
+    }
+    if (t.isEmpty()) *error = QString("时间文件中没有有效数据: %1").arg(path);
+    return t;
+}
+
+bool parseMethod(const QString& name, LaplaceInversionMethod& method)
+{
+    QString n = name.toLower();
+    if (n == "stehfest") method = LaplaceInversionMethod::Stehfest;
+    else if (n == "talbot") method = LaplaceInversionMethod::Talbot;
+    else if (n == "dehoog" || n == "de-hoog") method = LaplaceInversionMethod::DeHoog;
+    else if (n == "euler") method = LaplaceInversionMethod::Euler;
+    else return false;
+    return true;
+}
+
+bool writeCurve(const QString& path, const ModelCurveData& curve)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) return false;
+    QTextStream out(&file);
+    out << "t,dp,dp'\n";
+    const QVector<double>& t = std::get<0>(curve);
+    const QVector<double>& p = std::get<1>(curve);
+    const QVector<double>& d = std::get<2>(curve);
+    for (int i = 0; i < t.size(); ++i) {
+        out << QString::number(t[i], 'g', 10) << ',' << QString::number(p[i], 'g', 10) << ','
+            << QString::number(d[i], 'g', 10) << '\n';
+    }
+    return true;
+}
+
+// 生成图版: 每种模型一个文件 (model<n>.wta), 固定无因次组取自 base
+int buildAtlases(const QString& dir, const QVector<int>& models, const CompositeParameters& base, QTextStream& err)
+{
+    int failed = 0;
+    for (int m : models) {
+        CompositeModel::ModelType type = (CompositeModel::ModelType)m;
+        TypeCurveAtlas::Spec spec = TypeCurveAtlas::defaultSpec(type, base);
+        QString fileName = QDir(dir).filePath(QString("model%1.wta").arg(m + 1));
+        QElapsedTimer timer;
+        timer.start();
+        QMutex mutex;
+        int lastPercent = -1;
+        auto progress = [&](int done, int total) {
+            int percent = done * 100 / total;
+            QMutexLocker locker(&mutex);
+            if (percent / 10 == lastPercent / 10) return;
+            lastPercent = percent;
+            err << QString("  模型%1: %2% (%3 / %4)\n").arg(m + 1).arg(percent).arg(done).arg(total);
+            err.flush();
+        };
+        QString error;
+        if (TypeCurveAtlas::build(spec, fileName, &error, nullptr, progress)) {
+            err << "[完成] 图版 " << fileName << " (" << timer.elapsed() << " ms)\n";
+        } else {
+            err << "[失败] 图版 模型" << m + 1 << ": " << error << "\n";
+            ++failed;
+        }
+    }
+    return failed == 0 ? 0 : 2;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("welltest_cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("压裂水平井复合页岩油模型理论曲线批量计算");
+    parser.addHelpOption();
+    parser.addPositionalArgument("inputs", "参数文件 (JSON 或 键=值 文本), 可多个", "<file>...");
+    QCommandLineOption modelOpt({"m", "model"}, "模型编号 1-6 (覆盖参数文件中的 modelType)", "n");
+    QCommandLineOption timeOpt({"t", "time"}, "时间序列文件 (取每行第一列, 单位 h)", "file");
+    QCommandLineOption pointsOpt("points", "未给出时间文件时的对数等距点数", "n", "100");
+    QCommandLineOption tminOpt("tmin", "起始时间指数 (10^x h)", "x", "-3");
+    QCommandLineOption tmaxOpt("tmax", "终止时间指数 (10^x h)", "x", "3");
+    QCommandLineOption methodOpt("method", "反演算法: stehfest, talbot, dehoog, euler", "name", "stehfest");
+    QCommandLineOption orderOpt("order", "反演阶数 (0 为默认)", "n", "0");
+    QCommandLineOption lowOpt("low-precision", "低精度模式 (与拟合迭代相同)");
+    QCommandLineOption outOpt({"o", "output-dir"}, "输出目录 (默认与输入文件相同)", "dir");
+    QCommandLineOption timeoutOpt("timeout", "单个任务时限 (秒, 0 为不限); 超时的任务不输出", "s", "0");
+    QCommandLineOption atlasOpt("build-atlas", "生成无因次图版到目录 dir (--model 指定模型, 否则全部六种; "
+                                               "第一个参数文件给出 kf/km、Lf/L、裂缝条数, 否则取默认值)", "dir");
+    parser.addOptions({ modelOpt, timeOpt, pointsOpt, tminOpt, tmaxOpt, methodOpt, orderOpt, lowOpt, outOpt, timeoutOpt, atlasOpt });
+    parser.process(app);
+
+    QTextStream err(stderr);
+    const QStringList inputs = parser.positionalArguments();
+    if (parser.isSet(atlasOpt)) {
+        CompositeParameters base = TypeCurveAtlas::defaultBase();
+        if (!inputs.isEmpty()) {
+            BatchJob job;
+            job.input = inputs.first();
+            if (!loadParameters(job)) { err << job.error << "\n"; return 1; }
+            base = job.params;
+        }
+        QVector<int> models;
+        if (parser.isSet(modelOpt)) models << parser.value(modelOpt).toInt() - 1;
+        else for (int m = CompositeModel::Model_1; m <= CompositeModel::Model_6; ++m) models << m;
+        for (int m : models) {
+            if (m < CompositeModel::Model_1 || m > CompositeModel::Model_6) { err << "模型编号应为 1-6\n"; return 1; }
+        }
+        return buildAtlases(parser.value(atlasOpt), models, base, err);
+    }
+    if (inputs.isEmpty()) {
+        err << "未指定参数文件\n\n" << parser.helpText();
+        return 1;
+    }
+
+    ModelEvaluationOptions options;
+    options.highPrecision = !parser.isSet(lowOpt);
+    if (!parseMethod(parser.value(methodOpt), options.inversionMethod)) {
+        err << "未知的反演算法: " << parser.value(methodOpt) << "\n";
+        return 1;
+    }
+    int order = parser.value(orderOpt).toInt();
+    options.inversionOrder = order > 0 ? LaplaceInversion::normalizeOrder(options.inversionMethod, order)
+                                       : LaplaceInversion::defaultOrder(options.inversionMethod);
+
+    QVector<double> time;
+    if (parser.isSet(timeOpt)) {
+        QString msg;
+        time = loadTimeColumn(parser.value(timeOpt), &msg);
+        if (time.isEmpty()) { err << msg << "\n"; return 1; }
+    } else {
+        int n = std::max(2, parser.value(pointsOpt).toInt());
+        time = CompositeModel::logTimeSteps(n, parser.value(tminOpt).toDouble(), parser.value(tmaxOpt).toDouble());
+    }
+
+    int overrideModel = parser.isSet(modelOpt) ? parser.value(modelOpt).toInt() - 1 : -1;
+    QDir outDir(parser.value(outOpt));
+    if (parser.isSet(outOpt) && !outDir.exists() && !QDir().mkpath(outDir.path())) {
+        err << "无法创建输出目录: " << outDir.path() << "\n";
+        return 1;
+    }
+
+    QVector<BatchJob> jobs;
+    for (const QString& in : inputs) {
+        BatchJob job;
+        job.input = in;
+        QFileInfo fi(in);
+        QString name = fi.completeBaseName() + "_curve.csv";
+        job.output = parser.isSet(outOpt) ? outDir.filePath(name) : fi.dir().filePath(name);
+        if (loadParameters(job)) {
+            if (overrideModel >= 0) job.modelIndex = overrideModel;
+            if (job.modelIndex < CompositeModel::Model_1 || job.modelIndex > CompositeModel::Model_6)
+                job.error = QString("%1: 未指定模型编号 (使用 --model 1-6)").arg(in);
+        }
+        jobs.append(job);
+    }
+
+    // 每种模型一个计算对象, 各任务共享 (计算函数为 const, 可并发调用)
+    std::unique_ptr<CompositeModel> models[CompositeModel::Model_6 + 1];
+    for (const BatchJob& job : jobs) {
+        if (job.error.isEmpty() && !models[job.modelIndex])
+            models[job.modelIndex].reset(new CompositeModel((CompositeModel::ModelType)job.modelIndex));
+    }
+
+    // 多个输入时按文件并行, 单个输入时按时间点并行
+    ModelEvaluationOptions jobOptions = options;
+    jobOptions.parallel = (jobs.size() == 1);
+    const qint64 timeoutMs = qint64(parser.value(timeoutOpt).toDouble() * 1000);
+    QElapsedTimer total;
+    total.start();
+    QtConcurrent::blockingMap(jobs, [&](BatchJob& job) {
+        if (!job.error.isEmpty()) return;
+        QElapsedTimer timer;
+        timer.start();
+        // 每个任务各自计时, 超时后剩余时间点不再反演
+        CancellationToken deadline;
+        deadline.setDeadline(timeoutMs);
+        ModelEvaluationOptions taskOptions = jobOptions;
+        taskOptions.cancel = &deadline;
+        ModelCurveData curve = models[job.modelIndex]->calculateTheoreticalCurve(job.params, time, taskOptions);
+        job.points = std::get<0>(curve).size();
+        job.elapsedMs = timer.elapsed();
+        if (deadline.isCancelled()) job.error = QString("%1: 超时 (%2 ms)").arg(job.input).arg(job.elapsedMs);
+        else if (!writeCurve(job.output, curve)) job.error = QString("无法写入: %1").arg(job.output);
+    });
+
+    int failed = 0;
+    for (const BatchJob& job : jobs) {
+        if (!job.error.isEmpty()) {
+            err << "[失败] " << job.error << "\n";
+            ++failed;
+        } else {
+            err << "[完成] " << job.input << " -> " << job.output << " (模型" << job.modelIndex + 1 << ", "
+                << job.points << " 点, " << job.elapsedMs << " ms)\n";
+        }
+    }
+    err << QString("共 %1 个任务, 失败 %2 个, 反演算法 %3, 用时 %4 ms\n")
+               .arg(jobs.size()).arg(failed).arg(LaplaceInversion::methodName(options.inversionMethod)).arg(total.elapsed());
+    return failed == 0 ? 0 : 2;
+}
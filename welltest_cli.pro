@@ -0,0 +1,14 @@
+######################################################################
+# welltest_cli: 理论曲线命令行批处理 (只依赖 QtCore, 链接 welltest_core)
+######################################################################
+QT = core concurrent
+
+TEMPLATE = app
+TARGET = welltest_cli
+CONFIG += console
+CONFIG -= app_bundle
+
+include(welltest_common.pri)
+include(welltest_core.pri)
+
+SOURCES += welltest_cli.cpp
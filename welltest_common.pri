@@ -0,0 +1,20 @@
+# 各子工程共用的编译设置
+INCLUDEPATH += $$PWD
+
+# C++17标准支持（试井模型需要）
+CONFIG += c++17
+
+# 编译优化选项
+QMAKE_CXXFLAGS += -O3
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE += -O3
+
+# 数学库链接
+unix: LIBS += -lm
+win32: LIBS += -lm
+
+INCLUDEPATH += D:/08YYYXXX/eigen-3.3.8
+INCLUDEPATH += D:/08YYYXXX/boost_1_89_0
+
+# 警告设置
+QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-parameter
@@ -0,0 +1,11 @@
+# 链接 welltest_core 静态库 (库与使用方在同一构建目录下生成)
+QT *= core concurrent
+
+win32:CONFIG(release, debug|release): WELLTEST_CORE_DIR = $$OUT_PWD/release
+else:win32:CONFIG(debug, debug|release): WELLTEST_CORE_DIR = $$OUT_PWD/debug
+else: WELLTEST_CORE_DIR = $$OUT_PWD
+
+LIBS += -L$$WELLTEST_CORE_DIR -lwelltest_core
+
+win32-g++|unix: PRE_TARGETDEPS += $$WELLTEST_CORE_DIR/libwelltest_core.a
+else:win32: PRE_TARGETDEPS += $$WELLTEST_CORE_DIR/welltest_core.lib
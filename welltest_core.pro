@@ -0,0 +1,49 @@
+######################################################################
+# welltest_core: 试井模型计算核心静态库 (不依赖 QtGui / QtWidgets)
+# 由界面程序 WellTest 与命令行批处理 welltest_cli 共同链接
+######################################################################
+QT = core concurrent
+
+TEMPLATE = lib
+TARGET = welltest_core
+CONFIG += staticlib
+
+include(welltest_common.pri)
+
+HEADERS += besselkernel.h \
+           bourdetderivative.h \
+           cancellationtoken.h \
+           columnstatistics.h \
+           compositekernel.h \
+           compositemodel.h \
+           compositeparameters.h \
+           csvparser.h \
+           datacolumn.h \
+           datadecimation.h \
+           datasetcache.h \
+           dualnumber.h \
+           fituncertainty.h \
+           gausskronrod.h \
+           globalsearch.h \
+           laplacecache.h \
+           laplaceinversion.h \
+           mappedtextfile.h \
+           parametersweep.h \
+           stehfest.h \
+           typecurveatlas.h
+
+SOURCES += besselkernel.cpp \
+           bourdetderivative.cpp \
+           columnstatistics.cpp \
+           compositemodel.cpp \
+           compositeparameters.cpp \
+           csvparser.cpp \
+           datacolumn.cpp \
+           datadecimation.cpp \
+           datasetcache.cpp \
+           fituncertainty.cpp \
+           globalsearch.cpp \
+           laplaceinversion.cpp \
+           mappedtextfile.cpp \
+           parametersweep.cpp \
+           typecurveatlas.cpp
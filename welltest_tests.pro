@@ -0,0 +1,44 @@
+######################################################################
+# welltest_tests: 计算核心与数据管线的单元测试 (Qt Test, 链接 welltest_core)
+#   运行: make check 或直接执行 welltest_tests [测试类名]
+######################################################################
+QT = core gui concurrent testlib
+
+TEMPLATE = app
+TARGET = welltest_tests
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+include(welltest_common.pri)
+include(welltest_core.pri)
+
+HEADERS += tst_besselkernel.h \
+           tst_columnstatistics.h \
+           tst_datacolumn.h \
+           tst_csvparser.h \
+           tst_datasetcache.h \
+           tst_datatablemodel.h \
+           tst_mappedtextfile.h \
+           tst_compositekernel.h \
+           tst_gausskronrod.h \
+           tst_laplaceinversion.h \
+           tst_compositemodel.h \
+           tst_columnstatisticscache.h
+
+SOURCES += tst_main.cpp \
+           tst_besselkernel.cpp \
+           tst_columnstatistics.cpp \
+           tst_datacolumn.cpp \
+           tst_csvparser.cpp \
+           tst_datasetcache.cpp \
+           tst_datatablemodel.cpp \
+           tst_mappedtextfile.cpp \
+           tst_compositekernel.cpp \
+           tst_gausskronrod.cpp \
+           tst_laplaceinversion.cpp \
+           tst_compositemodel.cpp \
+           tst_columnstatisticscache.cpp
+
+# 数据表模型属于界面程序 (不在 welltest_core 中), 直接编入测试
+HEADERS += datatablemodel.h columnstatisticscache.h
+SOURCES += datatablemodel.cpp columnstatisticscache.cpp